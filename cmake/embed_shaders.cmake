@@ -0,0 +1,29 @@
+# 셰이더 소스를 바이트 배열로 바꿔 실행 파일에 포함할 헤더를 만든다.
+# 사용: cmake -DINPUTS=<파일,파일,...> -DOUTPUT=<헤더> -P embed_shaders.cmake
+# (문자열 리터럴 대신 배열을 쓰므로 MSVC 리터럴 길이 제한과 구분자 충돌이 없다)
+
+string(REPLACE "," ";" INPUT_LIST "${INPUTS}")
+
+set(content "// cmake/embed_shaders.cmake가 생성한 파일 - 직접 수정하지 말 것\n\n")
+set(table "")
+set(index 0)
+foreach(input ${INPUT_LIST})
+    get_filename_component(name "${input}" NAME)
+    file(READ "${input}" hex HEX)
+    # 한 줄에 16바이트씩
+    string(REGEX REPLACE "(................................)" "\\1\n    " hex "${hex}")
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+    string(APPEND content "static const unsigned char embeddedShader${index}[] = {\n    ${bytes}0x00\n};\n\n")
+    string(APPEND table "    { \"${name}\", embeddedShader${index}, sizeof(embeddedShader${index}) - 1 },\n")
+    math(EXPR index "${index} + 1")
+endforeach()
+string(APPEND content "static const EmbeddedShaderEntry embeddedShaderEntries[] = {\n${table}};\n")
+
+# 내용이 같으면 쓰지 않아 불필요한 재컴파일을 피함
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" previous)
+    if(previous STREQUAL content)
+        return()
+    endif()
+endif()
+file(WRITE "${OUTPUT}" "${content}")
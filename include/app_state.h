@@ -14,6 +14,9 @@ namespace AppConstants {
     constexpr float NEAR_PLANE = 0.1f;
     constexpr float FAR_PLANE = 100.0f;
     constexpr float MODEL_SCALE = 0.1f;
+    constexpr float LOD_MAX_PIXEL_ERROR = 1.0f;  // LOD 전환 시 허용하는 화면 오차 (픽셀)
+    constexpr int INSTANCE_GRID_SIZE = 10;       // 인스턴싱 모드에서 그리는 복사본 격자 (N x N)
+    constexpr float INSTANCE_SPACING = 4.0f;
     constexpr float CLEAR_COLOR_R = 0.1f;
     constexpr float CLEAR_COLOR_G = 0.1f;
     constexpr float CLEAR_COLOR_B = 0.1f;
@@ -22,9 +25,7 @@ namespace AppConstants {
     // 텍스처 유닛 번호
     constexpr int TEXTURE_UNIT_ALBEDO = 0;
     constexpr int TEXTURE_UNIT_NORMAL = 1;
-    constexpr int TEXTURE_UNIT_METALLIC = 2;
-    constexpr int TEXTURE_UNIT_ROUGHNESS = 3;
-    constexpr int TEXTURE_UNIT_AO = 4;
+    constexpr int TEXTURE_UNIT_ORM = 2;  // AO/roughness/metallic 묶음
     constexpr int TEXTURE_UNIT_IRRADIANCE = 5;
     constexpr int TEXTURE_UNIT_PREFILTER = 6;
     constexpr int TEXTURE_UNIT_BRDF_LUT = 7;
@@ -45,6 +46,8 @@ public:
     bool useTangentSpace = true;
     bool useIBL = true;
     bool albedoIsSRGB = true;
+    bool useCulling = true;  // 절두체/메시렛 뒷면 컬링
+    bool useInstancing = false;  // 모델 복사본 격자를 인스턴싱으로 그림
     bool cursorLocked = true;
     
     // 카메라
@@ -64,6 +67,8 @@ public:
         bool vPressed = false;  // V: Tangent Space
         bool bPressed = false;  // B: IBL
         bool nPressed = false;  // N: Albedo sRGB
+        bool cPressed = false;  // C: Culling
+        bool iPressed = false;  // I: Instancing
         bool zeroPressed = false;  // 0: Cursor lock
     } keyState;
     
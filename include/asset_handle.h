@@ -0,0 +1,148 @@
+#ifndef ASSET_HANDLE_H
+#define ASSET_HANDLE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// AssetManager가 발급하는 타입별 핸들 (슬롯 인덱스 + 세대 번호)
+// 해제된 슬롯이 재사용되면 세대가 바뀌므로 오래된 핸들은 자동으로 무효가 된다.
+template <class Tag>
+struct AssetHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0; // 0은 무효 핸들
+    
+    bool isValid() const { return generation != 0; }
+    bool operator==(const AssetHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const AssetHandle& other) const { return !(*this == other); }
+};
+
+struct TextureAssetTag {};
+struct MeshAssetTag {};
+
+using TextureHandle = AssetHandle<TextureAssetTag>;
+using MeshHandle = AssetHandle<MeshAssetTag>;
+
+// 키(정규화 경로) -> 슬롯 O(1) 조회와 참조 카운트를 관리하는 슬롯 배열
+template <class T, class Tag>
+class AssetPool
+{
+public:
+    using Handle = AssetHandle<Tag>;
+    
+    // 살아 있는 에셋을 찾으면 참조를 하나 늘려 반환, 없으면 무효 핸들
+    Handle acquire(const std::string& key)
+    {
+        auto it = slotByKey.find(key);
+        if (it == slotByKey.end())
+            return Handle();
+        Slot& slot = slots[it->second];
+        slot.refCount++;
+        return makeHandle(it->second);
+    }
+    
+    // 새 에셋 등록 (참조 카운트 1)
+    Handle insert(const std::string& key, T value)
+    {
+        uint32_t index;
+        if (!freeSlots.empty())
+        {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+        
+        Slot& slot = slots[index];
+        slot.value = std::move(value);
+        slot.key = key;
+        slot.refCount = 1;
+        slot.live = true;
+        slotByKey[key] = index;
+        return makeHandle(index);
+    }
+    
+    T* get(Handle handle)
+    {
+        if (!handle.isValid() || handle.index >= slots.size())
+            return nullptr;
+        Slot& slot = slots[handle.index];
+        return (slot.live && slot.generation == handle.generation) ? &slot.value : nullptr;
+    }
+    
+    const T* get(Handle handle) const
+    {
+        return const_cast<AssetPool*>(this)->get(handle);
+    }
+    
+    void addRef(Handle handle)
+    {
+        if (get(handle))
+            slots[handle.index].refCount++;
+    }
+    
+    uint32_t refCount(Handle handle) const
+    {
+        return get(handle) ? slots[handle.index].refCount : 0;
+    }
+    
+    // 참조를 하나 줄인다. 0이 되면 슬롯을 비우고 값을 out으로 넘겨 호출자가 GL 자원을 정리하게 함
+    bool release(Handle handle, T& out)
+    {
+        if (!get(handle))
+            return false;
+        Slot& slot = slots[handle.index];
+        if (--slot.refCount > 0)
+            return false;
+        
+        out = std::move(slot.value);
+        slot.value = T();
+        slotByKey.erase(slot.key);
+        slot.key.clear();
+        slot.live = false;
+        // 세대를 올려 기존 핸들을 무효화 (0은 건너뜀)
+        if (++slot.generation == 0)
+            slot.generation = 1;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+    
+    size_t liveCount() const { return slotByKey.size(); }
+    
+    template <class F>
+    void forEach(F&& visit)
+    {
+        for (uint32_t i = 0; i < slots.size(); i++)
+        {
+            if (slots[i].live)
+                visit(makeHandle(i), slots[i].value);
+        }
+    }
+    
+private:
+    struct Slot {
+        T value{};
+        std::string key;
+        uint32_t refCount = 0;
+        uint32_t generation = 1;
+        bool live = false;
+    };
+    
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::unordered_map<std::string, uint32_t> slotByKey;
+    
+    Handle makeHandle(uint32_t index) const
+    {
+        Handle handle;
+        handle.index = index;
+        handle.generation = slots[index].generation;
+        return handle;
+    }
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef ASSET_MANAGER_H
+#define ASSET_MANAGER_H
+
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+#include "asset_handle.h"
+#include "gl_handle.h"
+#include "geometry_arena.h"
+#include "mesh.h"
+#include "texture_loader.h"
+
+// 프로세스 공용 에셋 관리자.
+// 텍스처와 모델별 메시 묶음을 정규화 경로로 공유하고, 마지막 참조가 풀리는 즉시 GL 자원을 삭제한다.
+// GL 자원을 다루므로 렌더 스레드에서만 호출한다.
+class AssetManager
+{
+public:
+    static AssetManager& instance();
+    
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+    
+    // 경로 정규화 (같은 파일을 가리키는 다른 표기를 하나의 키로)
+    static std::string canonicalKey(const std::string& file, const std::string& directory);
+    
+    // 이미 로드된(또는 디코딩 중인) 텍스처면 참조만 늘리고, 아니면 디코딩을 예약
+    // (같은 파일이라도 용도가 다르면 압축 포맷이 달라지므로 별도 텍스처)
+    TextureHandle requestTexture(const std::string& file, const std::string& directory,
+                                 TextureUsage usage = TextureUsage::Color);
+    // 세 맵에서 channels의 채널을 읽어 R/G/B 한 장으로 묶은 텍스처 (빈 문자열인 채널은 비워 둠)
+    TextureHandle requestPackedTexture(const std::array<std::string, 3>& files, const std::array<int, 3>& channels,
+                                       const std::string& directory);
+    // 예약된 디코딩 결과로 GL 텍스처를 만듦 (픽셀은 update()에서 프레임마다 나눠 올라감)
+    void resolvePendingTextures();
+    // 렌더 루프에서 프레임마다 한 번 호출: 텍스처 업로드를 프레임 예산만큼 진행
+    void update();
+    // GL 컨텍스트가 파괴되기 전에 호출 (업로드용 버퍼와 공용 정점/인덱스 버퍼 해제)
+    void releaseGL();
+    // 디코딩 대기 중이거나 로드 실패 시 0
+    unsigned int textureId(TextureHandle handle) const;
+    // requestPackedTexture()로 묶은 텍스처에 실제로 들어간 채널 (1: R, 2: G, 4: B, 대기 중이거나 실패 시 0)
+    unsigned int packedChannels(TextureHandle handle) const;
+    void retain(TextureHandle handle);
+    void release(TextureHandle handle);
+    
+    // 같은 모델 파일의 메시 묶음 공유 (메시가 참조하는 텍스처 핸들도 함께 소유)
+    MeshHandle acquireMeshes(const std::string& key);
+    MeshHandle registerMeshes(const std::string& key, std::vector<Mesh> meshes);
+    std::vector<Mesh>& meshes(MeshHandle handle);
+    void retain(MeshHandle handle);
+    void release(MeshHandle handle);
+    // 모든 메시가 구간을 나눠 쓰는 공용 정점/인덱스 버퍼
+    GeometryArena& geometry() { return geometryArena; }
+    
+    size_t textureCount() const { return textures.liveCount(); }
+    size_t meshGroupCount() const { return meshGroups.liveCount(); }
+    
+private:
+    struct TextureAsset {
+        GLTexture texture;
+        unsigned int packedChannels = 0;
+        bool pending = false;
+    };
+    
+    AssetPool<TextureAsset, TextureAssetTag> textures;
+    AssetPool<std::vector<Mesh>, MeshAssetTag> meshGroups;
+    TextureLoader textureLoader;
+    GeometryArena geometryArena;
+    // (핸들, 로더 티켓). 디코딩 중에는 관리자가 참조를 하나 잡고 있어,
+    // 그 사이 모든 사용자가 해제해도 업로드 직후 바로 삭제된다.
+    std::vector<std::pair<TextureHandle, size_t>> pendingTextures;
+    
+    AssetManager() = default;
+};
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef BC_ENCODER_H
+#define BC_ENCODER_H
+
+#include <vector>
+
+// CPU 블록 압축 인코더 (임포트 시 한 번 실행하고 결과는 텍스처 캐시에 저장)
+//   BC1: RGB,  BC3: RGB + 알파,  BC4: R 채널,  BC5: R/G 채널
+// BC7은 인코딩하지 않고 미리 압축된 KTX2/DDS 로드만 지원한다.
+namespace BCEncoder {
+    // channels: 입력 픽셀당 바이트 (1~4). 1채널 입력은 BC1/BC3에서 회색조로 취급
+    // internalFormat에 맞는 블록 배열 반환 (지원하지 않는 포맷이면 빈 벡터)
+    std::vector<unsigned char> compress(const unsigned char* pixels, int width, int height, int channels,
+                                        unsigned int internalFormat);
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef CULLING_H
+#define CULLING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "frustum.h"
+
+// 축 정렬 바운딩 박스 (중심 ± 반 크기)
+struct Aabb {
+    glm::vec3 center = glm::vec3(0.0f);
+    glm::vec3 extent = glm::vec3(0.0f);
+    
+    static Aabb fromMinMax(const glm::vec3& minimum, const glm::vec3& maximum);
+    glm::vec3 minimum() const { return center - extent; }
+    glm::vec3 maximum() const { return center + extent; }
+    // 두 박스를 모두 감싸는 박스
+    Aabb merged(const Aabb& other) const;
+    // 아핀 변환한 박스를 감싸는 박스 (Arvo: 반 크기에 |M|을 곱함)
+    Aabb transformed(const glm::mat4& matrix) const;
+};
+
+namespace Culling {
+    enum Result {
+        OUTSIDE,
+        INTERSECTS,
+        INSIDE
+    };
+    
+    // 평면 6개로 박스 하나를 분류 (BVH 노드용)
+    Result classify(const Frustum& frustum, const Aabb& box);
+}
+
+// 많은 박스를 한 번에 절두체 검사하기 위한 SoA 배열.
+// 평면마다 SIMD 폭(SSE 4개, AVX로 빌드하면 8개)의 박스를 함께 계산하고, 나머지는 스칼라로 처리한다.
+class BoundsSoA
+{
+public:
+    void clear();
+    void reserve(size_t count);
+    void push(const Aabb& box);
+    size_t size() const { return centerX.size(); }
+    
+    // [first, first + count) 박스마다 visible[i]에 1(걸치거나 안쪽) 또는 0(완전히 밖)을 씀
+    void cull(const Frustum& frustum, size_t first, size_t count, uint8_t* visible) const;
+    void cull(const Frustum& frustum, uint8_t* visible) const { cull(frustum, 0, size(), visible); }
+    
+private:
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+};
+
+// 박스 목록 위의 BVH (큰 장면의 인스턴스용).
+// 절두체 밖 노드는 하위 트리를 통째로 버리고, 완전히 안쪽인 노드는 검사 없이 통째로 받으며,
+// 걸친 리프만 BoundsSoA로 항목을 SIMD 검사한다. 노드는 깊이 우선 순서라 왼쪽 자식은 바로 다음 노드.
+class BoundsBvh
+{
+public:
+    static constexpr uint32_t LEAF_SIZE = 8;
+    
+    // 긴 축의 중심 중앙값으로 나눔 (O(n log n), 박스가 바뀌면 다시 호출)
+    void build(const std::vector<Aabb>& boxes);
+    // 보이는 항목 번호(build에 넘긴 순서)를 visible 뒤에 추가
+    void cull(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+    
+    size_t itemCount() const { return items.size(); }
+    size_t nodeCount() const { return nodes.size(); }
+    
+private:
+    struct Node {
+        Aabb bounds;
+        uint32_t first;        // items 안의 구간 (내부 노드도 하위 트리 전체 구간을 가짐)
+        uint32_t count;
+        uint32_t secondChild;  // 0이면 리프 (루트가 0번이므로 자식일 수 없음)
+    };
+    
+    std::vector<Node> nodes;
+    // 리프 순서로 정렬한 원래 번호와 그 순서의 박스
+    std::vector<uint32_t> items;
+    BoundsSoA itemBounds;
+    // 리프 검사 결과 (cull마다 재사용)
+    mutable std::vector<uint8_t> leafVisible;
+    
+    uint32_t buildNode(const std::vector<Aabb>& boxes, uint32_t first, uint32_t count);
+};
+
+#endif
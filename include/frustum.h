@@ -0,0 +1,17 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+// 절두체 6개 평면 (ax + by + cz + d >= 0 이 안쪽, 정규화하지 않음)
+struct Frustum {
+    glm::vec4 planes[6];
+    
+    // projection * view (* model)에서 평면 추출 (Gribb-Hartmann). 행렬의 입력 공간 기준 평면이 나옴
+    static Frustum fromMatrix(const glm::mat4& matrix);
+    
+    // 구가 절두체 밖에 완전히 있으면 false (경계에 걸치면 true)
+    bool intersectsSphere(const glm::vec3& center, float radius) const;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef GEOMETRY_ARENA_H
+#define GEOMETRY_ARENA_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <map>
+#include "gl_handle.h"
+
+struct PackedMesh;
+
+// 공용 버퍼 초기 크기 (모자라면 두 배씩 늘려 기존 내용을 GPU에서 복사)
+struct GeometryArenaSettings {
+    size_t initialVertexBytes = 32u << 20;
+    size_t initialIndexBytes = 16u << 20;
+};
+
+// 메시 하나가 공용 버퍼에서 받은 구간
+struct GeometryAllocation {
+    unsigned int layout = 0;  // GeometryArena::Layout
+    size_t firstVertex = 0;   // glDrawElementsBaseVertex의 basevertex
+    size_t vertexCount = 0;
+    size_t indexOffset = 0;   // EBO 안의 바이트 오프셋 (4바이트 정렬)
+    size_t indexBytes = 0;
+    
+    bool isValid() const { return vertexCount != 0; }
+};
+
+// 첫 적합(first-fit) free-list 구간 할당기. 단위는 호출자가 정한다 (정점 수, 4바이트 워드 등).
+// 해제된 구간은 이웃한 빈 구간과 합쳐 단편화를 줄인다.
+class RangeAllocator
+{
+public:
+    static constexpr size_t INVALID_OFFSET = ~static_cast<size_t>(0);
+    
+    explicit RangeAllocator(size_t capacity = 0);
+    
+    // 자리가 없으면 INVALID_OFFSET
+    size_t allocate(size_t size);
+    void free(size_t offset, size_t size);
+    // 끝에 빈 공간을 덧붙임 (기존 구간의 오프셋은 그대로)
+    void grow(size_t newCapacity);
+    
+    size_t capacity() const { return totalSize; }
+    size_t usedSize() const { return used; }
+    
+private:
+    std::map<size_t, size_t> freeRanges; // 오프셋 -> 크기
+    size_t totalSize = 0;
+    size_t used = 0;
+};
+
+// 모든 모델의 메시가 함께 쓰는 정점/인덱스 버퍼.
+// 정점 포맷(양자화/float 위치)마다 VAO 하나와 큰 VBO/EBO 한 쌍을 두고 메시별 구간을 나눠 준다.
+// 메시는 glDrawElementsBaseVertex로 그리므로 같은 포맷끼리는 VAO를 바꾸지 않는다.
+// GL 자원을 다루므로 렌더 스레드에서만 호출한다.
+class GeometryArena
+{
+public:
+    enum Layout : unsigned int {
+        LAYOUT_QUANTIZED = 0,
+        LAYOUT_FLOAT = 1,
+        LAYOUT_COUNT
+    };
+    
+    GeometryArena() = default;
+    
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+    
+    static GeometryArenaSettings& settings();
+    
+    // 압축된 메시를 구간에 복사 (빈 메시면 무효 할당)
+    GeometryAllocation upload(const PackedMesh& packed);
+    void free(const GeometryAllocation& allocation);
+    
+    // 이미 바인딩된 VAO면 GLState가 건너뜀
+    void bind(unsigned int layout);
+    // bind 후 인스턴스 속성이 buffer의 byteOffset부터 읽도록 설정 (VAO마다 마지막 구간을 기억해 같으면 생략)
+    void bindInstances(unsigned int layout, GLuint buffer, size_t byteOffset);
+    // 다른 코드가 GL_ELEMENT_ARRAY_BUFFER를 바인딩하기 전에 호출 (VAO의 인덱스 버퍼를 덮어쓰지 않도록)
+    void unbind();
+    // GL 컨텍스트가 파괴되기 전에 호출
+    void releaseGL();
+    
+    size_t vertexBytesUsed() const;
+    size_t indexBytesUsed() const;
+    
+private:
+    struct Pool {
+        GLVertexArray VAO;
+        GLBuffer VBO;
+        GLBuffer EBO;
+        size_t stride = 0;
+        RangeAllocator vertices; // 정점 단위
+        RangeAllocator indices;  // 4바이트 워드 단위
+        // VAO의 인스턴스 속성이 가리키는 구간 (instanceBuffer가 0이면 아직 설정 안 함)
+        GLuint instanceBuffer = 0;
+        size_t instanceOffset = 0;
+    };
+    
+    Pool pools[LAYOUT_COUNT];
+    
+    void createPool(unsigned int layout);
+    void growVertices(Pool& pool, unsigned int layout, size_t minimumCount);
+    void growIndices(Pool& pool, size_t minimumWords);
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef GL_CAPABILITIES_H
+#define GL_CAPABILITIES_H
+
+#include <string>
+#include <glad/glad.h>
+
+// GLAD는 3.3 Core만 생성되어 있으므로 확장 상수는 여기서 정의
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+// 컨텍스트 생성 직후 한 번 조사하는 드라이버 기능 목록.
+// detect() 이후에는 읽기 전용이므로 워커 스레드에서 읽어도 안전하다.
+struct GLCapabilities {
+    bool textureCompressionS3TC = false; // BC1/BC2/BC3
+    bool textureCompressionRGTC = true;  // BC4/BC5 (GL 3.0 Core)
+    bool textureCompressionBPTC = false; // BC7
+    
+    // 프로그램 바이너리 (GL 4.1 / ARB_get_program_binary)
+    // GLAD에는 3.3 함수만 있으므로 detect()에 넘긴 로더로 직접 가져온다.
+    bool programBinary = false;
+    void (APIENTRYP getProgramBinary)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary) = nullptr;
+    void (APIENTRYP programBinaryUpload)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length) = nullptr;
+    void (APIENTRYP programParameteri)(GLuint program, GLenum pname, GLint value) = nullptr;
+    
+    std::string vendor;
+    std::string renderer;
+    std::string version;
+    
+    static const GLCapabilities& get();
+    // 렌더 스레드에서 GLAD 초기화 직후 호출 (loader가 없으면 확장 함수는 로드하지 않음)
+    static void detect(GLADloadproc loader = nullptr);
+    
+    bool supportsCompressedFormat(unsigned int internalFormat) const;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef GL_HANDLE_H
+#define GL_HANDLE_H
+
+#include <glad/glad.h>
+#include "gl_state.h"
+
+// GL 객체 이름 하나를 소유하는 이동 전용 핸들 (소멸 시 삭제).
+// 전역/싱글턴이 가진 핸들은 컨텍스트가 파괴되기 전에 releaseGL()에서 reset()해야 한다.
+template <class Traits>
+class GLHandle
+{
+public:
+    GLHandle() = default;
+    explicit GLHandle(GLuint name) : name(name) {}
+    ~GLHandle() { reset(); }
+    
+    GLHandle(const GLHandle&) = delete;
+    GLHandle& operator=(const GLHandle&) = delete;
+    
+    GLHandle(GLHandle&& other) noexcept : name(other.name)
+    {
+        other.name = 0;
+    }
+    
+    GLHandle& operator=(GLHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            name = other.name;
+            other.name = 0;
+        }
+        return *this;
+    }
+    
+    // 새 GL 객체 생성 (렌더 스레드에서 호출)
+    static GLHandle create()
+    {
+        return GLHandle(Traits::create());
+    }
+    
+    GLuint get() const { return name; }
+    explicit operator bool() const { return name != 0; }
+    
+    // 기존 객체를 삭제하고 name을 소유
+    void reset(GLuint newName = 0)
+    {
+        if (name != 0)
+            Traits::destroy(name);
+        name = newName;
+    }
+    
+    // 소유권만 포기하고 이름 반환 (삭제하지 않음)
+    GLuint release()
+    {
+        GLuint released = name;
+        name = 0;
+        return released;
+    }
+    
+private:
+    GLuint name = 0;
+};
+
+struct GLBufferTraits {
+    static GLuint create() { GLuint name = 0; glGenBuffers(1, &name); return name; }
+    static void destroy(GLuint name) { glDeleteBuffers(1, &name); }
+};
+
+struct GLVertexArrayTraits {
+    static GLuint create() { GLuint name = 0; glGenVertexArrays(1, &name); return name; }
+    static void destroy(GLuint name) { GLState::instance().forgetVertexArray(name); glDeleteVertexArrays(1, &name); }
+};
+
+struct GLTextureTraits {
+    static GLuint create() { GLuint name = 0; glGenTextures(1, &name); return name; }
+    static void destroy(GLuint name) { GLState::instance().forgetTexture(name); glDeleteTextures(1, &name); }
+};
+
+struct GLProgramTraits {
+    static GLuint create() { return glCreateProgram(); }
+    static void destroy(GLuint name) { GLState::instance().forgetProgram(name); glDeleteProgram(name); }
+};
+
+using GLBuffer = GLHandle<GLBufferTraits>;
+using GLVertexArray = GLHandle<GLVertexArrayTraits>;
+using GLTexture = GLHandle<GLTextureTraits>;
+using GLProgram = GLHandle<GLProgramTraits>;
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+#include <cstdint>
+#include <glad/glad.h>
+
+// 종류별 GL 호출 수 (issued: 실제로 호출, skipped: 이미 같은 상태라 생략)
+struct GLStateCounter {
+    uint64_t issued = 0;
+    uint64_t skipped = 0;
+};
+
+struct GLStateStats {
+    GLStateCounter programs;      // glUseProgram
+    GLStateCounter vertexArrays;  // glBindVertexArray
+    GLStateCounter textures;      // glActiveTexture + glBindTexture
+    GLStateCounter uniforms;      // glUniform* (값 비교는 Shader가 함)
+    
+    uint64_t issued() const { return programs.issued + vertexArrays.issued + textures.issued + uniforms.issued; }
+    uint64_t skipped() const { return programs.skipped + vertexArrays.skipped + textures.skipped + uniforms.skipped; }
+};
+
+// 렌더 스레드의 GL 바인딩 상태를 기억해 두고 바뀌는 것이 없는 호출을 버리는 얇은 계층.
+// 현재 프로그램, VAO, 텍스처 유닛별 텍스처와 활성 유닛을 추적한다 (uniform 값은 Shader가 프로그램별로 기억).
+// 추적하는 바인딩은 모두 여기를 거쳐 바꿔야 하며, 다른 코드가 직접 바꿨다면 invalidate()를 호출한다.
+// 삭제된 GL 이름은 재사용될 수 있으므로 GLHandle이 삭제할 때 forget*()으로 캐시에서 지운다.
+class GLState
+{
+public:
+    static constexpr GLuint MAX_TEXTURE_UNITS = 16;
+    
+    static GLState& instance();
+    
+    void useProgram(GLuint program);
+    // 지금 바인딩된 프로그램 (모르면 어떤 이름과도 같지 않은 값)
+    GLuint boundProgram() const { return program; }
+    void bindVertexArray(GLuint vertexArray);
+    // unit의 GL_TEXTURE_2D 바인딩 (활성 유닛도 필요할 때만 바꿈)
+    void bindTexture(GLuint unit, GLuint texture);
+    
+    // uniform 호출 집계 (Shader가 값이 같아 올리지 않은 경우 skipped)
+    void countUniform(bool skipped);
+    
+    void forgetProgram(GLuint program);
+    void forgetVertexArray(GLuint vertexArray);
+    void forgetTexture(GLuint texture);
+    // 추적 상태를 모두 모름으로 돌림 (다음 호출은 반드시 GL로 감)
+    void invalidate();
+    
+    const GLStateStats& stats() const { return counters; }
+    void resetStats() { counters = GLStateStats(); }
+    
+private:
+    // 아직 모르는 상태 (어떤 이름과도 같지 않음)
+    static constexpr GLuint UNKNOWN = ~0u;
+    
+    GLuint program = UNKNOWN;
+    GLuint vertexArray = UNKNOWN;
+    GLuint activeUnit = UNKNOWN;
+    GLuint textures[MAX_TEXTURE_UNITS];
+    GLStateStats counters;
+    
+    GLState();
+    void activeTexture(GLuint unit);
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef GLTF_LOADER_H
+#define GLTF_LOADER_H
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include "mesh.h"
+#include "thread_pool.h"
+
+// 내장 glTF 로더 설정 (모델 로드 전에 렌더 스레드에서 변경)
+struct GltfLoaderSettings {
+    // 끄면 .gltf/.glb도 Assimp로 임포트
+    bool enabled = true;
+};
+
+// metallic-roughness 머티리얼 (텍스처 경로는 모델 파일 기준 상대 경로)
+// GLB/데이터 URI에 들어 있는 이미지는 파일로 풀지 않고 "<파일명>.image<N>.<내용 해시>.<확장자>" 이름의
+// 메모리 이미지로 TextureLoader에 등록한다.
+struct GltfMaterial {
+    std::string baseColorMap;
+    std::string metallicRoughnessMap; // G: roughness, B: metallic
+    std::string normalMap;
+    std::string occlusionMap;         // R: AO
+    glm::vec4 baseColorFactor = glm::vec4(1.0f);
+    float metallicFactor = 1.0f;
+    float roughnessFactor = 1.0f;
+};
+
+// 노드 하나에 놓인 프리미티브 하나 (노드 변환을 적용한 모델 공간 정점)
+struct GltfMesh {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    unsigned int materialIndex = 0; // GltfScene::materials 인덱스
+    bool hasTexCoords = false;
+    // TANGENT 속성이 있으면 true (Bitangent = cross(N, T) * w)
+    bool hasTangents = false;
+};
+
+struct GltfScene {
+    std::vector<GltfMesh> meshes;
+    // 머티리얼이 없는 프리미티브는 마지막의 기본 머티리얼을 가리킴
+    std::vector<GltfMaterial> materials;
+};
+
+// .glb는 파일 전체를, .gltf는 외부 .bin 버퍼를 mmap하고 접근자(accessor)를 매핑된 메모리에서 바로 읽는다.
+// 버퍼 뷰를 중간 배열로 복사하지 않고 정점마다 stride/컴포넌트 타입에 맞춰 변환해 Vertex에 기록한다.
+// 장면 노드 계층을 따라 변환을 적용하고 (Assimp PreTransformVertices와 같음) 프리미티브는 워커 스레드에서 동시에 변환한다.
+// glTF의 UV 원점(왼쪽 위)은 Assimp FlipUVs 결과와 같으므로 V는 뒤집지 않는다.
+namespace GltfLoader {
+    GltfLoaderSettings& settings();
+    
+    bool load(const std::string& path, GltfScene& scene, ThreadPool& pool = ThreadPool::shared());
+    // 내장 이미지만 메모리 이미지로 등록 (메시 캐시 적중으로 load를 건너뛸 때 텍스처가 찾을 수 있도록)
+    bool registerEmbeddedImages(const std::string& path);
+}
+
+#endif
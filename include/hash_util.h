@@ -0,0 +1,32 @@
+#ifndef HASH_UTIL_H
+#define HASH_UTIL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// 64비트 단위로 섞는 빠른 비암호화 해시 (캐시 무효화 용도로 충분)
+inline uint64_t hashBytes(const unsigned char* data, size_t size, uint64_t seed)
+{
+    const uint64_t prime = 0x100000001B3ull;
+    uint64_t h = seed ^ (size * 0x9E3779B97F4A7C15ull);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        h ^= word * 0xFF51AFD7ED558CCDull;
+        h = ((h << 31) | (h >> 33)) * prime;
+    }
+    for (; i < size; i++)
+    {
+        h ^= data[i];
+        h *= prime;
+    }
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+#endif
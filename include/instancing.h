@@ -0,0 +1,95 @@
+#ifndef INSTANCING_H
+#define INSTANCING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "culling.h"
+#include "gl_handle.h"
+
+// Model::enqueueInstanced에 넘기는 복사본 하나의 배치와 머티리얼 덮어쓰기
+struct ModelInstance {
+    glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 tint = glm::vec3(1.0f); // 알베도에 곱함
+    float roughness = -1.0f;          // 0 이상이면 머티리얼 거칠기 대신 사용
+};
+
+// 인스턴스 VBO 한 항목 (shader.vert의 USE_INSTANCING 속성 location 4~11과 같은 순서)
+struct InstanceData {
+    glm::mat4 model;
+    // 노말 행렬 열 (w는 사용하지 않음), 정점마다 역행렬을 구하지 않도록 CPU에서 계산
+    glm::vec4 normalMatrix[3];
+    // rgb: 색조, a: 거칠기 덮어쓰기 (음수면 없음)
+    glm::vec4 material;
+};
+
+static_assert(sizeof(InstanceData) == 128, "InstanceData is read as vertex attributes with a 128 byte stride");
+
+// 인스턴스 배치가 없는 드로 항목
+constexpr uint32_t NO_INSTANCE_BATCH = ~0u;
+
+// 인스턴스 드로 한 번이 읽는 VBO 구간 (count가 0이면 인스턴싱하지 않는 드로)
+struct InstanceRange {
+    GLuint buffer = 0;
+    size_t byteOffset = 0;
+    GLsizei count = 0;
+};
+
+namespace Instancing {
+    // 인스턴스 속성이 시작하는 셰이더 location (정점 속성 0~3 다음)
+    constexpr GLuint FIRST_LOCATION = 4;
+    constexpr GLuint LOCATION_COUNT = 8;
+    
+    InstanceData pack(const ModelInstance& instance);
+}
+
+// 같은 모델의 복사본 목록과 그 월드 AABB 위의 BVH.
+// 배치나 모델 바운드가 바뀔 때만 build()로 다시 만들고, 프레임마다 cull()로 보이는 번호만 뽑는다.
+class InstanceGroup
+{
+public:
+    InstanceGroup() = default;
+    InstanceGroup(std::vector<ModelInstance> instances, const Aabb& modelBounds);
+    
+    // modelBounds는 모델 공간 AABB (Model::bounds()), 인스턴스 행렬로 변환해 BVH를 만듦
+    void build(std::vector<ModelInstance> instances, const Aabb& modelBounds);
+    // 월드 공간 절두체와 겹치는 인스턴스 번호를 visible 뒤에 추가
+    void cull(const Frustum& frustum, std::vector<uint32_t>& visible) const { bvh.cull(frustum, visible); }
+    
+    const std::vector<ModelInstance>& instances() const { return items; }
+    const Aabb& worldBounds(size_t index) const { return bounds[index]; }
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    
+private:
+    std::vector<ModelInstance> items;
+    std::vector<Aabb> bounds;
+    BoundsBvh bvh;
+};
+
+// 프레임의 인스턴스 데이터를 담는 VBO (GL 컨텍스트가 있을 때 생성, 렌더 스레드 전용).
+// UniformBlockBuffers의 드로 블록처럼 앞에서부터 채우는 링이고, 끝에 닿으면 버퍼를 고아로 만들어(orphan) 다시 시작한다.
+// 한 번에 용량보다 많이 올리면 버퍼를 키운다.
+class InstanceBuffer
+{
+public:
+    explicit InstanceBuffer(size_t initialCapacity = 1024);
+    
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+    
+    // count개를 연속 구간에 쓰고 첫 항목의 바이트 오프셋을 돌려줌
+    size_t upload(const InstanceData* data, size_t count);
+    GLuint buffer() const { return vbo.get(); }
+    
+private:
+    GLBuffer vbo;
+    size_t capacity = 0;  // 인스턴스 수
+    size_t cursor = 0;
+    
+    void allocate(size_t newCapacity);
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 에셋 메타데이터(glTF 등)를 읽기 위한 최소 JSON 트리 (읽기 전용)
+// 없는 키/인덱스나 타입이 다른 값은 null 값과 fallback을 돌려주므로 검사 없이 연쇄 접근할 수 있다.
+class JsonValue
+{
+public:
+    enum Type {
+        TYPE_NULL,
+        TYPE_BOOL,
+        TYPE_NUMBER,
+        TYPE_STRING,
+        TYPE_ARRAY,
+        TYPE_OBJECT
+    };
+    
+    // 실패하면 false (error에 오류 위치 기록)
+    static bool parse(const char* text, size_t length, JsonValue& out, std::string* error = nullptr);
+    
+    Type type() const { return valueType; }
+    bool isNull() const { return valueType == TYPE_NULL; }
+    bool isNumber() const { return valueType == TYPE_NUMBER; }
+    bool isString() const { return valueType == TYPE_STRING; }
+    bool isArray() const { return valueType == TYPE_ARRAY; }
+    bool isObject() const { return valueType == TYPE_OBJECT; }
+    
+    bool asBool(bool fallback = false) const;
+    double asNumber(double fallback = 0.0) const;
+    float asFloat(float fallback = 0.0f) const;
+    int asInt(int fallback = 0) const;
+    // 문자열이 아니면 빈 문자열
+    const std::string& asString() const;
+    
+    // 배열/객체 원소 수 (그 외는 0)
+    size_t size() const;
+    const JsonValue& at(size_t index) const;
+    const JsonValue& get(const char* key) const;
+    bool contains(const char* key) const;
+    const std::vector<std::pair<std::string, JsonValue>>& members() const { return objectMembers; }
+    
+private:
+    Type valueType = TYPE_NULL;
+    bool boolValue = false;
+    double numberValue = 0.0;
+    std::string stringValue;
+    std::vector<JsonValue> arrayValues;
+    std::vector<std::pair<std::string, JsonValue>> objectMembers;
+    
+    friend class JsonParser;
+};
+
+#endif
@@ -5,9 +5,15 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
+#include "asset_handle.h"
+#include "geometry_arena.h"
+#include "instancing.h"
+#include "shader.h"
 
-class Shader;
+struct PackedMesh;
+class RenderQueue;
 
+// 임포트/캐시용 정점 (GPU에는 VertexFormat::pack으로 압축해서 올림)
 struct Vertex {
     glm::vec3 Position;
     glm::vec3 Normal;
@@ -16,26 +22,148 @@ struct Vertex {
     glm::vec3 Bitangent;
 };
 
+// 메시 인덱스 배열 안의 LOD 구간 (메시 캐시에 그대로 저장되므로 레이아웃 고정)
+struct MeshLod {
+    unsigned int indexOffset; // 인덱스 단위
+    unsigned int indexCount;
+    float error;              // 모델 공간 기하 오차 (LOD0은 0)
+};
+
+// LOD0 인덱스 배열의 연속 구간 하나 (MeshletBuilder가 생성) (메시 캐시에 그대로 저장되므로 레이아웃 고정)
+struct Meshlet {
+    unsigned int indexOffset;
+    unsigned int triangleCount;
+    // 모델 공간 바운딩 구
+    glm::vec3 center;
+    float radius;
+    // 법선 원뿔: 카메라가 원뿔 뒤쪽에 있으면 모든 삼각형이 뒷면
+    glm::vec3 coneAxis;
+    float coneCutoff; // sin(원뿔 반각), 1보다 크면 뒷면 컬링 불가
+};
+
+// 그리기 시점의 카메라 정보: LOD 선택과 컬링에 사용 (기본값이면 항상 LOD0, 컬링 없음)
+struct DrawView {
+    glm::mat4 model = glm::mat4(1.0f);
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    // 거리 1에서 모델 공간 1단위가 차지하는 픽셀 수: viewportHeight / (2 * tan(fovy / 2)), 0이면 LOD 선택 안 함
+    float projectionScale = 0.0f;
+    float maxPixelError = 1.0f;
+    // 절두체 밖 메시와 뒷면/화면 밖 메시렛을 CPU에서 제외
+    bool culling = false;
+    // 메시와 무관한 셰이더 기능 비트 (FEATURE_IBL, FEATURE_ALBEDO_SRGB)
+    unsigned int shaderFeatures = 0;
+};
+
+// texture_orm 한 장에 묶인 맵 (R: AO, G: roughness, B: metallic)
+enum OrmChannel : unsigned int {
+    ORM_OCCLUSION = 1,
+    ORM_ROUGHNESS = 2,
+    ORM_METALLIC = 4
+};
+
+// glTF metallic-roughness 계수 (enabled면 맵 값에 곱하고, 맵이 없으면 셰이더의 기본 Material 값 대신 사용)
+struct MaterialFactors {
+    glm::vec3 baseColor = glm::vec3(1.0f);
+    float metallic = 1.0f;
+    float roughness = 1.0f;
+    bool enabled = false;
+};
+
+// Mesh::submit이 메시마다 올리는 uniform 핸들 (셰이더를 만든 뒤 한 번 조회)
+struct MeshUniforms {
+    UniformHandle<glm::vec3> positionScale;
+    UniformHandle<glm::vec3> positionOffset;
+    UniformHandle<glm::vec3> baseColorFactor;
+    UniformHandle<float> metallicFactor;
+    UniformHandle<float> roughnessFactor;
+    
+    MeshUniforms() = default;
+    explicit MeshUniforms(Shader& shader);
+};
+
 struct Texture {
     unsigned int id;
     std::string type;
-    std::string path;
+    std::string path;     // texture_orm이면 "AO|roughness|metallic" 소스 경로
+    TextureHandle handle; // AssetManager 참조 (메시 묶음이 해제될 때 반환)
+    unsigned int ormChannels = 0; // texture_orm에 실제로 들어 있는 맵 (OrmChannel 비트)
 };
 
 class Mesh {
 public:
     std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+    std::vector<unsigned int> indices; // 모든 LOD의 인덱스를 이어 붙인 배열
+    std::vector<MeshLod> lods;         // lods[0]이 원본, 뒤로 갈수록 단순
+    std::vector<Meshlet> meshlets;     // LOD0 구간을 나눈 메시렛 (작은 메시는 비어 있음)
     std::vector<Texture> textures;
-    unsigned int VAO;
+    unsigned int materialIndex = 0;
+    MaterialFactors factors;
     bool hasTangentSpace;
+    // 모델 공간 바운딩 구 (LOD 선택용)와 같은 중심의 AABB 반 크기 (컬링용)
+    glm::vec3 boundsCenter = glm::vec3(0.0f);
+    float boundsRadius = 0.0f;
+    glm::vec3 boundsExtent = glm::vec3(0.0f);
+    
+    // lods가 비어 있으면 인덱스 전체를 LOD 하나로 사용 (벡터 인자는 이동해서 넘기면 복사하지 않음)
+    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, bool hasTangentSpace,
+         std::vector<MeshLod> lods = {}, std::vector<Meshlet> meshlets = {});
+    // 워커 스레드에서 미리 압축한 데이터를 올리기만 함 (vertices/indices는 비어 있음)
+    // 메시 캐시 적중 시에는 매핑된 메모리에서 바로 압축하므로 CPU 측 사본을 만들지 않음
+    Mesh(const PackedMesh& packed, std::vector<Texture> textures, bool hasTangentSpace,
+         std::vector<MeshLod> lods = {}, std::vector<Meshlet> meshlets = {});
+    
+    // 공용 버퍼 구간을 가리키므로 복사하지 않고 이동만 허용
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+    Mesh(Mesh&&) noexcept = default;
+    Mesh& operator=(Mesh&&) noexcept = default;
     
-    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, bool hasTangentSpace);
-    void Draw(Shader &shader, bool enableTangentSpace);
+    // LOD 선택과 메시렛 컬링 후 남은 인덱스 구간을 queue에 넣음 (transform은 queue.addTransform()의 번호)
+    // 메시 단위 절두체 컬링은 호출하는 쪽(Model::enqueue)에서 bounds()로 묶어서 함
+    // instanceBatch가 있으면 transform 대신 queue.addInstances()의 배치로 인스턴스 드로 (view.model은 LOD/깊이 기준)
+    void enqueue(RenderQueue& queue, uint32_t transform, bool enableTangentSpace, const DrawView& view = DrawView(),
+                 uint32_t instanceBatch = NO_INSTANCE_BATCH);
+    // RenderQueue가 정렬된 순서로 호출: 변형/텍스처/uniform을 설정하고 구간들을 그림 (instances.count가 있으면 인스턴스 드로)
+    void submit(Shader& shader, const MeshUniforms& uniforms, unsigned int features,
+                const GLsizei* counts, const void* const* offsets, size_t rangeCount,
+                const InstanceRange& instances = InstanceRange());
+    // 텍스처/계수가 정해진 뒤 (로드 시) 한 번 호출해 셰이더 기능 비트를 고름
+    void updateShaderFeatures();
+    // 그릴 때 쓰는 셰이더 변형 (머티리얼 기능 + 전역 기능, 탄젠트 공간은 메시가 지원할 때만)
+    unsigned int shaderFeatures(bool enableTangentSpace, unsigned int globalFeatures) const;
+    Aabb bounds() const
+    {
+        Aabb box;
+        box.center = boundsCenter;
+        box.extent = boundsExtent;
+        return box;
+    }
+    // 투영된 오차가 maxPixelError 이하인 가장 단순한 레벨
+    size_t selectLod(const DrawView& view) const;
+    // 업로드가 끝난 뒤 CPU 측 vertices/indices 해제 (LOD/메시렛 표는 그리기에 필요하므로 유지)
+    void releaseCpuData();
+    // 공용 버퍼 구간 반환 (AssetManager가 마지막 참조 해제 시 호출)
+    void releaseGL();
     
 private:
-    unsigned int VBO, EBO;
-    void setupMesh();
+    // updateShaderFeatures()가 고른 머티리얼 기능 비트 (ShaderFeature)
+    unsigned int materialFeatures = 0;
+    // 텍스처 ID와 계수의 해시 (정렬 키에서 같은 머티리얼을 모음)
+    uint32_t materialKey = 0;
+    // AssetManager::geometry()에서 받은 정점/인덱스 구간
+    GeometryAllocation geometry;
+    // 압축 정점 위치 복원용 (float 위치면 scale 1, offset 0)
+    glm::vec3 positionScale = glm::vec3(1.0f);
+    glm::vec3 positionOffset = glm::vec3(0.0f);
+    GLenum indexType = GL_UNSIGNED_INT;
+    // 컬링 후 큐에 넘길 구간 (프레임마다 재사용)
+    std::vector<GLsizei> drawCounts;
+    std::vector<const void*> drawOffsets;
+    std::vector<GLint> drawBaseVertices;
+    static int textureUnitFor(const std::string& type);
+    void setupMesh(const Vertex* vertexData, size_t vertexCount, const unsigned int* indexData, size_t indexCount);
+    void uploadPacked(const PackedMesh& packed);
 };
 
 #endif
@@ -0,0 +1,50 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+#include "mesh.h"
+
+// 임포트 결과(후처리된 정점/인덱스, 머티리얼 슬롯, 텍스처 경로)를 원본 에셋 옆에 저장하는 바이너리 캐시.
+// 캐시 적중 시 Assimp를 거치지 않고 매핑된 메모리에서 바로 GPU 버퍼를 채운다.
+class MeshCache
+{
+public:
+    // 파일 레이아웃이나 임포트 후처리가 바뀌면 올려서 기존 캐시를 무효화
+    static constexpr uint32_t VERSION = 6;
+    
+    struct TextureEntry {
+        std::string type;
+        std::string path;
+    };
+    
+    // 캐시 파일 내부를 가리키는 메시 레코드 (MeshCache 수명 동안만 유효)
+    struct MeshEntry {
+        const Vertex* vertices;
+        uint32_t vertexCount;
+        const unsigned int* indices;
+        uint32_t indexCount;
+        uint32_t materialIndex;
+        bool hasTangentSpace;
+        MaterialFactors factors;
+        std::vector<TextureEntry> textures;
+        std::vector<MeshLod> lods;
+        std::vector<Meshlet> meshlets;
+    };
+    
+    static std::string pathFor(const std::string& sourcePath);
+    // 원본 파일 내용 + 임포트 플래그 + 후처리 설정 + 캐시 버전 해시 (원본을 읽을 수 없으면 0)
+    static uint64_t computeKey(const std::string& sourcePath, unsigned int importFlags, uint64_t settingsSeed);
+    static bool save(const std::string& cachePath, uint64_t key, const std::vector<Mesh>& meshes);
+    
+    bool load(const std::string& cachePath, uint64_t key);
+    const std::vector<MeshEntry>& entries() const { return meshEntries; }
+    
+private:
+    MappedFile file;
+    std::vector<MeshEntry> meshEntries;
+};
+
+#endif
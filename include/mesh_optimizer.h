@@ -0,0 +1,56 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+
+// 임포트 후처리 설정 (모델 로드 전에 렌더 스레드에서 변경)
+struct MeshOptimizerSettings {
+    bool enabled = true;
+    // 오버드로 정렬 시 클러스터를 나누는 기준: 클러스터 ACMR이 (전체 ACMR * 이 값) 이하가 되면 분할
+    // 1.0에 가까울수록 캐시 효율 유지, 클수록 클러스터가 잘게 나뉘어 오버드로 감소
+    float overdrawThreshold = 1.05f;
+    // ACMR/ATVR 측정에 쓰는 FIFO 캐시 크기 (post-transform 캐시 근사)
+    unsigned int analysisCacheSize = 16;
+};
+
+// ACMR = 변환된 정점 수 / 삼각형 수, ATVR = 변환된 정점 수 / 정점 수
+struct MeshOptimizationReport {
+    size_t triangles = 0;
+    size_t verticesBefore = 0;
+    size_t verticesAfter = 0;
+    size_t transformedBefore = 0;
+    size_t transformedAfter = 0;
+    
+    void add(const MeshOptimizationReport& other);
+    float acmrBefore() const;
+    float acmrAfter() const;
+    float atvrBefore() const;
+    float atvrAfter() const;
+};
+
+// 정점 용접 -> 정점 캐시 순서(Forsyth) -> 오버드로 클러스터 정렬 -> 정점 fetch 순서.
+// 모든 단계는 삼각형 집합을 바꾸지 않고 순서와 인덱스만 바꾼다.
+namespace MeshOptimizer {
+    MeshOptimizerSettings& settings();
+    // 캐시 키에 섞을 설정 해시
+    uint64_t settingsSeed(const MeshOptimizerSettings& settings);
+    
+    MeshOptimizationReport optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                    const MeshOptimizerSettings& settings);
+    
+    // 비트 단위로 같은 정점을 하나로 합치고 인덱스를 다시 매김 (남은 정점 수 반환)
+    size_t weldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+    void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+    void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+                          float threshold, unsigned int cacheSize);
+    // 처음 참조되는 순서대로 정점 배열을 재배치 (참조되지 않는 정점은 제거)
+    void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+    
+    // FIFO 캐시를 시뮬레이션해 캐시 미스(정점 셰이더 실행) 횟수 반환
+    size_t countTransformedVertices(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize);
+}
+
+#endif
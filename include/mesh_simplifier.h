@@ -0,0 +1,39 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+
+// LOD 체인 생성 설정 (모델 로드 전에 렌더 스레드에서 변경)
+struct LodSettings {
+    bool enabled = true;
+    // LOD0 외에 만들 최대 레벨 수
+    unsigned int maxLevels = 4;
+    // 레벨마다 목표 삼각형 수 비율
+    float reduction = 0.5f;
+    // 이보다 삼각형이 적은 레벨은 만들지 않음
+    size_t minTriangles = 64;
+    // 메시 바운딩 구 반지름 대비 허용 오차 (넘으면 체인 종료)
+    float maxRelativeError = 0.05f;
+};
+
+// 이차 오차 척도(QEM) 기반 하프 에지 축약.
+// 정점은 새로 만들지 않고 기존 정점으로만 합치므로 모든 LOD가 같은 VBO를 공유한다.
+// UV/노말 이음새와 열린 경계 위의 정점은 고정해서 이음새가 벌어지지 않게 한다.
+namespace MeshSimplifier {
+    LodSettings& settings();
+    // 캐시 키에 섞을 설정 해시
+    uint64_t settingsSeed(const LodSettings& settings);
+    
+    // indices(LOD0) 뒤에 하위 LOD 인덱스를 이어 붙이고 레벨 표 반환 (lods[0]은 원본)
+    std::vector<MeshLod> buildLodChain(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                       const LodSettings& settings);
+    
+    // 삼각형 수가 targetIndexCount / 3 이하가 되거나 오차가 maxError를 넘기 직전까지 단순화
+    std::vector<unsigned int> simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                                       size_t targetIndexCount, float maxError, float* resultError = nullptr);
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef MESHLET_H
+#define MESHLET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+
+// 메시렛 분할 설정 (모델 로드 전에 렌더 스레드에서 변경)
+struct MeshletSettings {
+    bool enabled = true;
+    unsigned int maxVertices = 64;
+    unsigned int maxTriangles = 124;
+    // 삼각형이 이보다 적은 메시는 분할하지 않음 (컬링 비용이 이득보다 큼)
+    size_t minMeshTriangles = 1024;
+};
+
+namespace MeshletBuilder {
+    MeshletSettings& settings();
+    // 캐시 키에 섞을 설정 해시
+    uint64_t settingsSeed(const MeshletSettings& settings);
+    
+    // 인접 삼각형을 묶어 메시렛을 만들고, indices를 메시렛 순서로 재배치
+    std::vector<Meshlet> build(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                               const MeshletSettings& settings);
+    
+    // cameraPosition은 메시렛과 같은 (모델) 공간
+    bool isBackFacing(const Meshlet& meshlet, const glm::vec3& cameraPosition);
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef MIP_GENERATOR_H
+#define MIP_GENERATOR_H
+
+#include "texture_image.h"
+
+class ThreadPool;
+
+// 다운샘플 커널
+enum class MipFilter {
+    Box,     // 2x2 평균 (glGenerateMipmap과 비슷한 결과)
+    Triangle,// 텐트 필터: 부드럽고 에일리어싱이 적음
+    Kaiser   // Kaiser 윈도 sinc: 선명함 유지 (기본값)
+};
+
+struct MipSettings {
+    MipFilter filter = MipFilter::Kaiser;
+    // 텍스처가 GL_REPEAT로 샘플링되므로 기본은 반대편 가장자리를 이어서 필터링
+    bool wrap = true;
+};
+
+// CPU 밉 체인 생성기 (드라이버 glGenerateMipmap 대체).
+//   Color : sRGB -> 선형 공간에서 필터링 후 다시 sRGB로 (알파는 선형)
+//   Normal: [-1,1] 벡터로 필터링 후 재정규화 (2채널이면 Z를 복원해서 처리)
+//   Scalar: 값 그대로 필터링
+// 각 레벨은 행 단위로 나눠 스레드 풀에서 병렬 처리한다.
+namespace MipGenerator {
+    // 0번 레벨은 base.levels[0]을 그대로 공유하고 1x1까지 비압축 레벨을 추가한 이미지 반환
+    DecodedImage generate(const DecodedImage& base, TextureUsage usage, const MipSettings& settings, ThreadPool& pool);
+}
+
+#endif
@@ -7,34 +7,120 @@
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
+#include "asset_handle.h"
 #include "mesh.h"
+#include "mesh_optimizer.h"
+#include "vertex_format.h"
 
 class Shader;
+class MeshCache;
 
 class Model
 {
 public:
-    Model(std::string const &path, bool gamma = false);
-    void Draw(Shader& shader, bool enableTangentSpace);
+    // keepCpuData가 false면 업로드(와 메시 캐시 저장) 뒤 메시의 vertices/indices를 해제
+    // (캐시 적중 시에는 원래 CPU 사본을 만들지 않음)
+    Model(std::string const &path, bool gamma = false, bool keepCpuData = false);
+    ~Model();
+    
+    Model(const Model&) = delete;
+    Model& operator=(const Model&) = delete;
+    Model(Model&& other) noexcept;
+    Model& operator=(Model&& other) noexcept;
+    
+    // 여러 파일을 워커 스레드에서 동시에 임포트하고, GL 업로드는 호출한 렌더 스레드에서 순서대로 처리
+    static std::vector<Model> loadModels(const std::vector<std::string>& paths, bool gamma = false,
+                                         bool keepCpuData = false);
+    
+    // 메시마다 화면 공간 오차로 LOD 선택, view.culling이면 메시 AABB(SIMD)/메시렛 컬링 (기본값이면 원본 전체)
+    // 남은 메시를 queue에 넣기만 하고, 그리기는 queue.sort()/submit()에서 키 순서로 함
+    void enqueue(RenderQueue& queue, bool enableTangentSpace, const DrawView& view = DrawView());
+    // 같은 모델의 복사본들을 하위 메시마다 glDrawElementsInstanced 한 번으로 그림 (view.model은 무시)
+    // view.culling이면 인스턴스 BVH로 거르고, LOD와 정렬 깊이는 가장 가까운 인스턴스 기준
+    void enqueueInstanced(RenderQueue& queue, const InstanceGroup& instances, bool enableTangentSpace,
+                          const DrawView& view = DrawView());
+    // 모든 하위 메시를 감싸는 모델 공간 AABB (InstanceGroup::build에 넘김)
+    Aabb bounds() const;
+    // 메시들이 쓰는 셰이더 변형 목록 (Shader::warmUp에 넘겨 첫 프레임 컴파일을 피함)
+    std::vector<unsigned int> shaderFeatures(bool enableTangentSpace, unsigned int globalFeatures) const;
     
 private:
+    // 워커 스레드에서 만든 메시 하나 (GL/AssetManager 호출 없이 채움)
+    struct ImportedMesh {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        std::vector<MeshLod> lods;
+        std::vector<Meshlet> meshlets;
+        // (타입, 경로): 렌더 스레드에서 requestTexture로 요청
+        std::vector<std::pair<std::string, std::string>> textures;
+        bool hasTexCoords = false;
+        bool hasTangentSpace = false;
+        unsigned int materialIndex = 0;
+        MaterialFactors factors;
+        MeshOptimizationReport report;
+    };
+    
+    // 파일 하나의 CPU 단계 결과 (캐시 적중이면 cache, 아니면 meshes가 채워짐)
+    struct ImportResult {
+        std::string path;
+        std::string assetKey;
+        std::string cachePath;
+        uint64_t cacheKey = 0;
+        // 같은 묶음에 이미 임포트 중인 파일이면 true (마무리 단계에서 공유)
+        bool duplicate = false;
+        bool failed = false;
+        std::unique_ptr<MeshCache> cache;
+        std::vector<ImportedMesh> meshes;
+        // 메시(또는 캐시 항목)별 GPU 업로드용 압축 데이터
+        std::vector<PackedMesh> packed;
+    };
+    
+    // AssetManager가 소유한 메시 묶음 (같은 파일을 로드한 모델끼리 공유)
+    MeshHandle meshHandle;
+    // 로드 중에만 사용하고, 로드가 끝나면 AssetManager로 넘김
     std::vector<Mesh> meshes;
-    std::vector<Texture> textures_loaded;
     std::string directory;
     bool gammaCorrection;
+    bool keepCpuData;
+    // 임포트 중 메시 최적화 결과 합계 (로그 출력용)
+    MeshOptimizationReport optimizationReport;
+    // 하위 메시 AABB (SoA)와 컬링 결과 (프레임마다 재사용)
+    BoundsSoA meshBounds;
+    std::vector<uint8_t> meshVisible;
+    // 컬링을 통과한 인스턴스 번호와 그 복사본 (프레임마다 재사용)
+    std::vector<uint32_t> visibleIndices;
+    std::vector<ModelInstance> visibleInstances;
+    
+    Model(bool gamma, bool keepCpuData);
     
     void loadModel(std::string const &path);
-    void processNode(aiNode *node, const aiScene *scene);
-    Mesh processMesh(aiMesh *mesh, const aiScene *scene);
-    std::vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName);
-    unsigned int TextureFromFile(const char *path, const std::string &directory, bool gamma = false);
+    // 렌더 스레드: 디렉터리/에셋 키를 정하고, 이미 로드된 파일이면 공유 핸들을 잡고 true
+    bool beginLoad(ImportResult& import);
+    // 워커 스레드에서 실행 가능 (파일 I/O, Assimp, 최적화/LOD/메시렛)
+    static void importFile(ImportResult& import);
+    static void collectMeshes(aiNode *node, const aiScene *scene, std::vector<aiMesh*>& result);
+    // 내장 OBJ 로더 경로 (Assimp를 거치지 않음)
+    static void importObj(ImportResult& import);
+    // 내장 glTF/GLB 로더 경로 (접근자를 매핑된 버퍼에서 바로 읽음)
+    static void importGltf(ImportResult& import);
+    static void processMesh(aiMesh *mesh, const aiScene *scene, ImportedMesh& result);
+    // 탄젠트 생성 -> 최적화 -> 메시렛 -> LOD 체인 (임포터와 무관한 공통 후처리)
+    static void processGeometry(ImportedMesh& mesh);
+    static void collectMaterialTextures(aiMaterial *mat, aiTextureType type, const std::string& typeName,
+                                        std::vector<std::pair<std::string, std::string>>& textures);
+    static std::string firstTexturePath(aiMaterial *mat, aiTextureType type);
+    // 렌더 스레드: 텍스처 요청, GL 업로드, 캐시 저장, AssetManager 등록
+    void finishLoad(ImportResult& import);
     
     // 텍스처 로딩 헬퍼 함수
-    unsigned char* tryLoadTextureFromPaths(const std::vector<std::string>& paths, int& width, int& height, int& nrComponents);
-    std::vector<std::string> getDefaultTexturePaths(const std::string& baseName, const std::string& textureName);
-    unsigned int createGLTexture(unsigned char* data, int width, int height, int nrComponents);
+    Texture requestTexture(const std::string& path, const std::string& typeName);
+    std::vector<Texture> requestDefaultTextures();
+    void resolveTextures();
 };
 
 #endif
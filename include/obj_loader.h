@@ -0,0 +1,54 @@
+#ifndef OBJ_LOADER_H
+#define OBJ_LOADER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "mesh.h"
+#include "thread_pool.h"
+
+// 내장 OBJ 로더 설정 (모델 로드 전에 렌더 스레드에서 변경)
+struct ObjLoaderSettings {
+    // 끄면 .obj도 Assimp로 임포트
+    bool enabled = true;
+    // 워커 하나가 맡는 파일 구간 크기 (줄 경계로 맞춤)
+    size_t chunkBytes = 4u << 20;
+};
+
+// MTL 머티리얼에서 셰이더가 쓰는 텍스처 경로만 (OBJ 파일 기준 상대 경로)
+struct ObjMaterial {
+    std::string name;
+    std::string diffuseMap;   // map_Kd
+    std::string specularMap;  // map_Ks
+    std::string normalMap;    // map_Bump / bump / norm
+    std::string roughnessMap; // map_Pr
+    std::string metallicMap;  // map_Pm
+};
+
+// 머티리얼 하나에 속한 삼각형들 (v/vt/vn 조합이 같은 꼭짓점은 하나의 정점으로 합침)
+struct ObjMesh {
+    std::vector<Vertex> vertices; // Tangent/Bitangent는 0
+    std::vector<unsigned int> indices;
+    unsigned int materialIndex = 0; // ObjScene::materials 인덱스
+};
+
+struct ObjScene {
+    std::vector<ObjMesh> meshes;
+    std::vector<ObjMaterial> materials;
+    bool hasTexCoords = false;
+};
+
+// 파일을 mmap해서 줄 경계 구간으로 나누고 워커 스레드에서 동시에 파싱한다.
+//   1단계: 구간마다 v/vt/vn 줄 수와 마지막 usemtl을 세어 전역 시작 번호를 정함
+//   2단계: 구간마다 float/인덱스를 std::from_chars로 읽어 전역 배열의 자기 자리에 바로 기록
+//   3단계: 구간마다 머티리얼별로 꼭짓점 중복을 제거하고, 머티리얼마다 구간 결과를 합쳐 구간 경계를 넘는 중복만 다시 거른 뒤
+//          Vertex/인덱스 배열 생성 (노말이 없으면 부드러운 노말 생성)
+// Assimp의 Triangulate/FlipUVs와 같은 결과가 되도록 다각형은 팬 분할하고 V를 뒤집는다.
+namespace ObjLoader {
+    ObjLoaderSettings& settings();
+    
+    bool load(const std::string& path, ObjScene& scene, ThreadPool& pool = ThreadPool::shared());
+    bool loadMaterials(const std::string& path, std::vector<ObjMaterial>& materials);
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "instancing.h"
+
+class Mesh;
+class Shader;
+struct MeshUniforms;
+class UniformBlockBuffers;
+class InstanceBuffer;
+
+enum RenderPass : unsigned int {
+    PASS_OPAQUE = 0,      // 앞에서 뒤로 (early-Z)
+    PASS_TRANSPARENT = 1  // 뒤에서 앞으로 (블렌딩 순서)
+};
+
+// 64비트 정렬 키: 상위 비트부터 패스 | 셰이더 변형 | 머티리얼 | 메시 | 깊이
+// 키 순서로 그리면 바꾸는 비용이 큰 상태일수록 덜 자주 바뀐다.
+// 머티리얼/메시 필드는 해시를 자른 값이라 충돌해도 순서만 섞일 뿐 그리기 결과는 같다.
+namespace RenderSortKey {
+    constexpr unsigned int PASS_BITS = 2;
+    constexpr unsigned int VARIANT_BITS = 10;
+    constexpr unsigned int MATERIAL_BITS = 16;
+    constexpr unsigned int MESH_BITS = 12;
+    constexpr unsigned int DEPTH_BITS = 24;
+    static_assert(PASS_BITS + VARIANT_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS == 64, "sort key must fill 64 bits");
+    
+    constexpr unsigned int DEPTH_SHIFT = 0;
+    constexpr unsigned int MESH_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+    constexpr unsigned int MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+    constexpr unsigned int VARIANT_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+    constexpr unsigned int PASS_SHIFT = VARIANT_SHIFT + VARIANT_BITS;
+    
+    // 각 필드는 비트 수에 맞게 잘림
+    uint64_t make(RenderPass pass, unsigned int variant, uint32_t material, uint32_t mesh, uint32_t depth);
+    // 카메라까지 거리(0 이상)를 DEPTH_BITS로 양자화 (불투명은 가까울수록, 반투명은 멀수록 작은 값)
+    uint32_t depth(float distance, RenderPass pass);
+}
+
+// 한 프레임의 드로 목록. 메시가 enqueue로 항목을 넣고, sort()가 키를 기수 정렬한 뒤 submit()이 키 순서로 그린다.
+// 버퍼는 프레임마다 clear()로 비우고 재사용하므로 정상 상태에서는 할당하지 않는다 (렌더 스레드 전용).
+class RenderQueue
+{
+public:
+    struct Item {
+        uint64_t key;
+        Mesh* mesh;
+        unsigned int features;  // 셰이더 변형
+        uint32_t transform;     // addTransform()이 돌려준 번호
+        uint32_t instanceBatch; // addInstances()가 돌려준 번호 (NO_INSTANCE_BATCH면 transform으로 한 번 그림)
+        uint32_t firstRange;    // 인덱스 구간 (glMultiDrawElements 단위)
+        uint32_t rangeCount;
+    };
+    
+    void clear();
+    // 모델 행렬을 등록하고 번호를 돌려줌 (같은 모델의 메시들이 공유)
+    uint32_t addTransform(const glm::mat4& model);
+    // 인스턴스 배열을 등록하고 배치 번호를 돌려줌 (같은 모델의 메시들이 공유, submit에서 한 번에 올림)
+    uint32_t addInstances(const ModelInstance* instances, size_t count);
+    void push(uint64_t key, Mesh* mesh, unsigned int features, uint32_t transform, uint32_t instanceBatch,
+              const GLsizei* counts, const void* const* offsets, size_t rangeCount);
+    
+    void sort();
+    // 정렬된 순서로 그림 (모델 행렬은 바뀔 때만 DrawData 블록에 씀, 인스턴스 데이터는 프레임 전체를 한 번에 올림)
+    void submit(Shader& shader, const MeshUniforms& uniforms, UniformBlockBuffers& uniformBlocks,
+                InstanceBuffer& instanceBuffer);
+    
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    
+private:
+    struct InstanceBatch {
+        uint32_t first;  // instances 안의 시작
+        uint32_t count;
+    };
+    
+    struct SortEntry {
+        uint64_t key;
+        uint32_t item;
+    };
+    
+    std::vector<Item> items;
+    std::vector<glm::mat4> transforms;
+    std::vector<InstanceData> instances;
+    std::vector<InstanceBatch> instanceBatches;
+    std::vector<GLsizei> rangeCounts;
+    std::vector<const void*> rangeOffsets;
+    // sort() 결과 (items 번호가 키 순서로)
+    std::vector<SortEntry> order;
+    std::vector<SortEntry> scratch;
+};
+
+#endif
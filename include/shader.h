@@ -1,37 +1,200 @@
 #ifndef SHADER_H
 #define SHADER_H
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
 #include <glad/glad.h>
+#include "gl_handle.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+// shader.vert/shader.frag 기능 비트 (비트 i가 켜진 변형은 pbrShaderFeatureDefines()[i]를 #define해서 컴파일)
+enum ShaderFeature : unsigned int {
+    FEATURE_ALBEDO_MAP = 1u << 0,
+    FEATURE_NORMAL_MAP = 1u << 1,
+    FEATURE_METALLIC_MAP = 1u << 2,
+    FEATURE_ROUGHNESS_MAP = 1u << 3,
+    FEATURE_AO_MAP = 1u << 4,
+    FEATURE_MATERIAL_FACTORS = 1u << 5,
+    FEATURE_TANGENT_SPACE = 1u << 6,
+    FEATURE_IBL = 1u << 7,
+    FEATURE_ALBEDO_SRGB = 1u << 8,
+    FEATURE_INSTANCED = 1u << 9
+};
+
+inline const std::vector<std::string>& pbrShaderFeatureDefines()
+{
+    static const std::vector<std::string> defines = {
+        "HAS_ALBEDO_MAP", "HAS_NORMAL_MAP", "HAS_METALLIC_MAP", "HAS_ROUGHNESS_MAP", "HAS_AO_MAP",
+        "USE_MATERIAL_FACTORS", "USE_TANGENT_SPACE", "USE_IBL", "ALBEDO_IS_SRGB", "USE_INSTANCING"
+    };
+    return defines;
+}
+
+enum UniformKind {
+    UNIFORM_INT,
+    UNIFORM_FLOAT,
+    UNIFORM_VEC2,
+    UNIFORM_VEC3,
+    UNIFORM_VEC4,
+    UNIFORM_MAT2,
+    UNIFORM_MAT3,
+    UNIFORM_MAT4
+};
+
+// C++ 타입별 uniform 종류 (bool은 int로 올림)
+template<typename T> struct UniformTraits;
+template<> struct UniformTraits<int> { static constexpr UniformKind kind = UNIFORM_INT; };
+template<> struct UniformTraits<bool> { static constexpr UniformKind kind = UNIFORM_INT; };
+template<> struct UniformTraits<float> { static constexpr UniformKind kind = UNIFORM_FLOAT; };
+template<> struct UniformTraits<glm::vec2> { static constexpr UniformKind kind = UNIFORM_VEC2; };
+template<> struct UniformTraits<glm::vec3> { static constexpr UniformKind kind = UNIFORM_VEC3; };
+template<> struct UniformTraits<glm::vec4> { static constexpr UniformKind kind = UNIFORM_VEC4; };
+template<> struct UniformTraits<glm::mat2> { static constexpr UniformKind kind = UNIFORM_MAT2; };
+template<> struct UniformTraits<glm::mat3> { static constexpr UniformKind kind = UNIFORM_MAT3; };
+template<> struct UniformTraits<glm::mat4> { static constexpr UniformKind kind = UNIFORM_MAT4; };
+
+// Shader::uniform<T>()가 돌려주는 타입 있는 핸들 (Shader의 uniform 슬롯 번호, 모든 변형에서 공통)
+// 기본값(무효 핸들)으로 set하면 아무것도 하지 않음
+template<typename T>
+struct UniformHandle {
+    static constexpr uint32_t INVALID = ~0u;
+    uint32_t slot = INVALID;
+    bool isValid() const { return slot != INVALID; }
+};
+
+// 프로그램 객체를 소유하므로 이동만 가능
+// 소스는 실행 파일에 포함된 것을 우선 쓰고, 링크 결과는 ShaderCache에 프로그램 바이너리로 저장한다.
+//
+// 기능 비트 조합마다 #define을 넣어 컴파일한 변형(permutation)을 처음 쓰일 때 만들어 보관한다.
+// 셰이더 안에서 분기 대신 전처리기로 기능을 고르므로 컴파일러가 쓰지 않는 텍스처 샘플링과 분기를 제거한다.
+// set으로 넣은 uniform 값은 Shader가 기억해 두었다가, 다른 변형을 바인딩할 때 그 변형에 아직 적용되지 않은 값만 다시 올린다.
+//
+// uniform은 이름으로 한 번 uniform<T>()를 호출해 핸들을 받아 두고 set(handle, value)로 올린다.
+// 변형을 링크한 직후 glGetActiveUniform으로 활성 uniform 위치를 모두 읽어 두므로
+// set은 문자열 조회/할당 없이 값 비교 후 glUniform* 한 번이다 (값이 같으면 호출도 생략).
 class Shader
 {
 public:
-    unsigned int ID;
+    // featureDefines[i]는 기능 비트 i의 #define 이름 (비어 있으면 변형 없이 기본 프로그램 하나)
+    Shader(const char* vertexPath, const char* fragmentPath, std::vector<std::string> featureDefines = {});
+    
+    Shader(Shader&&) noexcept = default;
+    Shader& operator=(Shader&&) noexcept = default;
     
-    Shader(const char* vertexPath, const char* fragmentPath);
+    // 마지막으로 쓴 변형을 바인딩 (처음이면 기능이 없는 기본 변형)
     void use();
-    void setBool(const std::string &name, bool value) const;
-    void setInt(const std::string &name, int value) const;
-    void setFloat(const std::string &name, float value) const;
-    void setVec2(const std::string &name, const glm::vec2 &value) const;
-    void setVec2(const std::string &name, float x, float y) const;
-    void setVec3(const std::string &name, const glm::vec3 &value) const;
-    void setVec3(const std::string &name, float x, float y, float z) const;
-    void setVec4(const std::string &name, const glm::vec4 &value) const;
-    void setVec4(const std::string &name, float x, float y, float z, float w) const;
-    void setMat2(const std::string &name, const glm::mat2 &mat) const;
-    void setMat3(const std::string &name, const glm::mat3 &mat) const;
-    void setMat4(const std::string &name, const glm::mat4 &mat) const;
+    // 기능 비트 조합의 변형을 바인딩 (없으면 이때 컴파일)
+    void use(unsigned int features);
+    // 첫 프레임에 컴파일이 몰리지 않도록 미리 만들어 둘 변형 목록
+    void warmUp(const std::vector<unsigned int>& featureSets);
+    size_t variantCount() const { return variants.size(); }
+    
+    // 이름에 해당하는 핸들 (배열은 "[0]" 없이 이름만), 다른 타입으로 이미 등록된 이름이면 무효 핸들
+    // 아직 컴파일하지 않은 변형에만 있는 uniform도 받을 수 있으므로 그리기 전에 한 번 받아 둘 것
+    template<typename T>
+    UniformHandle<T> uniform(const std::string& name)
+    {
+        UniformHandle<T> handle;
+        handle.slot = slotFor(name, UniformTraits<T>::kind);
+        return handle;
+    }
+    
+    template<typename T>
+    void set(UniformHandle<T> handle, const T& value)
+    {
+        setSlot(handle.slot, &value, sizeof(T), 1);
+    }
+    void set(UniformHandle<bool> handle, bool value)
+    {
+        int intValue = value ? 1 : 0;
+        setSlot(handle.slot, &intValue, sizeof(int), 1);
+    }
+    // uniform 배열 앞에서부터 count개
+    template<typename T>
+    void set(UniformHandle<T> handle, const T* values, size_t count)
+    {
+        setSlot(handle.slot, values, sizeof(T), count);
+    }
+    
+    // 이름으로 바로 올리는 편의 함수 (매번 이름을 찾으므로 초기화 코드용, 프레임마다 쓰는 값은 핸들 사용)
+    void setBool(const std::string &name, bool value);
+    void setInt(const std::string &name, int value);
+    void setFloat(const std::string &name, float value);
+    void setVec2(const std::string &name, const glm::vec2 &value);
+    void setVec2(const std::string &name, float x, float y);
+    void setVec3(const std::string &name, const glm::vec3 &value);
+    void setVec3(const std::string &name, float x, float y, float z);
+    void setVec4(const std::string &name, const glm::vec4 &value);
+    void setVec4(const std::string &name, float x, float y, float z, float w);
+    void setMat2(const std::string &name, const glm::mat2 &mat);
+    void setMat3(const std::string &name, const glm::mat3 &mat);
+    void setMat4(const std::string &name, const glm::mat4 &mat);
     
 private:
-    void checkCompileErrors(unsigned int shader, std::string type);
+    // 슬롯마다 마지막으로 설정한 값 (revision이 변형의 appliedRevision보다 크면 그 변형에는 아직 안 올라감)
+    struct UniformValue {
+        std::string name;
+        UniformKind kind = UNIFORM_INT;
+        // int/float 원소를 그대로 담은 바이트 (배열이면 원소 수만큼)
+        std::vector<unsigned char> data;
+        GLsizei count = 0;
+        uint64_t revision = 0;
+    };
+    
+    // glGetActiveUniform으로 읽은 변형의 활성 uniform
+    struct ActiveUniform {
+        std::string name;
+        GLint location;
+        GLint size;  // 배열 원소 수
+        GLenum type;
+    };
+    
+    // 변형 안에서 슬롯이 가리키는 위치 (location < 0이면 이 변형에서 쓰지 않음)
+    struct UniformBinding {
+        GLint location = -1;
+        GLint size = 0;
+        bool resolved = false;
+    };
+    
+    struct Variant {
+        GLProgram program;
+        std::vector<ActiveUniform> active;
+        // uniforms 슬롯별 위치 (슬롯이 처음 쓰일 때 active에서 찾아 채움)
+        std::vector<UniformBinding> bindings;
+        uint64_t appliedRevision = 0;
+    };
+    
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::string vertexCode;
+    std::string fragmentCode;
+    std::vector<std::string> featureDefines;
+    // 포인터가 이동/재해시 후에도 유지되도록 unique_ptr로 보관
+    std::unordered_map<unsigned int, std::unique_ptr<Variant>> variants;
+    Variant* current = nullptr;
+    
+    std::vector<UniformValue> uniforms;
+    std::unordered_map<std::string, uint32_t> uniformSlots;
+    uint64_t revision = 0;
+    
+    Variant& variant(unsigned int features);
+    void compileVariant(Variant& variant, unsigned int features);
+    void reflect(Variant& variant);
+    std::string withDefines(const std::string& code, unsigned int features) const;
+    void bind(Variant& variant);
+    uint32_t slotFor(const std::string& name, UniformKind kind);
+    void setSlot(uint32_t slot, const void* data, size_t elementSize, size_t count);
+    const UniformBinding& binding(Variant& variant, uint32_t slot);
+    void applyUniform(Variant& variant, uint32_t slot);
+    // 성공하면 true
+    bool checkCompileErrors(unsigned int shader, std::string type);
 };
 
 #endif
-
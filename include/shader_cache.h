@@ -0,0 +1,40 @@
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <glad/glad.h>
+
+// 셰이더 캐시 설정 (셰이더 생성 전에 렌더 스레드에서 변경)
+struct ShaderCacheSettings {
+    // 링크된 프로그램 바이너리를 저장해 두고 다음 실행에서 컴파일/링크 없이 올림
+    bool enabled = true;
+    // 실행 파일에 포함된 소스를 우선 사용 (끄면 작업 디렉터리의 파일을 읽어 재빌드 없이 셰이더 수정 가능)
+    bool embeddedSources = true;
+};
+
+// glGetProgramBinary/glProgramBinary 기반 프로그램 캐시.
+// 키는 셰이더 소스와 드라이버 vendor/renderer/version 문자열의 해시이므로 소스나 드라이버가 바뀌면 다시 링크한다.
+// 드라이버가 바이너리를 거부하면 (링크 상태 실패) load()가 false를 돌려주고 호출자는 소스에서 컴파일한다.
+namespace ShaderCache {
+    constexpr uint32_t VERSION = 1;
+    
+    ShaderCacheSettings& settings();
+    
+    // EMBED_SHADERS로 빌드했으면 포함된 소스를, 아니면 파일을 읽음 (이름은 파일명으로 찾음)
+    bool readSource(const std::string& path, std::string& out);
+    
+    // variantName은 Shader 변형 구분용 (기능 비트), 비어 있으면 기본 프로그램
+    std::string pathFor(const std::string& vertexPath, const std::string& fragmentPath,
+                        const std::string& variantName = std::string());
+    uint64_t computeKey(const std::string& vertexCode, const std::string& fragmentCode);
+    
+    // 프로그램 바이너리 지원이 없거나 캐시가 꺼져 있으면 항상 false
+    bool available();
+    // 성공하면 program은 링크된 상태
+    bool load(GLuint program, const std::string& cachePath, uint64_t key);
+    // 링크 전에 GL_PROGRAM_BINARY_RETRIEVABLE_HINT를 켜 두어야 함
+    bool save(GLuint program, const std::string& cachePath, uint64_t key);
+}
+
+#endif
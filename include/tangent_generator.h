@@ -0,0 +1,33 @@
+#ifndef TANGENT_GENERATOR_H
+#define TANGENT_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+#include "thread_pool.h"
+
+// 탄젠트 생성 설정 (모델 로드 전에 렌더 스레드에서 변경)
+struct TangentGeneratorSettings {
+    // 끄면 Assimp CalcTangentSpace 사용 (내장 OBJ/glTF 로더는 탄젠트가 없으면 노말 맵 생략)
+    bool enabled = true;
+    // 파일에 탄젠트가 있어도 다시 생성 (MikkTSpace로 구운 노말 맵과 기저를 맞출 때)
+    bool force = false;
+};
+
+// MikkTSpace(Blender/Substance/xNormal 베이커 기준)와 같은 규칙으로 정점 탄젠트를 만든다.
+//   - 삼각형 UV 기울기로 구한 탄젠트를 꼭짓점 노말 평면에 투영하고 꼭짓점 내각으로 가중 평균
+//   - 위치/노말/UV가 같은 정점은 인덱스가 달라도 같은 그룹, UV 방향(미러링)이 다르면 다른 그룹
+//   - Bitangent = sign * cross(N, T) (sign은 UV 방향)
+// 투영/정규화/내각 계산은 꼭짓점 블록 단위 SoA 배열에서 SSE로 4개씩 처리하고, 블록은 스레드 풀에서 나눠 처리한다.
+namespace TangentGenerator {
+    TangentGeneratorSettings& settings();
+    // 캐시 키에 섞을 설정 해시
+    uint64_t settingsSeed(const TangentGeneratorSettings& settings);
+    
+    // 방향이 다른 삼각형이 함께 쓰는 정점은 복제하고 인덱스를 고침 (추가된 정점 수 반환)
+    size_t generate(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                    ThreadPool& pool = ThreadPool::shared());
+}
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef TEXTURE_CONTAINER_H
+#define TEXTURE_CONTAINER_H
+
+#include <string>
+#include "texture_image.h"
+
+// 미리 압축된 밉 체인을 담는 텍스처 컨테이너 입출력 (KTX2 / DDS).
+// 읽기는 파일을 mmap한 채로 레벨 포인터만 넘기므로 추가 복사가 없다.
+namespace TextureContainer {
+    // sourceKey: 텍스처 캐시가 기록한 원본 해시 (Key/Value 데이터 "PBRsourceKey", 없으면 빈 문자열)
+    bool readKTX2(const std::string& path, DecodedImage& out, std::string* sourceKey = nullptr);
+    bool readDDS(const std::string& path, DecodedImage& out);
+    bool writeKTX2(const std::string& path, const DecodedImage& image, const std::string& sourceKey);
+}
+
+#endif
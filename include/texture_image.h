@@ -0,0 +1,46 @@
+#ifndef TEXTURE_IMAGE_H
+#define TEXTURE_IMAGE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 텍스처 용도 (압축 포맷 선택에 사용)
+enum class TextureUsage {
+    Color,  // albedo: BC1 (알파가 있으면 BC3)
+    Normal, // 노말 맵: BC5 (XY만 저장, 셰이더에서 Z 복원)
+    Scalar, // 단일 채널 맵: R8 / BC4
+    Packed  // 채널마다 다른 스칼라 맵 (ORM): BC1, 채널별 선형 필터링
+};
+
+// 워커 스레드에서 준비된 텍스처 데이터 (GL 객체 생성 전 단계)
+// 비압축 RGBA8 계열이거나, 블록 압축된 밉 체인일 수 있다.
+struct DecodedImage {
+    struct Level {
+        int width = 0;
+        int height = 0;
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+    };
+    
+    std::vector<Level> levels;           // 0번이 원본 해상도
+    std::shared_ptr<const void> storage; // 레벨 데이터 소유자 (stb 버퍼, 매핑된 파일, 인코딩 결과)
+    unsigned int internalFormat = 0;     // GL 내부 포맷
+    unsigned int format = 0;             // 비압축일 때 업로드 포맷 (GL_RED/GL_RG/GL_RGB/GL_RGBA)
+    bool compressed = false;
+    int channels = 0;                    // 비압축일 때 픽셀당 바이트 수
+    std::string resolvedPath;            // 실제로 읽은 경로 (실패 시 빈 문자열)
+    unsigned int packedChannels = 0;     // 묶은 텍스처에 실제로 소스가 들어간 채널 (1: R, 2: G, 4: B)
+    
+    bool isValid() const { return !levels.empty(); }
+    int width() const { return levels.empty() ? 0 : levels[0].width; }
+    int height() const { return levels.empty() ? 0 : levels[0].height; }
+};
+
+// 압축 포맷의 4x4 블록 크기 (비압축 포맷이면 0)
+size_t compressedBlockBytes(unsigned int internalFormat);
+// 한 밉 레벨의 바이트 수
+size_t compressedLevelBytes(unsigned int internalFormat, int width, int height);
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include <array>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mip_generator.h"
+#include "texture_image.h"
+#include "texture_uploader.h"
+#include "thread_pool.h"
+
+// 텍스처 임포트 설정 (로드 시작 전에 렌더 스레드에서 변경)
+struct TextureImportSettings {
+    // 미리 압축된 KTX2/DDS가 없으면 CPU에서 BCn으로 인코딩하고 <원본>.<용도>.ktx2 캐시에 저장
+    bool compressOnImport = true;
+    // 밉 체인을 CPU에서 만들어 캐시에 함께 저장 (끄면 비압축 텍스처는 glGenerateMipmap 사용)
+    bool generateMips = true;
+    MipSettings mips;
+};
+
+// requestPacked 소스마다 읽을 채널 (0~3이면 R/G/B/A 그대로, PACKED_LUMINANCE면 휘도로 변환)
+constexpr int PACKED_LUMINANCE = -1;
+
+// 텍스처 로딩을 두 단계로 나눈다:
+//   request()  - 파일 읽기/디코딩/압축을 스레드 풀에 예약 (GL 호출 없는 CPU 작업)
+//   resolve()  - 렌더 스레드에서 GL 텍스처를 만들고 픽셀 전송은 업로더 큐에 넣음
+// 중복 제거는 호출자(AssetManager) 몫이다.
+class TextureLoader
+{
+public:
+    explicit TextureLoader(ThreadPool& pool = ThreadPool::shared());
+    
+    static TextureImportSettings& settings();
+    
+    // 파일이 아닌 메모리의 이미지(glTF 내장 이미지 등)를 name으로 등록 (워커 스레드에서 호출 가능)
+    // 이후 요청의 파일 이름이 name이면 디스크 대신 이 바이트를 디코딩. 등록은 프로세스가 끝날 때까지 유지되므로
+    // name에 내용 해시를 넣어 같은 이미지는 같은 항목을, 바뀐 이미지는 새 항목(과 새 텍스처 캐시 키)을 쓰게 함
+    static void addMemoryImage(const std::string& name, std::vector<unsigned char> bytes);
+    
+    // 디코딩을 예약하고 티켓 번호 반환
+    size_t request(const std::string& file, const std::string& directory, TextureUsage usage);
+    // 세 맵(빈 문자열이면 생략)에서 channels의 채널을 하나씩 읽어 R/G/B 채널 하나의 텍스처로 묶어 디코딩
+    size_t requestPacked(const std::array<std::string, 3>& files, const std::array<int, 3>& channels,
+                         const std::string& directory);
+    void resolve();
+    // resolve() 이후 유효 (로드 실패 시 0)
+    unsigned int textureId(size_t ticket) const;
+    // requestPacked()로 묶은 텍스처에 실제로 소스가 들어간 채널 (1: R, 2: G, 4: B, 로드 실패 시 0)
+    unsigned int packedChannels(size_t ticket) const;
+    // 처리한 티켓을 모두 비움 (resolve() 이후 호출)
+    void clear();
+    
+    // 워커 스레드에서 실행 (밉 생성/압축은 pool에서 병렬 처리): 탐색 순서는 <이름>.ktx2 -> <이름>.dds -> 텍스처 캐시 -> PNG 원본
+    // (메모리 이미지면 텍스처 캐시 -> 메모리의 원본)
+    static DecodedImage decode(const std::string& file, const std::string& directory, TextureUsage usage,
+                               const TextureImportSettings& settings, ThreadPool& pool);
+    
+    TextureUploader& uploads() { return uploader; }
+    
+private:
+    struct Slot {
+        std::string file;
+        std::string directory;
+        std::future<DecodedImage> pending;
+        unsigned int id = 0;
+        unsigned int packedChannels = 0;
+        bool resolved = false;
+    };
+    
+    ThreadPool& pool;
+    TextureUploader uploader;
+    std::vector<Slot> slots;
+    
+    static std::shared_ptr<const std::vector<unsigned char>> findMemoryImage(const std::string& name);
+    static std::vector<std::string> candidatePaths(const std::string& file, const std::string& directory);
+    static std::vector<std::string> getDefaultTexturePaths(const std::string& baseName, const std::string& textureName);
+    static DecodedImage decodeFile(const std::string& path, TextureUsage usage, const TextureImportSettings& settings,
+                                   ThreadPool& pool);
+    static DecodedImage decodePacked(const std::array<std::string, 3>& files, const std::array<int, 3>& channels,
+                                     const std::string& directory, const TextureImportSettings& settings,
+                                     ThreadPool& pool);
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef TEXTURE_UPLOADER_H
+#define TEXTURE_UPLOADER_H
+
+#include <glad/glad.h>
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
+#include "gl_handle.h"
+#include "texture_image.h"
+#include "thread_pool.h"
+
+// 업로드 스케줄러 설정 (렌더 스레드에서 변경)
+struct TextureUploadSettings {
+    size_t frameBudgetBytes = 8u << 20;     // 한 프레임에 PBO로 올리는 최대 바이트
+    size_t stagingBufferBytes = 4u << 20;   // PBO 하나의 크기
+    unsigned int stagingBufferCount = 4;    // PBO 개수 (펜스가 풀릴 때까지 재사용하지 않음)
+    size_t immediateTailBytes = 64u << 10;  // 이 크기 이하의 작은 밉 꼬리는 생성 즉시 업로드
+};
+
+// 픽셀 버퍼 객체(PBO)를 통한 비동기 텍스처 업로드.
+//   createTexture() - 텍스처 객체와 저장 공간을 만들고 작은 밉만 바로 올린 뒤 나머지는 큐에 넣음
+//   update()        - 매 프레임: 펜스가 풀린 PBO 회수 -> 워커가 채운 PBO로 glTexSubImage2D
+//                     -> 예산만큼 새 PBO를 매핑해 워커에게 복사를 맡김
+// 밉은 작은 레벨부터 올리고 GL_TEXTURE_BASE_LEVEL을 내려가며 점점 선명해지므로,
+// 반환된 텍스처 ID는 업로드가 끝나기 전에도 바로 바인딩할 수 있다.
+class TextureUploader
+{
+public:
+    explicit TextureUploader(ThreadPool& pool = ThreadPool::shared());
+    ~TextureUploader();
+    
+    TextureUploader(const TextureUploader&) = delete;
+    TextureUploader& operator=(const TextureUploader&) = delete;
+    
+    static TextureUploadSettings& settings();
+    
+    unsigned int createTexture(const DecodedImage& image);
+    void update();
+    // 텍스처를 삭제하기 전에 호출해 남은 업로드를 버림
+    void cancel(unsigned int texture);
+    // 워커 복사를 기다린 뒤 PBO와 펜스 해제 (GL 컨텍스트가 살아 있을 때 호출)
+    void releaseGL();
+    
+    bool idle() const;
+    size_t pendingBytes() const { return queuedBytes; }
+    
+private:
+    // 아직 PBO에 담지 않은 텍스처 (큰 레벨부터 작은 레벨 순으로 남아 있음)
+    struct Job {
+        unsigned int texture = 0;
+        DecodedImage image;
+        int level = 0;          // 다음에 올릴 레벨 (0까지 내려감)
+        int nextRow = 0;        // 레벨 안에서 다음에 올릴 행
+        bool generateMips = false;
+    };
+    
+    // PBO 안의 한 구간 = glTexSubImage2D 한 번
+    struct Region {
+        unsigned int texture = 0;   // 취소되면 0
+        int level = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        size_t offset = 0;
+        size_t bytes = 0;
+        const unsigned char* source = nullptr;
+        std::shared_ptr<const void> storage;
+        unsigned int internalFormat = 0;
+        unsigned int format = 0;
+        bool compressed = false;
+        bool finishesLevel = false;
+        bool generateMips = false;
+    };
+    
+    enum class BufferState { Free, Staging, InFlight };
+    
+    struct StagingBuffer {
+        GLBuffer buffer;
+        size_t capacity = 0;
+        size_t stagedBytes = 0;
+        BufferState state = BufferState::Free;
+        void* mapped = nullptr;
+        std::future<void> copy;
+        std::vector<Region> regions;
+        GLsync fence = nullptr;
+    };
+    
+    ThreadPool& pool;
+    std::deque<Job> jobs;
+    std::vector<StagingBuffer> buffers;
+    std::deque<size_t> stagingOrder;   // 매핑한 순서대로 제출해야 레벨 완료 순서가 지켜짐
+    size_t queuedBytes = 0;
+    
+    void retireBuffers();
+    void submitStaged();
+    void stageJobs();
+    bool fillBuffer(StagingBuffer& staging, size_t capacity, size_t& budget, bool mustProgress);
+    void uploadRegion(const Region& region, const void* data);
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// 고정 크기 워커 스레드 풀 (GL 호출이 없는 CPU 작업 전용)
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned int threadCount);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    // 프로세스 공용 풀 (코어 수 - 1개, 렌더 스레드 몫을 남김)
+    static ThreadPool& shared();
+    
+    unsigned int size() const { return static_cast<unsigned int>(workers.size()); }
+    
+    template <class F>
+    std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& task)
+    {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        wakeCondition.notify_one();
+        return result;
+    }
+    
+    // [0, count)를 grain 크기 구간으로 나눠 병렬 실행하고 모두 끝나면 반환.
+    // 호출 스레드도 구간을 처리하므로 풀의 워커 안에서 호출해도 교착되지 않는다.
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& body);
+    
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex queueMutex;
+    std::condition_variable wakeCondition;
+    bool stopping = false;
+    
+    void workerLoop();
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef UNIFORM_BLOCKS_H
+#define UNIFORM_BLOCKS_H
+
+#include <cstddef>
+#include <string>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "gl_handle.h"
+
+// 모든 셰이더 프로그램이 공유하는 std140 uniform 블록.
+// 셰이더의 블록 선언과 필드 순서/패딩이 같아야 한다 (vec3는 vec4로 채워 정렬을 맞춤).
+// GL 3.3에는 layout(binding)이 없으므로 Shader가 링크 직후 블록 이름으로 바인딩 포인트를 지정한다.
+namespace UniformBlocks {
+    constexpr GLuint FRAME_BINDING = 0;
+    constexpr GLuint DRAW_BINDING = 1;
+    constexpr int MAX_LIGHTS = 4;
+    
+    // layout(std140) uniform FrameData (프레임당 한 번 갱신)
+    struct FrameData {
+        glm::mat4 projection;
+        glm::mat4 view;
+        glm::vec4 viewPos;                    // xyz
+        glm::vec4 lightPositions[MAX_LIGHTS]; // xyz
+        glm::vec4 lightColors[MAX_LIGHTS];    // xyz
+        int numLights;
+        int padding[3];
+    };
+    
+    // layout(std140) uniform DrawData (그리기 단위로 갱신)
+    struct DrawData {
+        glm::mat4 model;
+        // std140 mat3은 열마다 vec4 하나를 차지
+        glm::vec4 normalMatrix[3];
+    };
+    
+    static_assert(sizeof(FrameData) == 288, "FrameData must match the std140 layout");
+    static_assert(sizeof(DrawData) == 112, "DrawData must match the std140 layout");
+    
+    // 셰이더 블록 이름의 고정 바인딩 포인트 (모르는 블록이면 -1)
+    int bindingFor(const std::string& blockName);
+}
+
+// FrameData/DrawData 버퍼를 만들어 고정 바인딩 포인트에 묶는다 (GL 컨텍스트가 있을 때 생성, 렌더 스레드 전용).
+// 드로 블록은 정렬된 슬롯을 차례로 쓰는 링 버퍼이므로 GPU가 아직 읽는 이전 드로 값을 덮어쓰지 않고,
+// 링이 다 차면 버퍼를 고아로 만들어(orphan) 새 저장 공간에서 다시 시작한다.
+class UniformBlockBuffers
+{
+public:
+    explicit UniformBlockBuffers(size_t drawCapacity = 256);
+    
+    UniformBlockBuffers(const UniformBlockBuffers&) = delete;
+    UniformBlockBuffers& operator=(const UniformBlockBuffers&) = delete;
+    
+    // 버퍼 쓰기 한 번으로 카메라/조명 갱신
+    void updateFrame(const UniformBlocks::FrameData& data);
+    // 모델 행렬과 노말 행렬을 다음 슬롯에 쓰고 DRAW_BINDING을 그 구간으로 바꿈
+    void pushDraw(const glm::mat4& model);
+    
+private:
+    GLBuffer frameBuffer;
+    GLBuffer drawBuffer;
+    size_t drawStride = 0;   // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT에 맞춘 슬롯 크기
+    size_t drawCapacity = 0;
+    size_t drawCursor = 0;
+};
+
+#endif
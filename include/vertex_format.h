@@ -0,0 +1,70 @@
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+
+// GPU용 압축 정점 (20바이트)
+//   위치: 메시 AABB 기준 snorm16 (w에 바이탄젠트 부호)
+//   노말/탄젠트: 옥타헤드럴 snorm16, UV: half float
+struct PackedVertex {
+    int16_t position[4];
+    int16_t normal[2];
+    int16_t tangent[2];
+    uint16_t texCoords[2];
+};
+
+// 위치 양자화 오차가 허용치를 넘는 메시용 (28바이트, 위치만 float)
+struct PackedVertexFloat {
+    float position[4];
+    int16_t normal[2];
+    int16_t tangent[2];
+    uint16_t texCoords[2];
+};
+
+// 정점 포맷 설정 (메시 생성 전에 렌더 스레드에서 변경)
+struct VertexFormatSettings {
+    // 위치를 16비트로 양자화 (끄면 항상 float 위치)
+    bool quantizePositions = true;
+    // 양자화 오차(모델 공간 단위)가 이보다 크면 float 위치로 대체 (0이면 제한 없음)
+    float maxPositionError = 0.0f;
+};
+
+// setupMesh가 업로드하는 정점/인덱스 스트림
+struct PackedMesh {
+    std::vector<unsigned char> vertexData;
+    std::vector<unsigned char> indexData;
+    bool quantizedPositions = true;
+    // 셰이더에서 position * positionScale + positionOffset 으로 복원
+    glm::vec3 positionScale = glm::vec3(1.0f);
+    glm::vec3 positionOffset = glm::vec3(0.0f);
+    GLenum indexType = GL_UNSIGNED_INT;
+    // 모델 공간 바운딩 구 (boundsExtent와 함께면 AABB)
+    glm::vec3 boundsCenter = glm::vec3(0.0f);
+    float boundsRadius = 0.0f;
+    glm::vec3 boundsExtent = glm::vec3(0.0f);
+};
+
+namespace VertexFormat {
+
+VertexFormatSettings& settings();
+
+// 메시마다 위치 인코딩과 인덱스 폭(정점 65536개 이하면 16비트)을 고름
+PackedMesh pack(const Vertex* vertexData, size_t vertexCount, const unsigned int* indexData, size_t indexCount,
+                const VertexFormatSettings& settings);
+
+// 현재 바인딩된 VAO/VBO에 속성 포인터 설정 (셰이더 location 0~3)
+void setupAttributes(bool quantizedPositions);
+// 현재 바인딩된 VAO에 GL_ARRAY_BUFFER의 InstanceData 속성 포인터 설정 (location 4~11, 인스턴스마다 진행)
+void setupInstanceAttributes(size_t byteOffset);
+
+glm::vec2 encodeOctahedral(glm::vec3 direction);
+glm::vec3 decodeOctahedral(glm::vec2 encoded);
+
+} // namespace VertexFormat
+
+#endif
@@ -10,26 +10,30 @@ in VS_OUT {
     mat3 TBN;
 } fs_in;
 
+#ifdef USE_INSTANCING
+flat in vec4 InstanceMaterial; // rgb: 색조, a: 거칠기 덮어쓰기 (음수면 없음)
+#endif
+
 uniform sampler2D albedoMap;
 uniform sampler2D normalMap;
-uniform sampler2D metallicMap;
-uniform sampler2D roughnessMap;
-uniform sampler2D aoMap;
+uniform sampler2D ormMap; // R: AO, G: roughness, B: metallic
 uniform samplerCube irradianceMap;
 uniform samplerCube prefilterMap;
 uniform sampler2D brdfLUT;
 
-// camera position (world space)
-uniform vec3 viewPos;
+// 공유 uniform 블록 (UniformBlocks::FrameData와 같은 레이아웃, 카메라 위치는 월드 공간)
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;            // xyz
+    vec4 lightPositions[4];  // xyz
+    vec4 lightColors[4];     // xyz
+    int numLights;
+};
 
-uniform bool hasAlbedoMap;
-uniform bool hasNormalMap;
-uniform bool hasMetallicMap;
-uniform bool hasRoughnessMap;
-uniform bool hasAoMap;
-uniform bool useTangentSpace;
-uniform bool useIBL;
-uniform bool albedoIsSRGB;
+// 기능 플래그는 Shader가 변형마다 #define으로 넣는다 (ShaderFeature):
+// HAS_ALBEDO_MAP, HAS_NORMAL_MAP, HAS_METALLIC_MAP, HAS_ROUGHNESS_MAP, HAS_AO_MAP,
+// USE_MATERIAL_FACTORS, USE_TANGENT_SPACE, USE_IBL, ALBEDO_IS_SRGB
 
 // 기본 Material 값 (맵이 없을 때 사용)
 uniform vec3 albedo;
@@ -37,9 +41,10 @@ uniform float metallic;
 uniform float roughness;
 uniform float ao;
 
-uniform vec3 lightPositions[4];
-uniform vec3 lightColors[4];
-uniform int numLights;
+// glTF metallic-roughness 계수 (맵 값에 곱하고, 맵이 없으면 위 기본 값 대신 사용)
+uniform vec3 baseColorFactor;
+uniform float metallicFactor;
+uniform float roughnessFactor;
 
 const float PI = 3.14159265359;
 
@@ -90,42 +95,60 @@ vec3 fresnelSchlick(float cosTheta, vec3 F0)
 void main()
 {
     // Material 속성 가져오기
+#ifdef USE_MATERIAL_FACTORS
+    vec3 albedoColor = vec3(1.0);
+    float metallicValue = 1.0;
+    float roughnessValue = 1.0;
+#else
     vec3 albedoColor = albedo;
     float metallicValue = metallic;
     float roughnessValue = roughness;
+#endif
     float aoValue = ao;
     
-    if (hasAlbedoMap) {
-        albedoColor = texture(albedoMap, fs_in.TexCoords).rgb;
-        if (albedoIsSRGB) {
-            albedoColor = pow(albedoColor, vec3(2.2)); // sRGB -> linear
-        }
-    }
-    if (hasMetallicMap) {
-        metallicValue = texture(metallicMap, fs_in.TexCoords).r;
-    }
-    if (hasRoughnessMap) {
-        roughnessValue = texture(roughnessMap, fs_in.TexCoords).r;
-    }
-    if (hasAoMap) {
-        aoValue = texture(aoMap, fs_in.TexCoords).r;
-    }
+#ifdef HAS_ALBEDO_MAP
+    albedoColor = texture(albedoMap, fs_in.TexCoords).rgb;
+#ifdef ALBEDO_IS_SRGB
+    albedoColor = pow(albedoColor, vec3(2.2)); // sRGB -> linear
+#endif
+#endif
+#if defined(HAS_AO_MAP) || defined(HAS_ROUGHNESS_MAP) || defined(HAS_METALLIC_MAP)
+    vec3 orm = texture(ormMap, fs_in.TexCoords).rgb;
+#ifdef HAS_AO_MAP
+    aoValue = orm.r;
+#endif
+#ifdef HAS_ROUGHNESS_MAP
+    roughnessValue = orm.g;
+#endif
+#ifdef HAS_METALLIC_MAP
+    metallicValue = orm.b;
+#endif
+#endif
+#ifdef USE_MATERIAL_FACTORS
+    albedoColor *= baseColorFactor;
+    metallicValue *= metallicFactor;
+    roughnessValue *= roughnessFactor;
+#endif
+#ifdef USE_INSTANCING
+    albedoColor *= InstanceMaterial.rgb;
+    if (InstanceMaterial.a >= 0.0)
+        roughnessValue = InstanceMaterial.a;
+#endif
     
     // Normal mapping - tangent space에서 기본 normal은 (0,0,1)
-    vec3 N;
-    vec3 V;
-    if (useTangentSpace) {
-        N = vec3(0.0, 0.0, 1.0);
-        if (hasNormalMap) {
-            vec3 normalSample = texture(normalMap, fs_in.TexCoords).rgb;
-            N = normalSample * 2.0 - 1.0; // [0,1] -> [-1,1]
-            N = normalize(N);
-        }
-        V = normalize(fs_in.TangentViewPos - fs_in.TangentFragPos);
-    } else {
-        N = normalize(fs_in.Normal);
-        V = normalize(viewPos - fs_in.FragPos);
-    }
+#ifdef USE_TANGENT_SPACE
+#ifdef HAS_NORMAL_MAP
+    // XY만 사용하고 Z는 복원 (BC5 노말 맵은 RG 두 채널만 저장)
+    vec2 normalXY = texture(normalMap, fs_in.TexCoords).rg * 2.0 - 1.0; // [0,1] -> [-1,1]
+    vec3 N = normalize(vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0))));
+#else
+    vec3 N = vec3(0.0, 0.0, 1.0);
+#endif
+    vec3 V = normalize(fs_in.TangentViewPos - fs_in.TangentFragPos);
+#else
+    vec3 N = normalize(fs_in.Normal);
+    vec3 V = normalize(viewPos.xyz - fs_in.FragPos);
+#endif
     
     // Dielectric F0 (0.04) 또는 Metallic F0 (albedo)
     vec3 F0 = vec3(0.04);
@@ -138,21 +161,19 @@ void main()
     vec3 Lo = vec3(0.0);
     for(int i = 0; i < numLights; ++i)
     {
-        vec3 L;
-        float distance;
-        if (useTangentSpace) {
-            vec3 worldLightPos = lightPositions[i];
-            vec3 tangentLightPos = fs_in.TBN * worldLightPos;
-            L = normalize(tangentLightPos - fs_in.TangentFragPos);
-            distance = length(worldLightPos - fs_in.FragPos);
-        } else {
-            L = normalize(lightPositions[i] - fs_in.FragPos);
-            distance = length(lightPositions[i] - fs_in.FragPos);
-        }
+#ifdef USE_TANGENT_SPACE
+        vec3 worldLightPos = lightPositions[i].xyz;
+        vec3 tangentLightPos = fs_in.TBN * worldLightPos;
+        vec3 L = normalize(tangentLightPos - fs_in.TangentFragPos);
+        float distance = length(worldLightPos - fs_in.FragPos);
+#else
+        vec3 L = normalize(lightPositions[i].xyz - fs_in.FragPos);
+        float distance = length(lightPositions[i].xyz - fs_in.FragPos);
+#endif
         vec3 H = normalize(V + L);
         
         float attenuation = 1.0 / (distance * distance);
-        vec3 radiance = lightColors[i] * attenuation;
+        vec3 radiance = lightColors[i].xyz * attenuation;
         
         // Cook-Torrance BRDF
         float NDF = DistributionGGX(N, H, roughnessValue);
@@ -171,22 +192,21 @@ void main()
         Lo += (kD * albedoColor / PI + specular) * radiance * NdotL;
     }
     
-    vec3 ambient;
-    if (useIBL) {
-        // IBL diffuse
-        vec3 irradiance = texture(irradianceMap, N).rgb;
-        vec3 diffuse = irradiance * albedoColor;
-        
-        // IBL specular
-        vec3 R = reflect(-V, N);
-        vec3 prefilteredColor = textureLod(prefilterMap, R, roughnessValue * 4.0).rgb;
-        vec2 envBRDF = texture(brdfLUT, vec2(max(dot(N, V), 0.0), roughnessValue)).rg;
-        vec3 specularIBL = prefilteredColor * (FresnelV * envBRDF.x + envBRDF.y);
-        
-        ambient = (kDBase * diffuse + specularIBL) * aoValue;
-    } else {
-        ambient = vec3(0.2) * albedoColor * aoValue;
-    }
+#ifdef USE_IBL
+    // IBL diffuse
+    vec3 irradiance = texture(irradianceMap, N).rgb;
+    vec3 diffuse = irradiance * albedoColor;
+    
+    // IBL specular
+    vec3 R = reflect(-V, N);
+    vec3 prefilteredColor = textureLod(prefilterMap, R, roughnessValue * 4.0).rgb;
+    vec2 envBRDF = texture(brdfLUT, vec2(max(dot(N, V), 0.0), roughnessValue)).rg;
+    vec3 specularIBL = prefilteredColor * (FresnelV * envBRDF.x + envBRDF.y);
+    
+    vec3 ambient = (kDBase * diffuse + specularIBL) * aoValue;
+#else
+    vec3 ambient = vec3(0.2) * albedoColor * aoValue;
+#endif
     
     vec3 color = ambient + Lo;
     
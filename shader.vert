@@ -1,9 +1,17 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 0) in vec4 aPos;       // xyz: 양자화된 위치, w: 바이탄젠트 부호
+layout (location = 1) in vec2 aNormal;    // 옥타헤드럴 인코딩
 layout (location = 2) in vec2 aTexCoords;
-layout (location = 3) in vec3 aTangent;
-layout (location = 4) in vec3 aBitangent;
+layout (location = 3) in vec2 aTangent;   // 옥타헤드럴 인코딩
+
+#ifdef USE_INSTANCING
+// 인스턴스 VBO (InstanceData), 인스턴스마다 한 번 진행
+layout (location = 4) in mat4 aInstanceModel;         // location 4~7
+layout (location = 8) in mat3 aInstanceNormalMatrix;  // location 8~10
+layout (location = 11) in vec4 aInstanceMaterial;     // rgb: 색조, a: 거칠기 덮어쓰기 (음수면 없음)
+
+flat out vec4 InstanceMaterial;
+#endif
 
 out VS_OUT {
     vec3 FragPos;
@@ -14,35 +22,65 @@ out VS_OUT {
     mat3 TBN;
 } vs_out;
 
-uniform mat4 projection;
-uniform mat4 view;
-uniform mat4 model;
+// 공유 uniform 블록 (UniformBlocks::FrameData / DrawData와 같은 레이아웃)
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;            // xyz
+    vec4 lightPositions[4];  // xyz
+    vec4 lightColors[4];     // xyz
+    int numLights;
+};
+
+layout (std140) uniform DrawData {
+    mat4 model;
+    mat3 normalMatrix;       // transpose(inverse(mat3(model))), CPU에서 계산
+};
+
+// 메시 AABB 기준 위치 복원 (VertexFormat::pack)
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
 
-uniform vec3 viewPos;
-uniform bool useTangentSpace;
+vec3 decodeOctahedral(vec2 e)
+{
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float fold = max(-v.z, 0.0);
+    v.xy += vec2(v.x >= 0.0 ? -fold : fold, v.y >= 0.0 ? -fold : fold);
+    return normalize(v);
+}
 
 void main()
 {
-    vs_out.FragPos = vec3(model * vec4(aPos, 1.0));
-    // Normal matrix for world-space normal
-    mat3 normalMatrix = transpose(inverse(mat3(model)));
-    vs_out.Normal = normalize(normalMatrix * aNormal);
+#ifdef USE_INSTANCING
+    mat4 modelMatrix = aInstanceModel;
+    mat3 normalTransform = aInstanceNormalMatrix;
+    InstanceMaterial = aInstanceMaterial;
+#else
+    mat4 modelMatrix = model;
+    mat3 normalTransform = normalMatrix;
+#endif
+    vec3 position = aPos.xyz * positionScale + positionOffset;
+    vec3 normal = decodeOctahedral(aNormal);
+    
+    vs_out.FragPos = vec3(modelMatrix * vec4(position, 1.0));
+    vs_out.Normal = normalize(normalTransform * normal);
     vs_out.TexCoords = aTexCoords;
     
-    if (useTangentSpace) {
-        vec3 T = normalize(normalMatrix * aTangent);
-        vec3 N = normalize(normalMatrix * aNormal);
-        T = normalize(T - dot(T, N) * N);
-        vec3 B = cross(N, T);
-        
-        vs_out.TBN = transpose(mat3(T, B, N));
-        vs_out.TangentViewPos  = vs_out.TBN * viewPos;
-        vs_out.TangentFragPos  = vs_out.TBN * vs_out.FragPos;
-    } else {
-        vs_out.TBN = mat3(1.0);
-        vs_out.TangentViewPos = vec3(0.0);
-        vs_out.TangentFragPos = vec3(0.0);
-    }
+#ifdef USE_TANGENT_SPACE
+    vec3 T = normalize(normalTransform * decodeOctahedral(aTangent));
+    vec3 N = normalize(normalTransform * normal);
+    T = normalize(T - dot(T, N) * N);
+    // 미러링된 UV는 부호로 바이탄젠트 방향을 뒤집음
+    vec3 B = cross(N, T) * aPos.w;
+    
+    vs_out.TBN = transpose(mat3(T, B, N));
+    vs_out.TangentViewPos  = vs_out.TBN * viewPos.xyz;
+    vs_out.TangentFragPos  = vs_out.TBN * vs_out.FragPos;
+#else
+    vs_out.TBN = mat3(1.0);
+    vs_out.TangentViewPos = vec3(0.0);
+    vs_out.TangentFragPos = vec3(0.0);
+#endif
     
     gl_Position = projection * view * vec4(vs_out.FragPos, 1.0);
 }
@@ -0,0 +1,154 @@
+#include "../include/asset_manager.h"
+#include <filesystem>
+#include <glad/glad.h>
+
+AssetManager& AssetManager::instance()
+{
+    static AssetManager manager;
+    return manager;
+}
+
+std::string AssetManager::canonicalKey(const std::string& file, const std::string& directory)
+{
+    std::filesystem::path path = (directory.empty() || directory == ".")
+        ? std::filesystem::path(file)
+        : std::filesystem::path(directory) / file;
+    
+    std::error_code error;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+    if (error)
+        canonical = path.lexically_normal();
+    return canonical.generic_string();
+}
+
+TextureHandle AssetManager::requestTexture(const std::string& file, const std::string& directory, TextureUsage usage)
+{
+    std::string key = canonicalKey(file, directory) + "#" + std::to_string(static_cast<int>(usage));
+    TextureHandle handle = textures.acquire(key);
+    if (handle.isValid())
+        return handle;
+    
+    TextureAsset asset;
+    asset.pending = true;
+    handle = textures.insert(key, std::move(asset));
+    textures.addRef(handle); // 디코딩 작업이 잡는 참조
+    pendingTextures.emplace_back(handle, textureLoader.request(file, directory, usage));
+    return handle;
+}
+
+TextureHandle AssetManager::requestPackedTexture(const std::array<std::string, 3>& files, const std::array<int, 3>& channels,
+                                                 const std::string& directory)
+{
+    std::string key = "packed";
+    for (int c = 0; c < 3; c++)
+        key += "|" + (files[c].empty() ? std::string() : canonicalKey(files[c], directory) + "#" + std::to_string(channels[c]));
+    TextureHandle handle = textures.acquire(key);
+    if (handle.isValid())
+        return handle;
+    
+    TextureAsset asset;
+    asset.pending = true;
+    handle = textures.insert(key, std::move(asset));
+    textures.addRef(handle); // 디코딩 작업이 잡는 참조
+    pendingTextures.emplace_back(handle, textureLoader.requestPacked(files, channels, directory));
+    return handle;
+}
+
+void AssetManager::resolvePendingTextures()
+{
+    if (pendingTextures.empty())
+        return;
+    
+    textureLoader.resolve();
+    
+    std::vector<std::pair<TextureHandle, size_t>> resolved;
+    resolved.swap(pendingTextures);
+    for (const auto& [handle, ticket] : resolved)
+    {
+        if (TextureAsset* asset = textures.get(handle))
+        {
+            // 로더가 만든 텍스처의 소유권을 넘겨받음
+            asset->texture.reset(textureLoader.textureId(ticket));
+            asset->packedChannels = textureLoader.packedChannels(ticket);
+            asset->pending = false;
+        }
+        release(handle);
+    }
+    textureLoader.clear();
+}
+
+void AssetManager::update()
+{
+    textureLoader.uploads().update();
+}
+
+void AssetManager::releaseGL()
+{
+    textureLoader.uploads().releaseGL();
+    geometryArena.releaseGL();
+    // 아직 참조가 남은 텍스처도 컨텍스트가 살아 있을 때 삭제 (이후 소멸자는 아무것도 하지 않음)
+    textures.forEach([](TextureHandle, TextureAsset& asset) { asset.texture.reset(); });
+}
+
+unsigned int AssetManager::textureId(TextureHandle handle) const
+{
+    const TextureAsset* asset = textures.get(handle);
+    return asset ? asset->texture.get() : 0;
+}
+
+unsigned int AssetManager::packedChannels(TextureHandle handle) const
+{
+    const TextureAsset* asset = textures.get(handle);
+    return asset ? asset->packedChannels : 0;
+}
+
+void AssetManager::retain(TextureHandle handle)
+{
+    textures.addRef(handle);
+}
+
+void AssetManager::release(TextureHandle handle)
+{
+    TextureAsset released;
+    if (textures.release(handle, released) && released.texture)
+    {
+        // 남은 업로드를 버린 뒤 released가 범위를 벗어나며 텍스처 삭제
+        textureLoader.uploads().cancel(released.texture.get());
+    }
+}
+
+MeshHandle AssetManager::acquireMeshes(const std::string& key)
+{
+    return meshGroups.acquire(key);
+}
+
+MeshHandle AssetManager::registerMeshes(const std::string& key, std::vector<Mesh> meshes)
+{
+    return meshGroups.insert(key, std::move(meshes));
+}
+
+std::vector<Mesh>& AssetManager::meshes(MeshHandle handle)
+{
+    static std::vector<Mesh> empty;
+    std::vector<Mesh>* group = meshGroups.get(handle);
+    return group ? *group : empty;
+}
+
+void AssetManager::retain(MeshHandle handle)
+{
+    meshGroups.addRef(handle);
+}
+
+void AssetManager::release(MeshHandle handle)
+{
+    std::vector<Mesh> released;
+    if (!meshGroups.release(handle, released))
+        return;
+    
+    for (Mesh& mesh : released)
+    {
+        for (const Texture& texture : mesh.textures)
+            release(texture.handle);
+        mesh.releaseGL();
+    }
+}
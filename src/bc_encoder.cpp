@@ -0,0 +1,253 @@
+#include "../include/bc_encoder.h"
+#include "../include/gl_capabilities.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// 4x4 블록의 텍셀 (가장자리 블록은 경계 픽셀 복제)
+struct BlockTexels {
+    float rgb[16][3];
+    unsigned char channel[4][16];
+};
+
+void fetchBlock(const unsigned char* pixels, int width, int height, int channels, int blockX, int blockY, BlockTexels& block)
+{
+    for (int y = 0; y < 4; y++)
+    {
+        int sy = std::min(blockY * 4 + y, height - 1);
+        for (int x = 0; x < 4; x++)
+        {
+            int sx = std::min(blockX * 4 + x, width - 1);
+            const unsigned char* texel = pixels + (static_cast<size_t>(sy) * width + sx) * channels;
+            int i = y * 4 + x;
+            // 1채널은 회색조, 2채널은 회색조 + 알파 (stb_image 규칙)
+            unsigned char r = texel[0];
+            unsigned char g = channels >= 3 ? texel[1] : texel[0];
+            unsigned char b = channels >= 3 ? texel[2] : texel[0];
+            unsigned char a = channels == 4 ? texel[3] : (channels == 2 ? texel[1] : 255);
+            block.channel[0][i] = r;
+            block.channel[1][i] = channels == 2 ? texel[1] : g;
+            block.channel[2][i] = b;
+            block.channel[3][i] = a;
+            block.rgb[i][0] = r;
+            block.rgb[i][1] = g;
+            block.rgb[i][2] = b;
+        }
+    }
+}
+
+uint16_t packRGB565(const float color[3])
+{
+    int r = static_cast<int>(std::lround(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f));
+    int g = static_cast<int>(std::lround(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f));
+    int b = static_cast<int>(std::lround(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void unpackRGB565(uint16_t packed, float color[3])
+{
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+    color[0] = static_cast<float>((r << 3) | (r >> 2));
+    color[1] = static_cast<float>((g << 2) | (g >> 4));
+    color[2] = static_cast<float>((b << 3) | (b >> 2));
+}
+
+// 주성분 축 위의 양 끝점으로 엔드포인트를 잡는 BC1 컬러 블록 (항상 4색 모드)
+void encodeColorBlock(const BlockTexels& block, unsigned char* out)
+{
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 16; i++)
+        for (int c = 0; c < 3; c++)
+            mean[c] += block.rgb[i][c] / 16.0f;
+    
+    float cov[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 16; i++)
+    {
+        float d[3] = {block.rgb[i][0] - mean[0], block.rgb[i][1] - mean[1], block.rgb[i][2] - mean[2]};
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+    }
+    
+    // 거듭제곱법으로 공분산 행렬의 주축 근사
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+    for (int iteration = 0; iteration < 4; iteration++)
+    {
+        float next[3] = {
+            cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+            cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+            cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]
+        };
+        float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+        if (length < 1e-6f)
+            break;
+        for (int c = 0; c < 3; c++)
+            axis[c] = next[c] / length;
+    }
+    
+    float minT = 0.0f, maxT = 0.0f;
+    for (int i = 0; i < 16; i++)
+    {
+        float t = (block.rgb[i][0] - mean[0]) * axis[0] + (block.rgb[i][1] - mean[1]) * axis[1] +
+                  (block.rgb[i][2] - mean[2]) * axis[2];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    // 양 끝을 1/16만큼 안쪽으로 당겨 양자화 오차를 줄임
+    float inset = (maxT - minT) / 16.0f;
+    minT += inset;
+    maxT -= inset;
+    
+    float endpoint0[3], endpoint1[3];
+    for (int c = 0; c < 3; c++)
+    {
+        endpoint0[c] = mean[c] + axis[c] * maxT;
+        endpoint1[c] = mean[c] + axis[c] * minT;
+    }
+    
+    uint16_t color0 = packRGB565(endpoint0);
+    uint16_t color1 = packRGB565(endpoint1);
+    if (color0 < color1)
+        std::swap(color0, color1);
+    
+    float palette[4][3];
+    unpackRGB565(color0, palette[0]);
+    unpackRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; c++)
+    {
+        palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+        palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+    }
+    
+    uint32_t indices = 0;
+    if (color0 != color1)
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            float bestError = 1e30f;
+            for (int p = 0; p < 4; p++)
+            {
+                float dr = block.rgb[i][0] - palette[p][0];
+                float dg = block.rgb[i][1] - palette[p][1];
+                float db = block.rgb[i][2] - palette[p][2];
+                float error = dr * dr + dg * dg + db * db;
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (2 * i);
+        }
+    }
+    
+    std::memcpy(out, &color0, 2);
+    std::memcpy(out + 2, &color1, 2);
+    std::memcpy(out + 4, &indices, 4);
+}
+
+// BC4 단일 채널 블록 (8단계 보간 모드)
+void encodeScalarBlock(const unsigned char values[16], unsigned char* out)
+{
+    int maxValue = 0, minValue = 255;
+    for (int i = 0; i < 16; i++)
+    {
+        maxValue = std::max(maxValue, static_cast<int>(values[i]));
+        minValue = std::min(minValue, static_cast<int>(values[i]));
+    }
+    
+    out[0] = static_cast<unsigned char>(maxValue);
+    out[1] = static_cast<unsigned char>(minValue);
+    
+    uint64_t indices = 0;
+    if (maxValue != minValue)
+    {
+        int palette[8];
+        palette[0] = maxValue;
+        palette[1] = minValue;
+        for (int p = 1; p < 7; p++)
+            palette[p + 1] = ((7 - p) * maxValue + p * minValue + 3) / 7;
+        
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            int bestError = 256;
+            for (int p = 0; p < 8; p++)
+            {
+                int error = std::abs(values[i] - palette[p]);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+    
+    for (int b = 0; b < 6; b++)
+        out[2 + b] = static_cast<unsigned char>(indices >> (8 * b));
+}
+
+} // namespace
+
+namespace BCEncoder {
+
+std::vector<unsigned char> compress(const unsigned char* pixels, int width, int height, int channels,
+                                    unsigned int internalFormat)
+{
+    size_t blockBytes;
+    switch (internalFormat)
+    {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RED_RGTC1:
+            blockBytes = 8;
+            break;
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RG_RGTC2:
+            blockBytes = 16;
+            break;
+        default:
+            return {};
+    }
+    
+    int blocksX = std::max(1, (width + 3) / 4);
+    int blocksY = std::max(1, (height + 3) / 4);
+    std::vector<unsigned char> output(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+    
+    BlockTexels block;
+    unsigned char* out = output.data();
+    for (int by = 0; by < blocksY; by++)
+    {
+        for (int bx = 0; bx < blocksX; bx++, out += blockBytes)
+        {
+            fetchBlock(pixels, width, height, channels, bx, by, block);
+            switch (internalFormat)
+            {
+                case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+                    encodeColorBlock(block, out);
+                    break;
+                case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+                    encodeScalarBlock(block.channel[3], out);
+                    encodeColorBlock(block, out + 8);
+                    break;
+                case GL_COMPRESSED_RED_RGTC1:
+                    encodeScalarBlock(block.channel[0], out);
+                    break;
+                case GL_COMPRESSED_RG_RGTC2:
+                    encodeScalarBlock(block.channel[0], out);
+                    encodeScalarBlock(block.channel[1], out + 8);
+                    break;
+            }
+        }
+    }
+    return output;
+}
+
+} // namespace BCEncoder
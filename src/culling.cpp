@@ -0,0 +1,252 @@
+#include "../include/culling.h"
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+
+#if defined(__AVX__)
+#define CULLING_AVX 1
+#include <immintrin.h>
+#endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define CULLING_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace {
+
+// 평면을 SIMD 레인에 나눠 싣기 위한 성분별 값 (|n|은 반 크기 투영용)
+struct PlaneLanes {
+    float nx, ny, nz, w;
+    float ax, ay, az;
+};
+
+void planeLanes(const Frustum& frustum, PlaneLanes* lanes)
+{
+    for (int p = 0; p < 6; p++)
+    {
+        const glm::vec4& plane = frustum.planes[p];
+        lanes[p] = { plane.x, plane.y, plane.z, plane.w, std::fabs(plane.x), std::fabs(plane.y), std::fabs(plane.z) };
+    }
+}
+
+} // namespace
+
+Aabb Aabb::fromMinMax(const glm::vec3& minimum, const glm::vec3& maximum)
+{
+    Aabb box;
+    box.center = (minimum + maximum) * 0.5f;
+    box.extent = (maximum - minimum) * 0.5f;
+    return box;
+}
+
+Aabb Aabb::merged(const Aabb& other) const
+{
+    return fromMinMax(glm::min(minimum(), other.minimum()), glm::max(maximum(), other.maximum()));
+}
+
+Aabb Aabb::transformed(const glm::mat4& matrix) const
+{
+    Aabb box;
+    box.center = glm::vec3(matrix * glm::vec4(center, 1.0f));
+    for (int row = 0; row < 3; row++)
+    {
+        box.extent[row] = std::fabs(matrix[0][row]) * extent.x +
+                          std::fabs(matrix[1][row]) * extent.y +
+                          std::fabs(matrix[2][row]) * extent.z;
+    }
+    return box;
+}
+
+Culling::Result Culling::classify(const Frustum& frustum, const Aabb& box)
+{
+    Result result = INSIDE;
+    for (const glm::vec4& plane : frustum.planes)
+    {
+        glm::vec3 normal(plane.x, plane.y, plane.z);
+        // 중심의 부호 거리와 반 크기를 법선에 투영한 길이 (평면이 정규화되지 않아도 둘 다 같은 배율)
+        float distance = glm::dot(normal, box.center) + plane.w;
+        float radius = glm::dot(glm::abs(normal), box.extent);
+        if (distance + radius < 0.0f)
+            return OUTSIDE;
+        if (distance - radius < 0.0f)
+            result = INTERSECTS;
+    }
+    return result;
+}
+
+void BoundsSoA::clear()
+{
+    for (std::vector<float>* column : { &centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ })
+        column->clear();
+}
+
+void BoundsSoA::reserve(size_t count)
+{
+    for (std::vector<float>* column : { &centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ })
+        column->reserve(count);
+}
+
+void BoundsSoA::push(const Aabb& box)
+{
+    centerX.push_back(box.center.x);
+    centerY.push_back(box.center.y);
+    centerZ.push_back(box.center.z);
+    extentX.push_back(box.extent.x);
+    extentY.push_back(box.extent.y);
+    extentZ.push_back(box.extent.z);
+}
+
+void BoundsSoA::cull(const Frustum& frustum, size_t first, size_t count, uint8_t* visible) const
+{
+    PlaneLanes planes[6];
+    planeLanes(frustum, planes);
+    const float* cx = centerX.data() + first;
+    const float* cy = centerY.data() + first;
+    const float* cz = centerZ.data() + first;
+    const float* ex = extentX.data() + first;
+    const float* ey = extentY.data() + first;
+    const float* ez = extentZ.data() + first;
+    
+    // 박스가 평면 뒤에 완전히 있으면 n·c + w + |n|·e < 0
+    size_t i = 0;
+#ifdef CULLING_AVX
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(cx + i), y = _mm256_loadu_ps(cy + i), z = _mm256_loadu_ps(cz + i);
+        __m256 sx = _mm256_loadu_ps(ex + i), sy = _mm256_loadu_ps(ey + i), sz = _mm256_loadu_ps(ez + i);
+        __m256 outside = _mm256_setzero_ps();
+        for (const PlaneLanes& p : planes)
+        {
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.nx), x), _mm256_mul_ps(_mm256_set1_ps(p.ny), y)),
+                                     _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.nz), z), _mm256_set1_ps(p.w)));
+            __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.ax), sx), _mm256_mul_ps(_mm256_set1_ps(p.ay), sy)),
+                                     _mm256_mul_ps(_mm256_set1_ps(p.az), sz));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        int mask = _mm256_movemask_ps(outside);
+        for (int lane = 0; lane < 8; lane++)
+            visible[i + lane] = (mask >> lane) & 1 ? 0 : 1;
+    }
+#endif
+#ifdef CULLING_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i), z = _mm_loadu_ps(cz + i);
+        __m128 sx = _mm_loadu_ps(ex + i), sy = _mm_loadu_ps(ey + i), sz = _mm_loadu_ps(ez + i);
+        __m128 outside = _mm_setzero_ps();
+        for (const PlaneLanes& p : planes)
+        {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.nx), x), _mm_mul_ps(_mm_set1_ps(p.ny), y)),
+                                  _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.nz), z), _mm_set1_ps(p.w)));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.ax), sx), _mm_mul_ps(_mm_set1_ps(p.ay), sy)),
+                                  _mm_mul_ps(_mm_set1_ps(p.az), sz));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+        }
+        int mask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; lane++)
+            visible[i + lane] = (mask >> lane) & 1 ? 0 : 1;
+    }
+#endif
+    for (; i < count; i++)
+    {
+        bool outside = false;
+        for (const PlaneLanes& p : planes)
+        {
+            float d = p.nx * cx[i] + p.ny * cy[i] + p.nz * cz[i] + p.w;
+            float r = p.ax * ex[i] + p.ay * ey[i] + p.az * ez[i];
+            outside = outside || d + r < 0.0f;
+        }
+        visible[i] = outside ? 0 : 1;
+    }
+}
+
+void BoundsBvh::build(const std::vector<Aabb>& boxes)
+{
+    nodes.clear();
+    items.resize(boxes.size());
+    for (size_t i = 0; i < boxes.size(); i++)
+        items[i] = static_cast<uint32_t>(i);
+    if (!boxes.empty())
+    {
+        // 리프 하나에 LEAF_SIZE개 이하이므로 노드 수는 2n / LEAF_SIZE 정도
+        nodes.reserve(2 * (boxes.size() / LEAF_SIZE + 1));
+        buildNode(boxes, 0, static_cast<uint32_t>(boxes.size()));
+    }
+    
+    itemBounds.clear();
+    itemBounds.reserve(items.size());
+    for (uint32_t item : items)
+        itemBounds.push(boxes[item]);
+}
+
+uint32_t BoundsBvh::buildNode(const std::vector<Aabb>& boxes, uint32_t first, uint32_t count)
+{
+    uint32_t index = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    
+    Aabb bounds = boxes[items[first]];
+    glm::vec3 centerMin = bounds.center, centerMax = bounds.center;
+    for (uint32_t i = first + 1; i < first + count; i++)
+    {
+        const Aabb& box = boxes[items[i]];
+        bounds = bounds.merged(box);
+        centerMin = glm::min(centerMin, box.center);
+        centerMax = glm::max(centerMax, box.center);
+    }
+    nodes[index].bounds = bounds;
+    nodes[index].first = first;
+    nodes[index].count = count;
+    nodes[index].secondChild = 0;
+    if (count <= LEAF_SIZE)
+        return index;
+    
+    // 중심이 가장 넓게 퍼진 축의 중앙값으로 반씩 나눔
+    glm::vec3 spread = centerMax - centerMin;
+    int axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+    uint32_t half = count / 2;
+    std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+                     [&boxes, axis](uint32_t a, uint32_t b) { return boxes[a].center[axis] < boxes[b].center[axis]; });
+    
+    buildNode(boxes, first, half);
+    uint32_t second = buildNode(boxes, first + half, count - half);
+    // nodes가 재할당될 수 있으므로 인덱스로 다시 접근
+    nodes[index].secondChild = second;
+    return index;
+}
+
+void BoundsBvh::cull(const Frustum& frustum, std::vector<uint32_t>& visible) const
+{
+    if (nodes.empty())
+        return;
+    
+    // 깊이는 log2(n / LEAF_SIZE) 정도이므로 고정 스택으로 충분
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        uint32_t index = stack[--top];
+        const Node& node = nodes[index];
+        Culling::Result result = Culling::classify(frustum, node.bounds);
+        if (result == Culling::OUTSIDE)
+            continue;
+        if (result == Culling::INSIDE)
+        {
+            visible.insert(visible.end(), items.begin() + node.first, items.begin() + node.first + node.count);
+            continue;
+        }
+        if (node.secondChild == 0)
+        {
+            leafVisible.resize(node.count);
+            itemBounds.cull(frustum, node.first, node.count, leafVisible.data());
+            for (uint32_t i = 0; i < node.count; i++)
+            {
+                if (leafVisible[i])
+                    visible.push_back(items[node.first + i]);
+            }
+            continue;
+        }
+        stack[top++] = node.secondChild;
+        stack[top++] = index + 1;
+    }
+}
@@ -0,0 +1,29 @@
+#include "../include/frustum.h"
+
+Frustum Frustum::fromMatrix(const glm::mat4& matrix)
+{
+    // glm은 열 우선이므로 i번째 행은 (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&](int i) { return glm::vec4(matrix[0][i], matrix[1][i], matrix[2][i], matrix[3][i]); };
+    glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+    
+    Frustum frustum;
+    frustum.planes[0] = r3 + r0; // left
+    frustum.planes[1] = r3 - r0; // right
+    frustum.planes[2] = r3 + r1; // bottom
+    frustum.planes[3] = r3 - r1; // top
+    frustum.planes[4] = r3 + r2; // near
+    frustum.planes[5] = r3 - r2; // far
+    return frustum;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const
+{
+    for (const glm::vec4& plane : planes)
+    {
+        glm::vec3 normal(plane.x, plane.y, plane.z);
+        // 평면이 정규화되어 있지 않으므로 반지름에 법선 길이를 곱해 비교
+        if (glm::dot(normal, center) + plane.w < -radius * glm::length(normal))
+            return false;
+    }
+    return true;
+}
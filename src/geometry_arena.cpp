@@ -0,0 +1,258 @@
+#include "../include/geometry_arena.h"
+#include "../include/vertex_format.h"
+#include "../include/gl_state.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+constexpr size_t INDEX_WORD = 4;
+
+size_t layoutStride(unsigned int layout)
+{
+    return layout == GeometryArena::LAYOUT_QUANTIZED ? sizeof(PackedVertex) : sizeof(PackedVertexFloat);
+}
+
+// 새 버퍼를 만들고 기존 내용을 GPU 안에서 복사 (COPY 타깃을 써서 VAO 상태는 건드리지 않음)
+// (기존 버퍼는 반환값을 대입할 때 삭제됨)
+GLBuffer reallocateBuffer(const GLBuffer& oldBuffer, size_t oldBytes, size_t newBytes)
+{
+    GLBuffer buffer = GLBuffer::create();
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.get());
+    glBufferData(GL_COPY_WRITE_BUFFER, newBytes, nullptr, GL_STATIC_DRAW);
+    if (oldBuffer)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer.get());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldBytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return buffer;
+}
+
+} // namespace
+
+RangeAllocator::RangeAllocator(size_t capacity)
+{
+    grow(capacity);
+}
+
+size_t RangeAllocator::allocate(size_t size)
+{
+    if (size == 0)
+        return INVALID_OFFSET;
+    
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+    {
+        if (it->second < size)
+            continue;
+        
+        size_t offset = it->first;
+        size_t remaining = it->second - size;
+        freeRanges.erase(it);
+        if (remaining > 0)
+            freeRanges[offset + size] = remaining;
+        used += size;
+        return offset;
+    }
+    return INVALID_OFFSET;
+}
+
+void RangeAllocator::free(size_t offset, size_t size)
+{
+    if (size == 0)
+        return;
+    
+    used -= size;
+    auto next = freeRanges.lower_bound(offset);
+    // 뒤쪽 빈 구간과 합침
+    if (next != freeRanges.end() && offset + size == next->first)
+    {
+        size += next->second;
+        next = freeRanges.erase(next);
+    }
+    // 앞쪽 빈 구간과 합침
+    if (next != freeRanges.begin())
+    {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset)
+        {
+            previous->second += size;
+            return;
+        }
+    }
+    freeRanges[offset] = size;
+}
+
+void RangeAllocator::grow(size_t newCapacity)
+{
+    if (newCapacity <= totalSize)
+        return;
+    
+    size_t added = newCapacity - totalSize;
+    size_t offset = totalSize;
+    totalSize = newCapacity;
+    // free()의 병합을 그대로 사용 (used는 free에서 다시 빠지므로 미리 더해 둠)
+    used += added;
+    free(offset, added);
+}
+
+GeometryArenaSettings& GeometryArena::settings()
+{
+    static GeometryArenaSettings instance;
+    return instance;
+}
+
+void GeometryArena::createPool(unsigned int layout)
+{
+    Pool& pool = pools[layout];
+    pool.stride = layoutStride(layout);
+    pool.vertices = RangeAllocator(std::max<size_t>(settings().initialVertexBytes / pool.stride, 1));
+    pool.indices = RangeAllocator(std::max<size_t>(settings().initialIndexBytes / INDEX_WORD, 1));
+    pool.VBO = reallocateBuffer(GLBuffer(), 0, pool.vertices.capacity() * pool.stride);
+    pool.EBO = reallocateBuffer(GLBuffer(), 0, pool.indices.capacity() * INDEX_WORD);
+    
+    pool.VAO = GLVertexArray::create();
+    GLState::instance().bindVertexArray(pool.VAO.get());
+    glBindBuffer(GL_ARRAY_BUFFER, pool.VBO.get());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.EBO.get());
+    VertexFormat::setupAttributes(layout == LAYOUT_QUANTIZED);
+    GLState::instance().bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::growVertices(Pool& pool, unsigned int layout, size_t minimumCount)
+{
+    size_t oldCapacity = pool.vertices.capacity();
+    size_t newCapacity = std::max(oldCapacity * 2, oldCapacity + minimumCount);
+    pool.VBO = reallocateBuffer(pool.VBO, oldCapacity * pool.stride, newCapacity * pool.stride);
+    pool.vertices.grow(newCapacity);
+    
+    // 속성 포인터는 설정 시점의 VBO를 가리키므로 다시 설정
+    GLState::instance().bindVertexArray(pool.VAO.get());
+    glBindBuffer(GL_ARRAY_BUFFER, pool.VBO.get());
+    VertexFormat::setupAttributes(layout == LAYOUT_QUANTIZED);
+    GLState::instance().bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::growIndices(Pool& pool, size_t minimumWords)
+{
+    size_t oldCapacity = pool.indices.capacity();
+    size_t newCapacity = std::max(oldCapacity * 2, oldCapacity + minimumWords);
+    pool.EBO = reallocateBuffer(pool.EBO, oldCapacity * INDEX_WORD, newCapacity * INDEX_WORD);
+    pool.indices.grow(newCapacity);
+    
+    GLState::instance().bindVertexArray(pool.VAO.get());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.EBO.get());
+    GLState::instance().bindVertexArray(0);
+}
+
+GeometryAllocation GeometryArena::upload(const PackedMesh& packed)
+{
+    GeometryAllocation allocation;
+    unsigned int layout = packed.quantizedPositions ? LAYOUT_QUANTIZED : LAYOUT_FLOAT;
+    Pool& pool = pools[layout];
+    size_t vertexCount = packed.vertexData.size() / layoutStride(layout);
+    size_t indexWords = (packed.indexData.size() + INDEX_WORD - 1) / INDEX_WORD;
+    if (vertexCount == 0 || indexWords == 0)
+        return allocation;
+    
+    if (!pool.VAO)
+        createPool(layout);
+    
+    size_t firstVertex = pool.vertices.allocate(vertexCount);
+    if (firstVertex == RangeAllocator::INVALID_OFFSET)
+    {
+        growVertices(pool, layout, vertexCount);
+        firstVertex = pool.vertices.allocate(vertexCount);
+    }
+    size_t firstWord = pool.indices.allocate(indexWords);
+    if (firstWord == RangeAllocator::INVALID_OFFSET)
+    {
+        growIndices(pool, indexWords);
+        firstWord = pool.indices.allocate(indexWords);
+    }
+    if (firstVertex == RangeAllocator::INVALID_OFFSET || firstWord == RangeAllocator::INVALID_OFFSET)
+    {
+        std::cout << "ERROR::GEOMETRY_ARENA::Failed to allocate " << vertexCount << " vertices" << std::endl;
+        if (firstVertex != RangeAllocator::INVALID_OFFSET)
+            pool.vertices.free(firstVertex, vertexCount);
+        if (firstWord != RangeAllocator::INVALID_OFFSET)
+            pool.indices.free(firstWord, indexWords);
+        return allocation;
+    }
+    
+    allocation.layout = layout;
+    allocation.firstVertex = firstVertex;
+    allocation.vertexCount = vertexCount;
+    allocation.indexOffset = firstWord * INDEX_WORD;
+    allocation.indexBytes = indexWords * INDEX_WORD;
+    
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.VBO.get());
+    glBufferSubData(GL_COPY_WRITE_BUFFER, firstVertex * pool.stride, packed.vertexData.size(), packed.vertexData.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.EBO.get());
+    glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.indexOffset, packed.indexData.size(), packed.indexData.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return allocation;
+}
+
+void GeometryArena::free(const GeometryAllocation& allocation)
+{
+    if (!allocation.isValid() || allocation.layout >= LAYOUT_COUNT)
+        return;
+    
+    Pool& pool = pools[allocation.layout];
+    if (!pool.VAO)
+        return;
+    pool.vertices.free(allocation.firstVertex, allocation.vertexCount);
+    pool.indices.free(allocation.indexOffset / INDEX_WORD, allocation.indexBytes / INDEX_WORD);
+}
+
+void GeometryArena::bind(unsigned int layout)
+{
+    GLState::instance().bindVertexArray(pools[layout].VAO.get());
+}
+
+void GeometryArena::bindInstances(unsigned int layout, GLuint buffer, size_t byteOffset)
+{
+    bind(layout);
+    Pool& pool = pools[layout];
+    if (pool.instanceBuffer == buffer && pool.instanceOffset == byteOffset)
+        return;
+    // GL 3.3에는 baseInstance가 없으므로 속성 포인터의 오프셋으로 구간 시작을 지정
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    VertexFormat::setupInstanceAttributes(byteOffset);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    pool.instanceBuffer = buffer;
+    pool.instanceOffset = byteOffset;
+}
+
+void GeometryArena::unbind()
+{
+    GLState::instance().bindVertexArray(0);
+}
+
+void GeometryArena::releaseGL()
+{
+    // 핸들이 VAO/VBO/EBO를 삭제
+    for (Pool& pool : pools)
+        pool = Pool();
+}
+
+size_t GeometryArena::vertexBytesUsed() const
+{
+    size_t bytes = 0;
+    for (const Pool& pool : pools)
+        bytes += pool.vertices.usedSize() * pool.stride;
+    return bytes;
+}
+
+size_t GeometryArena::indexBytesUsed() const
+{
+    size_t bytes = 0;
+    for (const Pool& pool : pools)
+        bytes += pool.indices.usedSize() * INDEX_WORD;
+    return bytes;
+}
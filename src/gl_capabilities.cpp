@@ -0,0 +1,91 @@
+#include "../include/gl_capabilities.h"
+#include <glad/glad.h>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+GLCapabilities& mutableCapabilities()
+{
+    static GLCapabilities capabilities;
+    return capabilities;
+}
+
+std::string glString(GLenum name)
+{
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+} // namespace
+
+const GLCapabilities& GLCapabilities::get()
+{
+    return mutableCapabilities();
+}
+
+void GLCapabilities::detect(GLADloadproc loader)
+{
+    GLCapabilities& caps = mutableCapabilities();
+    caps.vendor = glString(GL_VENDOR);
+    caps.renderer = glString(GL_RENDERER);
+    caps.version = glString(GL_VERSION);
+    
+    GLint majorVersion = 0;
+    GLint minorVersion = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+    bool programBinaryExtension = majorVersion > 4 || (majorVersion == 4 && minorVersion >= 1);
+    
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; i++)
+    {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (!name)
+            continue;
+        if (std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0)
+            caps.textureCompressionS3TC = true;
+        else if (std::strcmp(name, "GL_ARB_texture_compression_bptc") == 0)
+            caps.textureCompressionBPTC = true;
+        else if (std::strcmp(name, "GL_ARB_get_program_binary") == 0)
+            programBinaryExtension = true;
+    }
+    
+    if (programBinaryExtension && loader)
+    {
+        caps.getProgramBinary = reinterpret_cast<decltype(caps.getProgramBinary)>(loader("glGetProgramBinary"));
+        caps.programBinaryUpload = reinterpret_cast<decltype(caps.programBinaryUpload)>(loader("glProgramBinary"));
+        caps.programParameteri = reinterpret_cast<decltype(caps.programParameteri)>(loader("glProgramParameteri"));
+        // 확장이 있어도 바이너리 포맷이 0개인 드라이버가 있음 (저장해도 다시 읽을 수 없음)
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        caps.programBinary = caps.getProgramBinary && caps.programBinaryUpload && caps.programParameteri &&
+                             formatCount > 0;
+    }
+    
+    std::cout << "GL: " << caps.renderer << " (" << caps.version << ")" << std::endl;
+    std::cout << "  BC1-3 (S3TC): " << (caps.textureCompressionS3TC ? "yes" : "no")
+              << ", BC4/5 (RGTC): yes"
+              << ", BC7 (BPTC): " << (caps.textureCompressionBPTC ? "yes" : "no") << std::endl;
+    std::cout << "  Program binary: " << (caps.programBinary ? "yes" : "no") << std::endl;
+}
+
+bool GLCapabilities::supportsCompressedFormat(unsigned int internalFormat) const
+{
+    switch (internalFormat)
+    {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            return textureCompressionS3TC;
+        case GL_COMPRESSED_RED_RGTC1:
+        case GL_COMPRESSED_RG_RGTC2:
+            return textureCompressionRGTC;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+            return textureCompressionBPTC;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,106 @@
+#include "../include/gl_state.h"
+#include <algorithm>
+#include <iterator>
+
+GLState& GLState::instance()
+{
+    static GLState state;
+    return state;
+}
+
+GLState::GLState()
+{
+    std::fill(std::begin(textures), std::end(textures), UNKNOWN);
+}
+
+void GLState::useProgram(GLuint newProgram)
+{
+    if (program == newProgram)
+    {
+        counters.programs.skipped++;
+        return;
+    }
+    glUseProgram(newProgram);
+    program = newProgram;
+    counters.programs.issued++;
+}
+
+void GLState::bindVertexArray(GLuint newVertexArray)
+{
+    if (vertexArray == newVertexArray)
+    {
+        counters.vertexArrays.skipped++;
+        return;
+    }
+    glBindVertexArray(newVertexArray);
+    vertexArray = newVertexArray;
+    counters.vertexArrays.issued++;
+}
+
+void GLState::activeTexture(GLuint unit)
+{
+    if (activeUnit == unit)
+        return;
+    glActiveTexture(GL_TEXTURE0 + unit);
+    activeUnit = unit;
+}
+
+void GLState::bindTexture(GLuint unit, GLuint texture)
+{
+    // 추적 범위 밖의 유닛은 그대로 전달
+    if (unit >= MAX_TEXTURE_UNITS)
+    {
+        activeTexture(unit);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        counters.textures.issued++;
+        return;
+    }
+    if (textures[unit] == texture)
+    {
+        counters.textures.skipped++;
+        return;
+    }
+    activeTexture(unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    textures[unit] = texture;
+    counters.textures.issued++;
+}
+
+void GLState::countUniform(bool skipped)
+{
+    if (skipped)
+        counters.uniforms.skipped++;
+    else
+        counters.uniforms.issued++;
+}
+
+void GLState::forgetProgram(GLuint deleted)
+{
+    // 사용 중인 프로그램은 삭제 후에도 바인딩이 유지되지만 같은 이름이 다시 나오면 구분할 수 없음
+    if (program == deleted)
+        program = UNKNOWN;
+}
+
+void GLState::forgetVertexArray(GLuint deleted)
+{
+    // 바인딩된 VAO를 지우면 GL이 0으로 되돌림
+    if (vertexArray == deleted)
+        vertexArray = 0;
+}
+
+void GLState::forgetTexture(GLuint deleted)
+{
+    for (GLuint& texture : textures)
+    {
+        if (texture == deleted)
+            texture = 0;
+    }
+}
+
+void GLState::invalidate()
+{
+    program = UNKNOWN;
+    vertexArray = UNKNOWN;
+    activeUnit = UNKNOWN;
+    std::fill(std::begin(textures), std::end(textures), UNKNOWN);
+}
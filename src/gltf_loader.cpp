@@ -0,0 +1,819 @@
+#include "../include/gltf_loader.h"
+#include "../include/hash_util.h"
+#include "../include/json.h"
+#include "../include/mapped_file.h"
+#include "../include/texture_loader.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+constexpr uint32_t GLB_MAGIC = 0x46546C67;      // "glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A; // "JSON"
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;  // "BIN\0"
+constexpr int MAX_NODE_DEPTH = 128;
+
+enum ComponentType {
+    COMPONENT_BYTE = 5120,
+    COMPONENT_UNSIGNED_BYTE = 5121,
+    COMPONENT_SHORT = 5122,
+    COMPONENT_UNSIGNED_SHORT = 5123,
+    COMPONENT_UNSIGNED_INT = 5125,
+    COMPONENT_FLOAT = 5126
+};
+
+enum PrimitiveMode {
+    MODE_TRIANGLES = 4,
+    MODE_TRIANGLE_STRIP = 5,
+    MODE_TRIANGLE_FAN = 6
+};
+
+struct ByteRange {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+};
+
+// 파싱한 문서와 버퍼 저장소 (프리미티브 변환이 끝날 때까지 유지)
+struct Document {
+    std::string directory;
+    std::string fileName;
+    MappedFile file;
+    JsonValue json;
+    ByteRange binChunk;
+    std::vector<std::unique_ptr<MappedFile>> externalFiles;
+    std::vector<std::vector<unsigned char>> decodedUris;
+    std::vector<ByteRange> buffers;
+};
+
+// 매핑된 버퍼 안의 접근자 (data는 첫 원소, 원소 사이 간격은 stride)
+struct Accessor {
+    const unsigned char* data = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    int componentType = 0;
+    int components = 0;
+    bool normalized = false;
+};
+
+// 장면에 놓인 프리미티브 하나와 노드의 월드 변환
+struct Instance {
+    const JsonValue* primitive;
+    unsigned int materialIndex;
+    glm::mat4 transform;
+};
+
+size_t componentSize(int componentType)
+{
+    switch (componentType)
+    {
+        case COMPONENT_BYTE:
+        case COMPONENT_UNSIGNED_BYTE:  return 1;
+        case COMPONENT_SHORT:
+        case COMPONENT_UNSIGNED_SHORT: return 2;
+        case COMPONENT_UNSIGNED_INT:
+        case COMPONENT_FLOAT:          return 4;
+        default:                       return 0;
+    }
+}
+
+int componentCount(const std::string& type)
+{
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    return 0;
+}
+
+bool hasPrefix(const std::string& value, const char* prefix)
+{
+    return value.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+int base64Value(char c)
+{
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+' || c == '-') return 62;
+    if (c == '/' || c == '_') return 63;
+    return -1;
+}
+
+// "data:<mime>;base64,<payload>" 디코딩
+bool decodeDataUri(const std::string& uri, std::vector<unsigned char>& out, std::string* mimeType = nullptr)
+{
+    size_t comma = uri.find(',');
+    size_t marker = uri.find(";base64");
+    if (comma == std::string::npos || marker == std::string::npos || marker > comma)
+        return false;
+    if (mimeType)
+        *mimeType = uri.substr(5, uri.find_first_of(";,", 5) - 5);
+    
+    out.clear();
+    out.reserve((uri.size() - comma) * 3 / 4);
+    uint32_t bits = 0;
+    int bitCount = 0;
+    for (size_t i = comma + 1; i < uri.size(); i++)
+    {
+        int value = base64Value(uri[i]);
+        if (value < 0)
+        {
+            if (uri[i] == '=')
+                break;
+            continue;
+        }
+        bits = (bits << 6) | static_cast<uint32_t>(value);
+        bitCount += 6;
+        if (bitCount >= 8)
+        {
+            bitCount -= 8;
+            out.push_back(static_cast<unsigned char>((bits >> bitCount) & 0xFF));
+        }
+    }
+    return true;
+}
+
+// URI의 %XX 이스케이프 복원 (공백 등이 들어간 파일명)
+std::string decodeUriPath(const std::string& uri)
+{
+    std::string path;
+    path.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); i++)
+    {
+        if (uri[i] == '%' && i + 2 < uri.size())
+        {
+            char hex[3] = { uri[i + 1], uri[i + 2], 0 };
+            char* end = nullptr;
+            long value = std::strtol(hex, &end, 16);
+            if (end == hex + 2)
+            {
+                path.push_back(static_cast<char>(value));
+                i += 2;
+                continue;
+            }
+        }
+        path.push_back(uri[i]);
+    }
+    return path;
+}
+
+bool parseGlb(Document& document)
+{
+    const unsigned char* data = document.file.data();
+    size_t size = document.file.size();
+    uint32_t header[3];
+    if (size < sizeof(header))
+        return false;
+    std::memcpy(header, data, sizeof(header));
+    if (header[0] != GLB_MAGIC || header[1] != 2 || header[2] > size)
+    {
+        std::cout << "ERROR::GLTF::Unsupported GLB header" << std::endl;
+        return false;
+    }
+    
+    // 청크: 길이(4) + 타입(4) + 데이터 (4바이트 정렬). JSON이 먼저, BIN은 선택
+    size_t offset = sizeof(header);
+    bool hasJson = false;
+    while (offset + 8 <= header[2])
+    {
+        uint32_t chunk[2];
+        std::memcpy(chunk, data + offset, sizeof(chunk));
+        offset += sizeof(chunk);
+        if (offset + chunk[0] > header[2])
+            break;
+        
+        if (chunk[1] == GLB_CHUNK_JSON && !hasJson)
+        {
+            std::string error;
+            if (!JsonValue::parse(reinterpret_cast<const char*>(data + offset), chunk[0], document.json, &error))
+            {
+                std::cout << "ERROR::GLTF::Invalid JSON chunk: " << error << std::endl;
+                return false;
+            }
+            hasJson = true;
+        }
+        else if (chunk[1] == GLB_CHUNK_BIN && !document.binChunk.data)
+        {
+            document.binChunk.data = data + offset;
+            document.binChunk.size = chunk[0];
+        }
+        offset += (chunk[0] + 3u) & ~3u;
+    }
+    return hasJson;
+}
+
+// 버퍼마다 매핑된 메모리 구간 준비 (GLB BIN 청크 / 외부 .bin mmap / base64 데이터 URI)
+bool loadBuffers(Document& document)
+{
+    const JsonValue& buffers = document.json.get("buffers");
+    document.buffers.resize(buffers.size());
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        const JsonValue& buffer = buffers.at(i);
+        const std::string& uri = buffer.get("uri").asString();
+        size_t byteLength = static_cast<size_t>(buffer.get("byteLength").asNumber());
+        ByteRange& range = document.buffers[i];
+        
+        if (uri.empty())
+        {
+            // GLB의 첫 버퍼만 URI 없이 BIN 청크를 가리킬 수 있음
+            if (i == 0 && document.binChunk.data)
+                range = document.binChunk;
+        }
+        else if (hasPrefix(uri, "data:"))
+        {
+            document.decodedUris.emplace_back();
+            if (decodeDataUri(uri, document.decodedUris.back()))
+            {
+                range.data = document.decodedUris.back().data();
+                range.size = document.decodedUris.back().size();
+            }
+        }
+        else
+        {
+            auto file = std::make_unique<MappedFile>();
+            if (file->open(document.directory + "/" + decodeUriPath(uri)))
+            {
+                range.data = file->data();
+                range.size = file->size();
+                document.externalFiles.push_back(std::move(file));
+            }
+        }
+        
+        if (!range.data || range.size < byteLength)
+        {
+            std::cout << "ERROR::GLTF::Failed to load buffer " << i << " (" << uri << ")" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// 버퍼 뷰 구간 (범위를 벗어나면 빈 구간)
+ByteRange bufferView(const Document& document, int index, size_t* byteStride = nullptr)
+{
+    const JsonValue& view = document.json.get("bufferViews").at(static_cast<size_t>(index));
+    int buffer = view.get("buffer").asInt(-1);
+    if (buffer < 0 || static_cast<size_t>(buffer) >= document.buffers.size())
+        return ByteRange();
+    
+    const ByteRange& source = document.buffers[buffer];
+    size_t offset = static_cast<size_t>(view.get("byteOffset").asNumber());
+    size_t length = static_cast<size_t>(view.get("byteLength").asNumber());
+    if (offset > source.size || length > source.size - offset)
+        return ByteRange();
+    if (byteStride)
+        *byteStride = static_cast<size_t>(view.get("byteStride").asNumber());
+    return ByteRange{ source.data + offset, length };
+}
+
+// 접근자가 가리키는 매핑 구간을 확인만 하고 복사하지 않음
+bool bindAccessor(const Document& document, int index, Accessor& accessor)
+{
+    const JsonValue& json = document.json.get("accessors").at(static_cast<size_t>(index));
+    if (!json.isObject())
+        return false;
+    
+    accessor.componentType = json.get("componentType").asInt();
+    accessor.components = componentCount(json.get("type").asString());
+    accessor.normalized = json.get("normalized").asBool();
+    accessor.count = static_cast<size_t>(json.get("count").asNumber());
+    size_t elementSize = componentSize(accessor.componentType) * static_cast<size_t>(accessor.components);
+    if (elementSize == 0 || accessor.count == 0)
+        return false;
+    if (json.contains("sparse"))
+        std::cout << "WARNING::GLTF::Sparse accessor " << index << " not supported, using base values" << std::endl;
+    
+    int viewIndex = json.get("bufferView").asInt(-1);
+    if (viewIndex < 0)
+    {
+        std::cout << "ERROR::GLTF::Accessor " << index << " has no buffer view" << std::endl;
+        return false;
+    }
+    size_t stride = 0;
+    ByteRange view = bufferView(document, viewIndex, &stride);
+    size_t offset = static_cast<size_t>(json.get("byteOffset").asNumber());
+    accessor.stride = stride != 0 ? stride : elementSize;
+    size_t required = offset + (accessor.count - 1) * accessor.stride + elementSize;
+    if (!view.data || required > view.size)
+    {
+        std::cout << "ERROR::GLTF::Accessor " << index << " out of buffer view range" << std::endl;
+        return false;
+    }
+    accessor.data = view.data + offset;
+    return true;
+}
+
+float readComponent(const unsigned char* p, int componentType, bool normalized)
+{
+    switch (componentType)
+    {
+        case COMPONENT_FLOAT:
+        {
+            float value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+        case COMPONENT_UNSIGNED_BYTE:
+            return normalized ? *p / 255.0f : static_cast<float>(*p);
+        case COMPONENT_BYTE:
+        {
+            float value = static_cast<float>(static_cast<int8_t>(*p));
+            return normalized ? std::max(value / 127.0f, -1.0f) : value;
+        }
+        case COMPONENT_UNSIGNED_SHORT:
+        {
+            uint16_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return normalized ? value / 65535.0f : static_cast<float>(value);
+        }
+        case COMPONENT_SHORT:
+        {
+            int16_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return normalized ? std::max(value / 32767.0f, -1.0f) : static_cast<float>(value);
+        }
+        case COMPONENT_UNSIGNED_INT:
+        {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return static_cast<float>(value);
+        }
+        default:
+            return 0.0f;
+    }
+}
+
+// 원소 하나를 float로 읽음 (접근자 컴포넌트가 적으면 나머지는 건드리지 않음)
+void readElement(const Accessor& accessor, size_t index, float* out, int components)
+{
+    const unsigned char* element = accessor.data + index * accessor.stride;
+    size_t size = componentSize(accessor.componentType);
+    int count = std::min(components, accessor.components);
+    if (accessor.componentType == COMPONENT_FLOAT)
+    {
+        std::memcpy(out, element, size * count);
+        return;
+    }
+    for (int c = 0; c < count; c++)
+        out[c] = readComponent(element + c * size, accessor.componentType, accessor.normalized);
+}
+
+uint32_t readIndex(const Accessor& accessor, size_t index)
+{
+    const unsigned char* element = accessor.data + index * accessor.stride;
+    switch (accessor.componentType)
+    {
+        case COMPONENT_UNSIGNED_BYTE:
+            return *element;
+        case COMPONENT_UNSIGNED_SHORT:
+        {
+            uint16_t value;
+            std::memcpy(&value, element, sizeof(value));
+            return value;
+        }
+        default:
+        {
+            uint32_t value;
+            std::memcpy(&value, element, sizeof(value));
+            return value;
+        }
+    }
+}
+
+// matrix(열 우선) 또는 T * R * S
+glm::mat4 nodeTransform(const JsonValue& node)
+{
+    glm::mat4 transform(1.0f);
+    const JsonValue& matrix = node.get("matrix");
+    if (matrix.size() == 16)
+    {
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+                transform[column][row] = matrix.at(column * 4 + row).asFloat();
+        }
+        return transform;
+    }
+    
+    const JsonValue& t = node.get("translation");
+    const JsonValue& r = node.get("rotation");
+    const JsonValue& s = node.get("scale");
+    float x = r.at(0).asFloat(0.0f), y = r.at(1).asFloat(0.0f), z = r.at(2).asFloat(0.0f), w = r.at(3).asFloat(1.0f);
+    glm::vec3 scale(s.at(0).asFloat(1.0f), s.at(1).asFloat(1.0f), s.at(2).asFloat(1.0f));
+    transform[0] = glm::vec4(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + w * z), 2.0f * (x * z - w * y), 0.0f) * scale.x;
+    transform[1] = glm::vec4(2.0f * (x * y - w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + w * x), 0.0f) * scale.y;
+    transform[2] = glm::vec4(2.0f * (x * z + w * y), 2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y), 0.0f) * scale.z;
+    transform[3] = glm::vec4(t.at(0).asFloat(), t.at(1).asFloat(), t.at(2).asFloat(), 1.0f);
+    return transform;
+}
+
+void collectInstances(const Document& document, int nodeIndex, const glm::mat4& parent, int depth,
+                      unsigned int defaultMaterial, std::vector<Instance>& instances)
+{
+    const JsonValue& node = document.json.get("nodes").at(static_cast<size_t>(nodeIndex));
+    if (!node.isObject() || depth > MAX_NODE_DEPTH)
+        return;
+    
+    glm::mat4 transform = parent * nodeTransform(node);
+    int meshIndex = node.get("mesh").asInt(-1);
+    if (meshIndex >= 0)
+    {
+        const JsonValue& primitives = document.json.get("meshes").at(static_cast<size_t>(meshIndex)).get("primitives");
+        for (size_t i = 0; i < primitives.size(); i++)
+        {
+            const JsonValue& primitive = primitives.at(i);
+            int material = primitive.get("material").asInt(-1);
+            instances.push_back({ &primitive, material >= 0 ? static_cast<unsigned int>(material) : defaultMaterial,
+                                  transform });
+        }
+    }
+    
+    const JsonValue& children = node.get("children");
+    for (size_t i = 0; i < children.size(); i++)
+        collectInstances(document, children.at(i).asInt(-1), transform, depth + 1, defaultMaterial, instances);
+}
+
+// 면적 가중 부드러운 노말 (Assimp GenSmoothNormals와 같은 역할)
+void generateNormals(std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    for (Vertex& vertex : vertices)
+        vertex.Normal = glm::vec3(0.0f);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        Vertex& a = vertices[indices[i]];
+        Vertex& b = vertices[indices[i + 1]];
+        Vertex& c = vertices[indices[i + 2]];
+        glm::vec3 normal = glm::cross(b.Position - a.Position, c.Position - a.Position);
+        a.Normal += normal;
+        b.Normal += normal;
+        c.Normal += normal;
+    }
+    for (Vertex& vertex : vertices)
+    {
+        float length = glm::length(vertex.Normal);
+        vertex.Normal = length > 0.0f ? vertex.Normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+}
+
+// 프리미티브 하나를 노드 변환을 적용한 Vertex/인덱스 배열로 (워커 스레드에서 실행)
+bool convertPrimitive(const Document& document, const Instance& instance, GltfMesh& mesh)
+{
+    const JsonValue& primitive = *instance.primitive;
+    int mode = primitive.get("mode").asInt(MODE_TRIANGLES);
+    if (mode != MODE_TRIANGLES && mode != MODE_TRIANGLE_STRIP && mode != MODE_TRIANGLE_FAN)
+        return false; // 점/선 프리미티브는 Assimp 경로와 마찬가지로 건너뜀
+    
+    const JsonValue& attributes = primitive.get("attributes");
+    Accessor positions, normals, texCoords, tangents, indexAccessor;
+    if (!bindAccessor(document, attributes.get("POSITION").asInt(-1), positions) || positions.components != 3)
+        return false;
+    bool hasNormals = attributes.contains("NORMAL") &&
+                      bindAccessor(document, attributes.get("NORMAL").asInt(-1), normals) && normals.count == positions.count;
+    bool hasTexCoords = attributes.contains("TEXCOORD_0") &&
+                        bindAccessor(document, attributes.get("TEXCOORD_0").asInt(-1), texCoords) &&
+                        texCoords.count == positions.count;
+    bool hasTangents = hasNormals && hasTexCoords && attributes.contains("TANGENT") &&
+                       bindAccessor(document, attributes.get("TANGENT").asInt(-1), tangents) &&
+                       tangents.count == positions.count && tangents.components == 4;
+    bool indexed = primitive.contains("indices");
+    if (indexed && !bindAccessor(document, primitive.get("indices").asInt(-1), indexAccessor))
+        return false;
+    
+    // 음수 배율(거울상) 변환이면 감기 순서와 탄젠트 기저의 손잡이가 뒤집힘
+    glm::mat3 linear(instance.transform);
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(linear));
+    bool mirrored = glm::determinant(linear) < 0.0f;
+    
+    std::vector<Vertex>& vertices = mesh.vertices;
+    vertices.assign(positions.count, Vertex{});
+    for (size_t i = 0; i < positions.count; i++)
+    {
+        float p[3] = { 0.0f, 0.0f, 0.0f };
+        readElement(positions, i, p, 3);
+        vertices[i].Position = glm::vec3(instance.transform * glm::vec4(p[0], p[1], p[2], 1.0f));
+    }
+    if (hasNormals)
+    {
+        for (size_t i = 0; i < normals.count; i++)
+        {
+            float n[3] = { 0.0f, 0.0f, 0.0f };
+            readElement(normals, i, n, 3);
+            glm::vec3 normal = normalMatrix * glm::vec3(n[0], n[1], n[2]);
+            float length = glm::length(normal);
+            vertices[i].Normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    }
+    if (hasTexCoords)
+    {
+        for (size_t i = 0; i < texCoords.count; i++)
+        {
+            float uv[2] = { 0.0f, 0.0f };
+            readElement(texCoords, i, uv, 2);
+            vertices[i].TexCoords = glm::vec2(uv[0], uv[1]);
+        }
+    }
+    if (hasTangents)
+    {
+        for (size_t i = 0; i < tangents.count; i++)
+        {
+            float t[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            readElement(tangents, i, t, 4);
+            glm::vec3 tangent = linear * glm::vec3(t[0], t[1], t[2]);
+            float length = glm::length(tangent);
+            tangent = length > 0.0f ? tangent / length : glm::vec3(1.0f, 0.0f, 0.0f);
+            float handedness = (t[3] < 0.0f) != mirrored ? -1.0f : 1.0f;
+            vertices[i].Tangent = tangent;
+            vertices[i].Bitangent = glm::cross(vertices[i].Normal, tangent) * handedness;
+        }
+    }
+    mesh.hasTexCoords = hasTexCoords;
+    mesh.hasTangents = hasTangents;
+    
+    // 인덱스 (없으면 정점 순서 그대로), 스트립/팬은 삼각형 목록으로 변환
+    size_t count = indexed ? indexAccessor.count : positions.count;
+    auto vertexAt = [&](size_t i) -> unsigned int {
+        return indexed ? readIndex(indexAccessor, i) : static_cast<unsigned int>(i);
+    };
+    std::vector<unsigned int>& indices = mesh.indices;
+    if (mode == MODE_TRIANGLES)
+    {
+        indices.resize(count - count % 3);
+        for (size_t i = 0; i < indices.size(); i++)
+            indices[i] = vertexAt(i);
+    }
+    else if (count >= 3)
+    {
+        indices.reserve((count - 2) * 3);
+        for (size_t i = 0; i + 2 < count; i++)
+        {
+            if (mode == MODE_TRIANGLE_FAN)
+                indices.insert(indices.end(), { vertexAt(i + 1), vertexAt(i + 2), vertexAt(0) });
+            else if (i % 2 == 0)
+                indices.insert(indices.end(), { vertexAt(i), vertexAt(i + 1), vertexAt(i + 2) });
+            else
+                indices.insert(indices.end(), { vertexAt(i + 1), vertexAt(i), vertexAt(i + 2) });
+        }
+    }
+    for (unsigned int index : indices)
+    {
+        if (index >= vertices.size())
+        {
+            std::cout << "ERROR::GLTF::Index out of range in primitive" << std::endl;
+            return false;
+        }
+    }
+    if (mirrored)
+    {
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+            std::swap(indices[i + 1], indices[i + 2]);
+    }
+    
+    if (!hasNormals)
+        generateNormals(vertices, indices);
+    mesh.materialIndex = instance.materialIndex;
+    return !indices.empty();
+}
+
+// 이미지 하나의 파일 경로 (모델 기준 상대 경로). 내장 이미지는 파일로 풀지 않고 TextureLoader에 메모리 이미지로 등록
+std::string resolveImage(const Document& document, int index)
+{
+    const JsonValue& image = document.json.get("images").at(static_cast<size_t>(index));
+    const std::string& uri = image.get("uri").asString();
+    if (!uri.empty() && !hasPrefix(uri, "data:"))
+        return decodeUriPath(uri);
+    
+    std::string mimeType = image.get("mimeType").asString();
+    std::vector<unsigned char> decoded;
+    if (!uri.empty())
+    {
+        if (!decodeDataUri(uri, decoded, &mimeType))
+            return std::string();
+    }
+    else if (image.contains("bufferView"))
+    {
+        ByteRange bytes = bufferView(document, image.get("bufferView").asInt(-1));
+        if (bytes.data)
+            decoded.assign(bytes.data, bytes.data + bytes.size);
+    }
+    if (decoded.empty())
+        return std::string();
+    
+    // 이름에 내용 해시를 넣어 다시 내보낸 모델의 바뀐 이미지가 이전 텍스처(캐시)를 쓰지 않게 함
+    // (메시 캐시에 저장되는 경로이기도 하므로 실행마다 같은 이름이어야 함)
+    std::string name = document.fileName + ".image" + std::to_string(index) + "." +
+                       std::to_string(hashBytes(decoded.data(), decoded.size(), 0)) +
+                       (mimeType == "image/jpeg" ? ".jpg" : ".png");
+    TextureLoader::addMemoryImage(name, std::move(decoded));
+    return name;
+}
+
+// textureInfo({"index": n}) -> 이미지 경로 (이미지마다 한 번만 해석)
+std::string texturePath(const Document& document, const JsonValue& textureInfo, std::vector<std::string>& imagePaths,
+                        std::vector<bool>& resolved)
+{
+    int textureIndex = textureInfo.get("index").asInt(-1);
+    if (textureIndex < 0)
+        return std::string();
+    if (textureInfo.get("texCoord").asInt(0) != 0)
+        std::cout << "WARNING::GLTF::Only TEXCOORD_0 is supported, texture " << textureIndex << " may be misplaced" << std::endl;
+    
+    int imageIndex = document.json.get("textures").at(static_cast<size_t>(textureIndex)).get("source").asInt(-1);
+    if (imageIndex < 0 || static_cast<size_t>(imageIndex) >= imagePaths.size())
+        return std::string();
+    if (!resolved[imageIndex])
+    {
+        imagePaths[imageIndex] = resolveImage(document, imageIndex);
+        resolved[imageIndex] = true;
+    }
+    return imagePaths[imageIndex];
+}
+
+void parseMaterials(const Document& document, std::vector<GltfMaterial>& materials)
+{
+    const JsonValue& json = document.json.get("materials");
+    size_t imageCount = document.json.get("images").size();
+    std::vector<std::string> imagePaths(imageCount);
+    std::vector<bool> resolved(imageCount, false);
+    
+    materials.resize(json.size());
+    for (size_t i = 0; i < json.size(); i++)
+    {
+        const JsonValue& source = json.at(i);
+        const JsonValue& pbr = source.get("pbrMetallicRoughness");
+        GltfMaterial& material = materials[i];
+        material.baseColorMap = texturePath(document, pbr.get("baseColorTexture"), imagePaths, resolved);
+        material.metallicRoughnessMap = texturePath(document, pbr.get("metallicRoughnessTexture"), imagePaths, resolved);
+        material.normalMap = texturePath(document, source.get("normalTexture"), imagePaths, resolved);
+        material.occlusionMap = texturePath(document, source.get("occlusionTexture"), imagePaths, resolved);
+        
+        const JsonValue& baseColor = pbr.get("baseColorFactor");
+        for (int c = 0; c < 4 && static_cast<size_t>(c) < baseColor.size(); c++)
+            material.baseColorFactor[c] = baseColor.at(c).asFloat(1.0f);
+        material.metallicFactor = pbr.get("metallicFactor").asFloat(1.0f);
+        material.roughnessFactor = pbr.get("roughnessFactor").asFloat(1.0f);
+    }
+    // 머티리얼이 없는 프리미티브용 기본 머티리얼 (스펙 기본값)
+    materials.emplace_back();
+}
+
+// 지오메트리 압축 확장은 버퍼 뷰를 바로 읽을 수 없으므로 거부
+bool checkExtensions(const Document& document)
+{
+    const JsonValue& required = document.json.get("extensionsRequired");
+    for (size_t i = 0; i < required.size(); i++)
+    {
+        const std::string& name = required.at(i).asString();
+        if (name == "KHR_draco_mesh_compression" || name == "EXT_meshopt_compression")
+        {
+            std::cout << "ERROR::GLTF::Unsupported required extension: " << name << std::endl;
+            return false;
+        }
+        if (name != "KHR_mesh_quantization")
+            std::cout << "WARNING::GLTF::Ignoring required extension: " << name << std::endl;
+    }
+    return true;
+}
+
+// 파일을 열고 JSON(GLB면 JSON 청크)을 파싱해 버전 확인
+bool openDocument(const std::string& path, Document& document)
+{
+    size_t slash = path.find_last_of("/\\");
+    document.directory = slash != std::string::npos ? path.substr(0, slash) : ".";
+    document.fileName = slash != std::string::npos ? path.substr(slash + 1) : path;
+    
+    if (!document.file.open(path))
+    {
+        std::cout << "ERROR::GLTF::Failed to open file: " << path << std::endl;
+        return false;
+    }
+    
+    uint32_t magic = 0;
+    if (document.file.size() >= sizeof(magic))
+        std::memcpy(&magic, document.file.data(), sizeof(magic));
+    if (magic == GLB_MAGIC)
+    {
+        if (!parseGlb(document))
+            return false;
+    }
+    else
+    {
+        std::string error;
+        if (!JsonValue::parse(reinterpret_cast<const char*>(document.file.data()), document.file.size(),
+                              document.json, &error))
+        {
+            std::cout << "ERROR::GLTF::Invalid JSON in " << path << ": " << error << std::endl;
+            return false;
+        }
+    }
+    
+    const std::string& version = document.json.get("asset").get("version").asString();
+    if (!hasPrefix(version, "2."))
+    {
+        std::cout << "ERROR::GLTF::Unsupported glTF version '" << version << "': " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+GltfLoaderSettings& GltfLoader::settings()
+{
+    static GltfLoaderSettings instance;
+    return instance;
+}
+
+bool GltfLoader::load(const std::string& path, GltfScene& scene, ThreadPool& pool)
+{
+    Document document;
+    if (!openDocument(path, document))
+        return false;
+    if (!checkExtensions(document) || !loadBuffers(document))
+        return false;
+    
+    parseMaterials(document, scene.materials);
+    unsigned int defaultMaterial = static_cast<unsigned int>(scene.materials.size() - 1);
+    
+    // 기본 장면의 루트 노드부터 (장면 정보가 없으면 어떤 노드의 자식도 아닌 노드 전부)
+    std::vector<int> roots;
+    const JsonValue& scenes = document.json.get("scenes");
+    if (scenes.size() > 0)
+    {
+        const JsonValue& nodes = scenes.at(static_cast<size_t>(document.json.get("scene").asInt(0))).get("nodes");
+        for (size_t i = 0; i < nodes.size(); i++)
+            roots.push_back(nodes.at(i).asInt(-1));
+    }
+    else
+    {
+        const JsonValue& nodes = document.json.get("nodes");
+        std::vector<bool> isChild(nodes.size(), false);
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            const JsonValue& children = nodes.at(i).get("children");
+            for (size_t c = 0; c < children.size(); c++)
+            {
+                int child = children.at(c).asInt(-1);
+                if (child >= 0 && static_cast<size_t>(child) < isChild.size())
+                    isChild[child] = true;
+            }
+        }
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            if (!isChild[i])
+                roots.push_back(static_cast<int>(i));
+        }
+    }
+    
+    std::vector<Instance> instances;
+    for (int root : roots)
+        collectInstances(document, root, glm::mat4(1.0f), 0, defaultMaterial, instances);
+    for (Instance& instance : instances)
+    {
+        if (instance.materialIndex > defaultMaterial)
+            instance.materialIndex = defaultMaterial;
+    }
+    
+    // 프리미티브마다 작업 하나 (매핑된 버퍼는 읽기만 하므로 공유)
+    scene.meshes.resize(instances.size());
+    std::vector<char> converted(instances.size(), 0);
+    pool.parallelFor(instances.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            converted[i] = convertPrimitive(document, instances[i], scene.meshes[i]) ? 1 : 0;
+    });
+    
+    size_t kept = 0;
+    for (size_t i = 0; i < scene.meshes.size(); i++)
+    {
+        if (!converted[i])
+            continue;
+        if (kept != i)
+            scene.meshes[kept] = std::move(scene.meshes[i]);
+        kept++;
+    }
+    scene.meshes.resize(kept);
+    if (scene.meshes.empty())
+    {
+        std::cout << "ERROR::GLTF::No triangle primitives in " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool GltfLoader::registerEmbeddedImages(const std::string& path)
+{
+    // 지오메트리는 읽지 않고 JSON과 버퍼 매핑만 (이미지 이름과 바이트는 load와 같음)
+    Document document;
+    if (!openDocument(path, document) || !loadBuffers(document))
+        return false;
+    size_t imageCount = document.json.get("images").size();
+    for (size_t i = 0; i < imageCount; i++)
+        resolveImage(document, static_cast<int>(i));
+    return true;
+}
@@ -0,0 +1,64 @@
+#include "../include/instancing.h"
+#include <algorithm>
+#include <utility>
+
+InstanceData Instancing::pack(const ModelInstance& instance)
+{
+    InstanceData data;
+    data.model = instance.model;
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(instance.model)));
+    for (int c = 0; c < 3; c++)
+        data.normalMatrix[c] = glm::vec4(normalMatrix[c], 0.0f);
+    data.material = glm::vec4(instance.tint, instance.roughness);
+    return data;
+}
+
+InstanceGroup::InstanceGroup(std::vector<ModelInstance> instances, const Aabb& modelBounds)
+{
+    build(std::move(instances), modelBounds);
+}
+
+void InstanceGroup::build(std::vector<ModelInstance> instances, const Aabb& modelBounds)
+{
+    items = std::move(instances);
+    bounds.clear();
+    bounds.reserve(items.size());
+    for (const ModelInstance& instance : items)
+        bounds.push_back(modelBounds.transformed(instance.model));
+    bvh.build(bounds);
+}
+
+InstanceBuffer::InstanceBuffer(size_t initialCapacity)
+{
+    vbo = GLBuffer::create();
+    allocate(std::max<size_t>(initialCapacity, 1));
+}
+
+void InstanceBuffer::allocate(size_t newCapacity)
+{
+    // 같은 이름에 새 저장 공간을 받으므로 VAO의 속성 포인터는 그대로 유효
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vbo.get());
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newCapacity * sizeof(InstanceData)), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    capacity = newCapacity;
+    cursor = 0;
+}
+
+size_t InstanceBuffer::upload(const InstanceData* data, size_t count)
+{
+    if (count == 0)
+        return cursor * sizeof(InstanceData);
+    
+    // 링을 다 썼으면 드라이버에 새 저장 공간을 받아 이전 드로가 읽는 내용과 겹치지 않게 함
+    if (count > capacity)
+        allocate(std::max(count, capacity * 2));
+    else if (cursor + count > capacity)
+        allocate(capacity);
+    
+    size_t offset = cursor * sizeof(InstanceData);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vbo.get());
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(count * sizeof(InstanceData)), data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    cursor += count;
+    return offset;
+}
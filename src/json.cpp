@@ -0,0 +1,359 @@
+#include "../include/json.h"
+#include <charconv>
+#include <cstdint>
+
+namespace {
+
+// 악의적인 입력으로 스택이 넘치지 않도록 중첩 깊이 제한
+constexpr int MAX_DEPTH = 256;
+
+const JsonValue& nullValue()
+{
+    static const JsonValue instance;
+    return instance;
+}
+
+void appendUtf8(std::string& out, uint32_t codePoint)
+{
+    if (codePoint < 0x80)
+        out.push_back(static_cast<char>(codePoint));
+    else if (codePoint < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+} // namespace
+
+// 재귀 하강 파서 (JsonValue의 private 멤버를 직접 채움)
+class JsonParser
+{
+public:
+    JsonParser(const char* text, size_t length) : cursor(text), begin(text), end(text + length) {}
+    
+    bool parseDocument(JsonValue& out, std::string* error)
+    {
+        bool ok = parseValue(out, 0);
+        skipWhitespace();
+        if (ok && cursor != end)
+            ok = fail("unexpected trailing data");
+        if (!ok && error)
+            *error = message + " at offset " + std::to_string(cursor - begin);
+        return ok;
+    }
+    
+private:
+    const char* cursor;
+    const char* begin;
+    const char* end;
+    std::string message;
+    
+    bool fail(const char* what)
+    {
+        if (message.empty())
+            message = what;
+        return false;
+    }
+    
+    void skipWhitespace()
+    {
+        while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r'))
+            ++cursor;
+    }
+    
+    bool consumeLiteral(const char* literal)
+    {
+        const char* p = cursor;
+        for (; *literal; ++literal, ++p)
+        {
+            if (p == end || *p != *literal)
+                return fail("invalid literal");
+        }
+        cursor = p;
+        return true;
+    }
+    
+    bool parseValue(JsonValue& out, int depth)
+    {
+        if (depth > MAX_DEPTH)
+            return fail("nesting too deep");
+        
+        skipWhitespace();
+        if (cursor == end)
+            return fail("unexpected end of input");
+        
+        switch (*cursor)
+        {
+            case '{':
+                return parseObject(out, depth);
+            case '[':
+                return parseArray(out, depth);
+            case '"':
+                out.valueType = JsonValue::TYPE_STRING;
+                return parseString(out.stringValue);
+            case 't':
+                out.valueType = JsonValue::TYPE_BOOL;
+                out.boolValue = true;
+                return consumeLiteral("true");
+            case 'f':
+                out.valueType = JsonValue::TYPE_BOOL;
+                out.boolValue = false;
+                return consumeLiteral("false");
+            case 'n':
+                out.valueType = JsonValue::TYPE_NULL;
+                return consumeLiteral("null");
+            default:
+                return parseNumber(out);
+        }
+    }
+    
+    bool parseNumber(JsonValue& out)
+    {
+        // from_chars는 앞의 '+'를 받지 않고 JSON도 허용하지 않으므로 그대로 사용
+        auto result = std::from_chars(cursor, end, out.numberValue);
+        if (result.ec != std::errc() || result.ptr == cursor)
+            return fail("invalid number");
+        out.valueType = JsonValue::TYPE_NUMBER;
+        cursor = result.ptr;
+        return true;
+    }
+    
+    bool parseHex4(uint32_t& value)
+    {
+        if (end - cursor < 4)
+            return fail("truncated unicode escape");
+        value = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            char c = *cursor++;
+            value <<= 4;
+            if (c >= '0' && c <= '9')
+                value |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f')
+                value |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F')
+                value |= static_cast<uint32_t>(c - 'A' + 10);
+            else
+                return fail("invalid unicode escape");
+        }
+        return true;
+    }
+    
+    bool parseString(std::string& out)
+    {
+        ++cursor; // '"'
+        out.clear();
+        while (cursor != end)
+        {
+            // 이스케이프가 없는 구간은 한 번에 복사
+            const char* run = cursor;
+            while (cursor != end && *cursor != '"' && *cursor != '\\')
+                ++cursor;
+            out.append(run, cursor);
+            if (cursor == end)
+                break;
+            
+            if (*cursor == '"')
+            {
+                ++cursor;
+                return true;
+            }
+            
+            ++cursor; // '\\'
+            if (cursor == end)
+                break;
+            char escape = *cursor++;
+            switch (escape)
+            {
+                case '"': out.push_back('"'); break;
+                case '\\': out.push_back('\\'); break;
+                case '/': out.push_back('/'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u':
+                {
+                    uint32_t codePoint;
+                    if (!parseHex4(codePoint))
+                        return false;
+                    // UTF-16 서로게이트 쌍
+                    if (codePoint >= 0xD800 && codePoint <= 0xDBFF && end - cursor >= 6 &&
+                        cursor[0] == '\\' && cursor[1] == 'u')
+                    {
+                        cursor += 2;
+                        uint32_t low;
+                        if (!parseHex4(low))
+                            return false;
+                        if (low >= 0xDC00 && low <= 0xDFFF)
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, codePoint);
+                    break;
+                }
+                default:
+                    return fail("invalid escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+    
+    bool parseArray(JsonValue& out, int depth)
+    {
+        ++cursor; // '['
+        out.valueType = JsonValue::TYPE_ARRAY;
+        skipWhitespace();
+        if (cursor != end && *cursor == ']')
+        {
+            ++cursor;
+            return true;
+        }
+        
+        while (true)
+        {
+            out.arrayValues.emplace_back();
+            if (!parseValue(out.arrayValues.back(), depth + 1))
+                return false;
+            skipWhitespace();
+            if (cursor == end)
+                return fail("unterminated array");
+            if (*cursor == ']')
+            {
+                ++cursor;
+                return true;
+            }
+            if (*cursor != ',')
+                return fail("expected ',' or ']'");
+            ++cursor;
+        }
+    }
+    
+    bool parseObject(JsonValue& out, int depth)
+    {
+        ++cursor; // '{'
+        out.valueType = JsonValue::TYPE_OBJECT;
+        skipWhitespace();
+        if (cursor != end && *cursor == '}')
+        {
+            ++cursor;
+            return true;
+        }
+        
+        while (true)
+        {
+            skipWhitespace();
+            if (cursor == end || *cursor != '"')
+                return fail("expected object key");
+            out.objectMembers.emplace_back();
+            if (!parseString(out.objectMembers.back().first))
+                return false;
+            skipWhitespace();
+            if (cursor == end || *cursor != ':')
+                return fail("expected ':'");
+            ++cursor;
+            if (!parseValue(out.objectMembers.back().second, depth + 1))
+                return false;
+            skipWhitespace();
+            if (cursor == end)
+                return fail("unterminated object");
+            if (*cursor == '}')
+            {
+                ++cursor;
+                return true;
+            }
+            if (*cursor != ',')
+                return fail("expected ',' or '}'");
+            ++cursor;
+        }
+    }
+};
+
+bool JsonValue::parse(const char* text, size_t length, JsonValue& out, std::string* error)
+{
+    out = JsonValue();
+    JsonParser parser(text, length);
+    return parser.parseDocument(out, error);
+}
+
+bool JsonValue::asBool(bool fallback) const
+{
+    return valueType == TYPE_BOOL ? boolValue : fallback;
+}
+
+double JsonValue::asNumber(double fallback) const
+{
+    return valueType == TYPE_NUMBER ? numberValue : fallback;
+}
+
+float JsonValue::asFloat(float fallback) const
+{
+    return valueType == TYPE_NUMBER ? static_cast<float>(numberValue) : fallback;
+}
+
+int JsonValue::asInt(int fallback) const
+{
+    return valueType == TYPE_NUMBER ? static_cast<int>(numberValue) : fallback;
+}
+
+const std::string& JsonValue::asString() const
+{
+    static const std::string empty;
+    return valueType == TYPE_STRING ? stringValue : empty;
+}
+
+size_t JsonValue::size() const
+{
+    if (valueType == TYPE_ARRAY)
+        return arrayValues.size();
+    if (valueType == TYPE_OBJECT)
+        return objectMembers.size();
+    return 0;
+}
+
+const JsonValue& JsonValue::at(size_t index) const
+{
+    if (valueType != TYPE_ARRAY || index >= arrayValues.size())
+        return nullValue();
+    return arrayValues[index];
+}
+
+const JsonValue& JsonValue::get(const char* key) const
+{
+    // glTF 객체는 키가 몇 개뿐이라 선형 탐색으로 충분
+    if (valueType == TYPE_OBJECT)
+    {
+        for (const auto& member : objectMembers)
+        {
+            if (member.first == key)
+                return member.second;
+        }
+    }
+    return nullValue();
+}
+
+bool JsonValue::contains(const char* key) const
+{
+    if (valueType != TYPE_OBJECT)
+        return false;
+    for (const auto& member : objectMembers)
+    {
+        if (member.first == key)
+            return true;
+    }
+    return false;
+}
@@ -2,12 +2,20 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include "../include/shader.h"
 #include "../include/model.h"
+#include "../include/asset_manager.h"
+#include "../include/gl_capabilities.h"
 #include "../include/camera.h"
 #include "../include/app_state.h"
 #include "../include/input_handler.h"
+#include "../include/uniform_blocks.h"
+#include "../include/gl_state.h"
+#include "../include/render_queue.h"
+#include "../include/instancing.h"
 
 // 전역 변수 (콜백 함수에서 접근하기 위해)
 AppState* g_appState = nullptr;
@@ -18,8 +26,11 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 void processInput(GLFWwindow *window);
 void setupShader(Shader& shader, const AppState& appState);
-void updateShaderUniforms(Shader& shader, const AppState& appState, 
+void updateFrameUniforms(UniformBlockBuffers& uniformBlocks, const AppState& appState, 
+                         const glm::mat4& projection, const glm::mat4& view,
                          const glm::vec3* lightPositions, const glm::vec3* lightColors);
+unsigned int globalShaderFeatures(const AppState& appState);
+std::vector<ModelInstance> makeInstanceGrid();
 
 int main()
 {
@@ -52,6 +63,9 @@ int main()
         return -1;
     }
     
+    // 텍스처 압축 포맷 선택과 셰이더 프로그램 캐시에 쓰이므로 셰이더/텍스처 로드 전에 확인
+    GLCapabilities::detect((GLADloadproc)glfwGetProcAddress);
+    
     glEnable(GL_DEPTH_TEST);
     
     // 애플리케이션 상태 초기화
@@ -69,55 +83,96 @@ int main()
     std::cout << "V: Tangent Space 모드 토글" << std::endl;
     std::cout << "B: IBL (Image Based Lighting) 모드 토글" << std::endl;
     std::cout << "N: Albedo sRGB 모드 토글" << std::endl;
+    std::cout << "C: 메시/메시렛 컬링 토글" << std::endl;
+    std::cout << "I: 인스턴싱 (모델 복사본 격자) 토글" << std::endl;
     std::cout << "0: 마우스 커서 잠금/해제" << std::endl;
     std::cout << "ESC: 종료\n" << std::endl;
     
-    Shader shader("shader.vert", "shader.frag");
-    Model ourModel("mjolnirFBX.FBX");
-    
-    // PBR 조명 설정
-    glm::vec3 lightPositions[MAX_LIGHTS] = {
-        glm::vec3( 4.0f,  4.0f,  4.0f),  // 우상전
-        glm::vec3(-4.0f,  4.0f,  4.0f),  // 좌상전
-        glm::vec3( 0.0f,  4.0f, -4.0f),  // 상후쪽 리머라이트
-        glm::vec3( 0.0f, -4.0f,  4.0f)   // 하전쪽 필
-    };
-    glm::vec3 lightColors[MAX_LIGHTS] = {
-        glm::vec3(65.0f, 65.0f, 65.0f),
-        glm::vec3(65.0f, 65.0f, 65.0f),
-        glm::vec3(65.0f, 65.0f, 65.0f),
-        glm::vec3(65.0f, 65.0f, 65.0f)
-    };
-    
-    setupShader(shader, appState);
-    
-    while (!glfwWindowShouldClose(window))
+    // GL 자원(모델, 텍스처)은 컨텍스트가 살아 있는 이 블록 안에서 해제됨
     {
-        appState.updateTime();
-        processInput(window);
+        Shader shader("shader.vert", "shader.frag", pbrShaderFeatureDefines());
+        Model ourModel("mjolnirFBX.FBX");
+        // 현재 모드에서 쓰는 변형은 첫 프레임 전에 컴파일 (모드를 바꾸면 새 변형은 처음 그릴 때 컴파일)
+        shader.warmUp(ourModel.shaderFeatures(appState.useTangentSpace, globalShaderFeatures(appState)));
+        
+        // PBR 조명 설정
+        glm::vec3 lightPositions[MAX_LIGHTS] = {
+            glm::vec3( 4.0f,  4.0f,  4.0f),  // 우상전
+            glm::vec3(-4.0f,  4.0f,  4.0f),  // 좌상전
+            glm::vec3( 0.0f,  4.0f, -4.0f),  // 상후쪽 리머라이트
+            glm::vec3( 0.0f, -4.0f,  4.0f)   // 하전쪽 필
+        };
+        glm::vec3 lightColors[MAX_LIGHTS] = {
+            glm::vec3(65.0f, 65.0f, 65.0f),
+            glm::vec3(65.0f, 65.0f, 65.0f),
+            glm::vec3(65.0f, 65.0f, 65.0f),
+            glm::vec3(65.0f, 65.0f, 65.0f)
+        };
+        
+        setupShader(shader, appState);
+        MeshUniforms meshUniforms(shader);
+        // 카메라/조명과 모델 행렬은 모든 프로그램이 공유하는 uniform 블록으로 올림
+        UniformBlockBuffers uniformBlocks;
+        RenderQueue renderQueue;
+        InstanceBuffer instanceBuffer;
+        // 인스턴스 월드 AABB로 BVH를 한 번 만들어 두고 프레임마다 절두체로 검사
+        InstanceGroup instances(makeInstanceGrid(), ourModel.bounds());
+        
+        while (!glfwWindowShouldClose(window))
+        {
+            appState.updateTime();
+            processInput(window);
         
-        glClearColor(CLEAR_COLOR_R, CLEAR_COLOR_G, CLEAR_COLOR_B, CLEAR_COLOR_A);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            // 로드 중인 텍스처를 프레임 예산 안에서 조금씩 업로드
+            AssetManager::instance().update();
         
-        shader.use();
-        updateShaderUniforms(shader, appState, lightPositions, lightColors);
+            glClearColor(CLEAR_COLOR_R, CLEAR_COLOR_G, CLEAR_COLOR_B, CLEAR_COLOR_A);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
-        glm::mat4 projection = glm::perspective(glm::radians(appState.camera.Zoom), 
-                                                (float)SCR_WIDTH / (float)SCR_HEIGHT, 
-                                                NEAR_PLANE, FAR_PLANE);
-        glm::mat4 view = appState.camera.GetViewMatrix();
-        shader.setMat4("projection", projection);
-        shader.setMat4("view", view);
+            // 창 크기가 바뀌어도 맞도록 실제 프레임버퍼 크기 사용 (최소화 중에는 0이므로 1로 막음)
+            int framebufferWidth = 0, framebufferHeight = 0;
+            glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+            framebufferWidth = std::max(framebufferWidth, 1);
+            framebufferHeight = std::max(framebufferHeight, 1);
         
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::scale(model, glm::vec3(MODEL_SCALE));
-        shader.setMat4("model", model);
+            glm::mat4 projection = glm::perspective(glm::radians(appState.camera.Zoom), 
+                                                    (float)framebufferWidth / (float)framebufferHeight, 
+                                                    NEAR_PLANE, FAR_PLANE);
+            glm::mat4 view = appState.camera.GetViewMatrix();
+            updateFrameUniforms(uniformBlocks, appState, projection, view, lightPositions, lightColors);
         
-        ourModel.Draw(shader, appState.useTangentSpace);
+            glm::mat4 model = glm::mat4(1.0f);
+            model = glm::scale(model, glm::vec3(MODEL_SCALE));
         
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            DrawView drawView;
+            drawView.model = model;
+            drawView.viewProjection = projection * view;
+            drawView.cameraPosition = appState.camera.Position;
+            drawView.projectionScale = framebufferHeight / (2.0f * std::tan(glm::radians(appState.camera.Zoom) * 0.5f));
+            drawView.maxPixelError = LOD_MAX_PIXEL_ERROR;
+            drawView.culling = appState.useCulling;
+            drawView.shaderFeatures = globalShaderFeatures(appState);
+            // 메시를 큐에 모은 뒤 키 순서(변형 → 머티리얼 → 메시 → 가까운 것부터)로 그림
+            renderQueue.clear();
+            if (appState.useInstancing)
+                ourModel.enqueueInstanced(renderQueue, instances, appState.useTangentSpace, drawView);
+            else
+                ourModel.enqueue(renderQueue, appState.useTangentSpace, drawView);
+            renderQueue.sort();
+            renderQueue.submit(shader, meshUniforms, uniformBlocks, instanceBuffer);
+        
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
     }
+    const GLStateStats& glStats = GLState::instance().stats();
+    std::cout << "GL state cache: skipped " << glStats.skipped() << " of "
+              << (glStats.issued() + glStats.skipped()) << " calls (program " << glStats.programs.skipped
+              << ", VAO " << glStats.vertexArrays.skipped << ", texture " << glStats.textures.skipped
+              << ", uniform " << glStats.uniforms.skipped << ")" << std::endl;
+    
+    // 업로드용 PBO도 컨텍스트가 살아 있을 때 해제
+    AssetManager::instance().releaseGL();
     
     glfwTerminate();
     return 0;
@@ -132,18 +187,11 @@ void setupShader(Shader& shader, const AppState& appState)
     // 텍스처 유닛 설정
     shader.setInt("albedoMap", TEXTURE_UNIT_ALBEDO);
     shader.setInt("normalMap", TEXTURE_UNIT_NORMAL);
-    shader.setInt("metallicMap", TEXTURE_UNIT_METALLIC);
-    shader.setInt("roughnessMap", TEXTURE_UNIT_ROUGHNESS);
-    shader.setInt("aoMap", TEXTURE_UNIT_AO);
+    shader.setInt("ormMap", TEXTURE_UNIT_ORM);
     shader.setInt("irradianceMap", TEXTURE_UNIT_IRRADIANCE);
     shader.setInt("prefilterMap", TEXTURE_UNIT_PREFILTER);
     shader.setInt("brdfLUT", TEXTURE_UNIT_BRDF_LUT);
     
-    // 렌더링 모드 설정
-    shader.setBool("useIBL", appState.useIBL);
-    shader.setBool("albedoIsSRGB", appState.albedoIsSRGB);
-    shader.setBool("useTangentSpace", appState.useTangentSpace);
-    
     // 기본 Material 값 설정
     shader.setVec3("albedo", DEFAULT_ALBEDO_R, DEFAULT_ALBEDO_G, DEFAULT_ALBEDO_B);
     shader.setFloat("metallic", DEFAULT_METALLIC);
@@ -151,24 +199,56 @@ void setupShader(Shader& shader, const AppState& appState)
     shader.setFloat("ao", DEFAULT_AO);
 }
 
-void updateShaderUniforms(Shader& shader, const AppState& appState, 
+void updateFrameUniforms(UniformBlockBuffers& uniformBlocks, const AppState& appState, 
+                         const glm::mat4& projection, const glm::mat4& view,
                          const glm::vec3* lightPositions, const glm::vec3* lightColors)
 {
     using namespace AppConstants;
+    static_assert(MAX_LIGHTS <= UniformBlocks::MAX_LIGHTS, "light count exceeds the FrameData block");
     
+    UniformBlocks::FrameData frame = {};
+    frame.projection = projection;
+    frame.view = view;
+    frame.viewPos = glm::vec4(appState.camera.Position, 1.0f);
     // 조명 설정
     for (int i = 0; i < MAX_LIGHTS; ++i)
     {
-        shader.setVec3("lightPositions[" + std::to_string(i) + "]", lightPositions[i]);
-        shader.setVec3("lightColors[" + std::to_string(i) + "]", lightColors[i]);
+        frame.lightPositions[i] = glm::vec4(lightPositions[i], 1.0f);
+        frame.lightColors[i] = glm::vec4(lightColors[i], 0.0f);
     }
-    shader.setVec3("viewPos", appState.camera.Position);
-    shader.setInt("numLights", MAX_LIGHTS);
+    frame.numLights = MAX_LIGHTS;
+    uniformBlocks.updateFrame(frame);
+}
+
+// 렌더링 모드는 uniform 대신 셰이더 변형으로 반영 (탄젠트 공간은 메시별로 Draw에서 결정)
+unsigned int globalShaderFeatures(const AppState& appState)
+{
+    return (appState.useIBL ? FEATURE_IBL : 0u) | (appState.albedoIsSRGB ? FEATURE_ALBEDO_SRGB : 0u);
+}
+
+// 인스턴싱 모드의 복사본 배치: 원점 중심 격자, 복사본마다 색조와 거칠기를 조금씩 다르게
+std::vector<ModelInstance> makeInstanceGrid()
+{
+    using namespace AppConstants;
     
-    // 렌더링 모드 업데이트
-    shader.setBool("useTangentSpace", appState.useTangentSpace);
-    shader.setBool("useIBL", appState.useIBL);
-    shader.setBool("albedoIsSRGB", appState.albedoIsSRGB);
+    std::vector<ModelInstance> instances;
+    instances.reserve(INSTANCE_GRID_SIZE * INSTANCE_GRID_SIZE);
+    float half = (INSTANCE_GRID_SIZE - 1) * INSTANCE_SPACING * 0.5f;
+    for (int z = 0; z < INSTANCE_GRID_SIZE; z++)
+    {
+        for (int x = 0; x < INSTANCE_GRID_SIZE; x++)
+        {
+            ModelInstance instance;
+            glm::vec3 position(x * INSTANCE_SPACING - half, 0.0f, -z * INSTANCE_SPACING);
+            instance.model = glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(MODEL_SCALE));
+            float u = INSTANCE_GRID_SIZE > 1 ? x / float(INSTANCE_GRID_SIZE - 1) : 0.0f;
+            float v = INSTANCE_GRID_SIZE > 1 ? z / float(INSTANCE_GRID_SIZE - 1) : 0.0f;
+            instance.tint = glm::mix(glm::vec3(1.0f), glm::vec3(0.6f + 0.4f * u, 0.8f, 1.0f - 0.4f * u), v);
+            instance.roughness = (x + z) % 3 == 0 ? 0.2f + 0.6f * v : -1.0f;
+            instances.push_back(instance);
+        }
+    }
+    return instances;
 }
 
 void processInput(GLFWwindow *window)
@@ -195,6 +275,10 @@ void processInput(GLFWwindow *window)
                    g_appState->useIBL, "IBL (Image Based Lighting)");
     handleToggleKey(window, GLFW_KEY_N, g_appState->keyState.nPressed, 
                    g_appState->albedoIsSRGB, "Albedo sRGB");
+    handleToggleKey(window, GLFW_KEY_C, g_appState->keyState.cPressed, 
+                   g_appState->useCulling, "Mesh/Meshlet Culling");
+    handleToggleKey(window, GLFW_KEY_I, g_appState->keyState.iPressed, 
+                   g_appState->useInstancing, "Instancing");
     
     // 마우스 커서 잠금 처리
     handleCursorLock(window, *g_appState);
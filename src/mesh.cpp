@@ -1,121 +1,281 @@
 #include "../include/mesh.h"
 #include "../include/shader.h"
+#include "../include/asset_manager.h"
+#include "../include/frustum.h"
+#include "../include/gl_state.h"
+#include "../include/hash_util.h"
+#include "../include/meshlet.h"
+#include "../include/render_queue.h"
+#include "../include/vertex_format.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
 
-Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, bool hasTangentSpace)
+MeshUniforms::MeshUniforms(Shader& shader)
+    : positionScale(shader.uniform<glm::vec3>("positionScale")),
+      positionOffset(shader.uniform<glm::vec3>("positionOffset")),
+      baseColorFactor(shader.uniform<glm::vec3>("baseColorFactor")),
+      metallicFactor(shader.uniform<float>("metallicFactor")),
+      roughnessFactor(shader.uniform<float>("roughnessFactor"))
 {
-    this->vertices = vertices;
-    this->indices = indices;
-    this->textures = textures;
+}
+
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, bool hasTangentSpace,
+           std::vector<MeshLod> lods, std::vector<Meshlet> meshlets)
+{
+    this->vertices = std::move(vertices);
+    this->indices = std::move(indices);
+    this->textures = std::move(textures);
     this->hasTangentSpace = hasTangentSpace;
+    this->lods = std::move(lods);
+    this->meshlets = std::move(meshlets);
     
-    setupMesh();
+    setupMesh(this->vertices.data(), this->vertices.size(), this->indices.data(), this->indices.size());
 }
 
-void Mesh::setupMesh()
+Mesh::Mesh(const PackedMesh& packed, std::vector<Texture> textures, bool hasTangentSpace,
+           std::vector<MeshLod> lods, std::vector<Meshlet> meshlets)
 {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
+    this->textures = std::move(textures);
+    this->hasTangentSpace = hasTangentSpace;
+    this->lods = std::move(lods);
+    this->meshlets = std::move(meshlets);
     
-    glBindVertexArray(VAO);
+    uploadPacked(packed);
+}
+
+void Mesh::setupMesh(const Vertex* vertexData, size_t vertexCount, const unsigned int* indexData, size_t indexCount)
+{
+    // 위치 양자화 여부와 인덱스 폭은 메시마다 자동 선택
+    uploadPacked(VertexFormat::pack(vertexData, vertexCount, indexData, indexCount, VertexFormat::settings()));
+}
+
+void Mesh::uploadPacked(const PackedMesh& packed)
+{
+    if (lods.empty())
+    {
+        size_t indexSize = packed.indexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int);
+        lods.push_back({0, static_cast<unsigned int>(packed.indexData.size() / indexSize), 0.0f});
+    }
     
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+    positionScale = packed.positionScale;
+    positionOffset = packed.positionOffset;
+    indexType = packed.indexType;
+    boundsCenter = packed.boundsCenter;
+    boundsRadius = packed.boundsRadius;
+    boundsExtent = packed.boundsExtent;
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    // 공용 버퍼에 구간을 받아 복사 (메시별 VAO/VBO/EBO를 만들지 않음)
+    geometry = AssetManager::instance().geometry().upload(packed);
+}
+
+void Mesh::releaseCpuData()
+{
+    std::vector<Vertex>().swap(vertices);
+    std::vector<unsigned int>().swap(indices);
+}
+
+void Mesh::releaseGL()
+{
+    AssetManager::instance().geometry().free(geometry);
+    geometry = GeometryAllocation();
+}
+
+void Mesh::updateShaderFeatures()
+{
+    materialFeatures = factors.enabled ? FEATURE_MATERIAL_FACTORS : 0u;
+    for (const Texture& texture : textures)
+    {
+        if (texture.type == "texture_diffuse" || texture.type == "texture_albedo")
+            materialFeatures |= FEATURE_ALBEDO_MAP;
+        else if (texture.type == "texture_normal")
+            materialFeatures |= FEATURE_NORMAL_MAP;
+        else if (texture.type == "texture_orm")
+        {
+            // AO/roughness/metallic을 한 장에서 읽음 (없는 맵은 셰이더가 기본값 사용)
+            if (texture.ormChannels & ORM_OCCLUSION)
+                materialFeatures |= FEATURE_AO_MAP;
+            if (texture.ormChannels & ORM_ROUGHNESS)
+                materialFeatures |= FEATURE_ROUGHNESS_MAP;
+            if (texture.ormChannels & ORM_METALLIC)
+                materialFeatures |= FEATURE_METALLIC_MAP;
+        }
+    }
     
-    // vertex positions
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-    // vertex normals
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-    // vertex texture coords
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
-    // vertex tangent
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent));
-    // vertex bitangent
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Bitangent));
+    uint64_t hash = hashBytes(reinterpret_cast<const unsigned char*>(&materialFeatures), sizeof(materialFeatures), 0);
+    for (const Texture& texture : textures)
+        hash = hashBytes(reinterpret_cast<const unsigned char*>(&texture.id), sizeof(texture.id), hash);
+    if (factors.enabled)
+    {
+        const float values[] = { factors.baseColor.x, factors.baseColor.y, factors.baseColor.z, factors.metallic, factors.roughness };
+        hash = hashBytes(reinterpret_cast<const unsigned char*>(values), sizeof(values), hash);
+    }
+    materialKey = static_cast<uint32_t>(hash);
+}
+
+unsigned int Mesh::shaderFeatures(bool enableTangentSpace, unsigned int globalFeatures) const
+{
+    unsigned int features = materialFeatures | (globalFeatures & ~FEATURE_TANGENT_SPACE);
+    if (enableTangentSpace && hasTangentSpace)
+        features |= FEATURE_TANGENT_SPACE;
+    return features;
+}
+
+int Mesh::textureUnitFor(const std::string& type)
+{
+    if (type == "texture_diffuse" || type == "texture_albedo")
+        return 0;
+    if (type == "texture_normal")
+        return 1;
+    if (type == "texture_orm")
+        return 2;
+    return -1;
+}
+
+size_t Mesh::selectLod(const DrawView& view) const
+{
+    if (view.projectionScale <= 0.0f || lods.size() <= 1)
+        return 0;
+    
+    // 모델 행렬의 가장 큰 축 배율로 오차와 반지름을 월드 단위로 환산
+    const glm::mat4& model = view.model;
+    float scale = std::max(glm::length(glm::vec3(model[0])),
+                           std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+    glm::vec3 center = glm::vec3(model * glm::vec4(boundsCenter, 1.0f));
+    // 바운딩 구에서 카메라에 가장 가까운 점 기준 (구 안이면 가장 보수적인 거리 사용)
+    float distance = glm::length(center - view.cameraPosition) - boundsRadius * scale;
+    distance = std::max(distance, 1e-4f);
     
-    glBindVertexArray(0);
+    float pixelsPerUnit = view.projectionScale * scale / distance;
+    for (size_t level = lods.size() - 1; level > 0; level--)
+    {
+        if (lods[level].error * pixelsPerUnit <= view.maxPixelError)
+            return level;
+    }
+    return 0;
 }
 
-void Mesh::Draw(Shader &shader, bool enableTangentSpace)
+void Mesh::enqueue(RenderQueue& queue, uint32_t transform, bool enableTangentSpace, const DrawView& view,
+                   uint32_t instanceBatch)
 {
-    // 텍스처 타입별 플래그 및 유닛 번호 매핑
-    struct TextureBinding {
-        bool* hasFlag;
-        int textureUnit;
-        const char* shaderName;
-    };
+    if (!geometry.isValid())
+        return;
     
-    bool hasAlbedo = false;
-    bool hasNormal = false;
-    bool hasMetallic = false;
-    bool hasRoughness = false;
-    bool hasAo = false;
+    size_t level = selectLod(view);
+    const MeshLod& lod = lods[level];
+    size_t indexSize = indexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int);
     
-    // 한 번의 순회로 텍스처 체크 및 바인딩
-    for(unsigned int i = 0; i < textures.size(); i++)
+    drawCounts.clear();
+    drawOffsets.clear();
+    if (view.culling && level == 0 && !meshlets.empty())
     {
-        const std::string& name = textures[i].type;
-        int textureUnit = -1;
+        // 회전 + 균등 스케일이면 각도가 보존되므로 모델 공간에서 검사: 평면은 (viewProjection * model)에서 바로 뽑고
+        // 카메라는 역변환. 비균등 스케일(또는 기울임)이면 모델 공간의 원뿔이 월드의 법선 범위와 달라지므로
+        // 원뿔 검사는 끄고, 구는 월드 공간으로 옮겨 가장 큰 축 스케일만큼 반지름을 늘려 보수적으로 검사
+        glm::mat3 linear(view.model);
+        glm::mat3 gram = glm::transpose(linear) * linear;
+        float maxScale2 = std::max({ gram[0][0], gram[1][1], gram[2][2] });
+        float minScale2 = std::min({ gram[0][0], gram[1][1], gram[2][2] });
+        float tolerance = maxScale2 * 1e-4f;
+        bool conformal = maxScale2 - minScale2 <= tolerance && std::abs(gram[0][1]) <= tolerance &&
+                         std::abs(gram[0][2]) <= tolerance && std::abs(gram[1][2]) <= tolerance;
+        float maxScale = std::sqrt(maxScale2);
         
-        if(name == "texture_diffuse" || name == "texture_albedo")
-        {
-            hasAlbedo = true;
-            textureUnit = 0;
-        }
-        else if(name == "texture_normal")
-        {
-            hasNormal = true;
-            textureUnit = 1;
-        }
-        else if(name == "texture_metallic")
-        {
-            hasMetallic = true;
-            textureUnit = 2;
-        }
-        else if(name == "texture_roughness")
-        {
-            hasRoughness = true;
-            textureUnit = 3;
-        }
-        else if(name == "texture_ao")
-        {
-            hasAo = true;
-            textureUnit = 4;
-        }
-        
-        // 텍스처 바인딩
-        if (textureUnit >= 0)
+        Frustum frustum = Frustum::fromMatrix(conformal ? view.viewProjection * view.model : view.viewProjection);
+        glm::vec3 camera = glm::vec3(glm::inverse(view.model) * glm::vec4(view.cameraPosition, 1.0f));
+        size_t rangeEnd = 0;
+        for (const Meshlet& meshlet : meshlets)
         {
-            glActiveTexture(GL_TEXTURE0 + textureUnit);
-            glBindTexture(GL_TEXTURE_2D, textures[i].id);
+            if (conformal)
+            {
+                if (MeshletBuilder::isBackFacing(meshlet, camera) || !frustum.intersectsSphere(meshlet.center, meshlet.radius))
+                    continue;
+            }
+            else
+            {
+                glm::vec3 worldCenter = glm::vec3(view.model * glm::vec4(meshlet.center, 1.0f));
+                if (!frustum.intersectsSphere(worldCenter, meshlet.radius * maxScale))
+                    continue;
+            }
+            
+            // 연속된 메시렛은 구간 하나로 합침
+            GLsizei count = static_cast<GLsizei>(meshlet.triangleCount * 3);
+            if (!drawCounts.empty() && meshlet.indexOffset == rangeEnd)
+                drawCounts.back() += count;
+            else
+            {
+                drawCounts.push_back(count);
+                drawOffsets.push_back(reinterpret_cast<const void*>(geometry.indexOffset + meshlet.indexOffset * indexSize));
+            }
+            rangeEnd = meshlet.indexOffset + static_cast<size_t>(count);
         }
+        if (drawCounts.empty())
+            return;
     }
+    if (drawCounts.empty())
+    {
+        drawCounts.push_back(static_cast<GLsizei>(lod.indexCount));
+        drawOffsets.push_back(reinterpret_cast<const void*>(geometry.indexOffset + lod.indexOffset * indexSize));
+    }
+    
+    // 메시 필드: VAO(정점 포맷)가 같은 메시끼리, 그 안에서 같은 메시끼리 모음
+    const unsigned int meshIdBits = RenderSortKey::MESH_BITS - 2;
+    uint32_t meshId = static_cast<uint32_t>(hashBytes(reinterpret_cast<const unsigned char*>(&geometry.firstVertex),
+                                                      sizeof(geometry.firstVertex), geometry.indexOffset));
+    uint32_t meshKey = (geometry.layout << meshIdBits) | (meshId & ((1u << meshIdBits) - 1));
+    glm::vec3 center = glm::vec3(view.model * glm::vec4(boundsCenter, 1.0f));
+    unsigned int globalFeatures = view.shaderFeatures | (instanceBatch != NO_INSTANCE_BATCH ? FEATURE_INSTANCED : 0u);
+    unsigned int features = shaderFeatures(enableTangentSpace, globalFeatures);
+    uint64_t key = RenderSortKey::make(PASS_OPAQUE, features, materialKey, meshKey,
+                                       RenderSortKey::depth(glm::length(center - view.cameraPosition), PASS_OPAQUE));
+    queue.push(key, this, features, transform, instanceBatch, drawCounts.data(), drawOffsets.data(), drawCounts.size());
+}
+
+void Mesh::submit(Shader& shader, const MeshUniforms& uniforms, unsigned int features,
+                  const GLsizei* counts, const void* const* offsets, size_t rangeCount,
+                  const InstanceRange& instances)
+{
+    if (!geometry.isValid() || rangeCount == 0)
+        return;
     
-    // 셰이더에 텍스처 유닛 번호 설정
-    shader.setInt("albedoMap", 0);
-    shader.setInt("normalMap", 1);
-    shader.setInt("metallicMap", 2);
-    shader.setInt("roughnessMap", 3);
-    shader.setInt("aoMap", 4);
+    // 변형은 로드 시 고른 기능 비트로 정해지므로 기능 플래그 uniform은 올리지 않음
+    shader.use(features);
+    
+    // 같은 텍스처가 이미 그 유닛에 있으면 GLState가 건너뜀
+    for (const Texture& texture : textures)
+    {
+        int textureUnit = textureUnitFor(texture.type);
+        if (textureUnit >= 0)
+            GLState::instance().bindTexture(static_cast<GLuint>(textureUnit), texture.id);
+    }
     
-    shader.setBool("hasAlbedoMap", hasAlbedo);
-    shader.setBool("hasNormalMap", hasNormal);
-    shader.setBool("hasMetallicMap", hasMetallic);
-    shader.setBool("hasRoughnessMap", hasRoughness);
-    shader.setBool("hasAoMap", hasAo);
-    shader.setBool("useTangentSpace", enableTangentSpace && hasTangentSpace);
+    if (factors.enabled)
+    {
+        shader.set(uniforms.baseColorFactor, factors.baseColor);
+        shader.set(uniforms.metallicFactor, factors.metallic);
+        shader.set(uniforms.roughnessFactor, factors.roughness);
+    }
+    shader.set(uniforms.positionScale, positionScale);
+    shader.set(uniforms.positionOffset, positionOffset);
     
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    GLint baseVertex = static_cast<GLint>(geometry.firstVertex);
+    if (instances.count > 0)
+    {
+        // 하위 메시마다 복사본 전체를 드로 한 번으로
+        AssetManager::instance().geometry().bindInstances(geometry.layout, instances.buffer, instances.byteOffset);
+        for (size_t i = 0; i < rangeCount; i++)
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, counts[i], indexType, offsets[i], instances.count, baseVertex);
+        return;
+    }
     
-    glActiveTexture(GL_TEXTURE0);
+    // 같은 정점 포맷의 메시끼리는 VAO가 이미 바인딩되어 있음
+    AssetManager::instance().geometry().bind(geometry.layout);
+    if (rangeCount == 1)
+        glDrawElementsBaseVertex(GL_TRIANGLES, counts[0], indexType, offsets[0], baseVertex);
+    else
+    {
+        drawBaseVertices.assign(rangeCount, baseVertex);
+        glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts, indexType,
+                                      offsets, static_cast<GLsizei>(rangeCount), drawBaseVertices.data());
+    }
 }
@@ -0,0 +1,296 @@
+#include "../include/mesh_cache.h"
+#include "../include/hash_util.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x4D525042; // "BPRM"
+constexpr size_t DATA_ALIGNMENT = 16;
+constexpr uint32_t MESH_FLAG_TANGENT_SPACE = 1u << 0;
+constexpr uint32_t MESH_FLAG_MATERIAL_FACTORS = 1u << 1;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t vertexSize;
+    uint32_t meshCount;
+};
+
+struct MeshRecord {
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint64_t textureOffset;
+    uint64_t lodOffset;
+    uint64_t meshletOffset;
+    uint32_t vertexCount;
+    uint32_t indexCount;  // 모든 LOD 합계
+    uint32_t materialIndex;
+    uint32_t flags;
+    uint32_t textureCount;
+    uint32_t lodCount;
+    uint32_t meshletCount;
+    // glTF 머티리얼 계수 (MESH_FLAG_MATERIAL_FACTORS일 때만 의미 있음)
+    float baseColorFactor[3];
+    float metallicFactor;
+    float roughnessFactor;
+};
+
+size_t alignUp(size_t value)
+{
+    return (value + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+}
+
+void appendString(std::string& out, const std::string& value)
+{
+    uint32_t length = static_cast<uint32_t>(value.size());
+    out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.append(value);
+}
+
+bool readString(const unsigned char* data, size_t size, size_t& offset, std::string& out)
+{
+    uint32_t length;
+    if (offset + sizeof(length) > size)
+        return false;
+    std::memcpy(&length, data + offset, sizeof(length));
+    offset += sizeof(length);
+    if (offset + length > size)
+        return false;
+    out.assign(reinterpret_cast<const char*>(data + offset), length);
+    offset += length;
+    return true;
+}
+
+} // namespace
+
+std::string MeshCache::pathFor(const std::string& sourcePath)
+{
+    return sourcePath + ".meshcache";
+}
+
+uint64_t MeshCache::computeKey(const std::string& sourcePath, unsigned int importFlags, uint64_t settingsSeed)
+{
+    MappedFile source;
+    if (!source.open(sourcePath))
+        return 0;
+    
+    uint64_t seed = (0xCBF29CE484222325ull ^ (static_cast<uint64_t>(VERSION) << 32) ^ importFlags) + settingsSeed;
+    uint64_t key = hashBytes(source.data(), source.size(), seed);
+    return key != 0 ? key : 1;
+}
+
+bool MeshCache::save(const std::string& cachePath, uint64_t key, const std::vector<Mesh>& meshes)
+{
+    std::vector<MeshRecord> records(meshes.size());
+    std::string strings;
+    
+    size_t stringsOffset = sizeof(FileHeader) + records.size() * sizeof(MeshRecord);
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+        records[i].textureOffset = stringsOffset + strings.size();
+        records[i].textureCount = static_cast<uint32_t>(meshes[i].textures.size());
+        for (const Texture& texture : meshes[i].textures)
+        {
+            appendString(strings, texture.type);
+            appendString(strings, texture.path);
+        }
+        // LOD 표도 문자열 영역에 이어서 저장 (정렬되지 않으므로 읽을 때 복사)
+        records[i].lodOffset = stringsOffset + strings.size();
+        records[i].lodCount = static_cast<uint32_t>(meshes[i].lods.size());
+        strings.append(reinterpret_cast<const char*>(meshes[i].lods.data()), meshes[i].lods.size() * sizeof(MeshLod));
+        records[i].meshletOffset = stringsOffset + strings.size();
+        records[i].meshletCount = static_cast<uint32_t>(meshes[i].meshlets.size());
+        strings.append(reinterpret_cast<const char*>(meshes[i].meshlets.data()),
+                       meshes[i].meshlets.size() * sizeof(Meshlet));
+    }
+    
+    // 정점/인덱스 배열은 정렬된 위치에 두어 매핑 후 그대로 포인터로 사용
+    size_t offset = alignUp(stringsOffset + strings.size());
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+        const Mesh& mesh = meshes[i];
+        MeshRecord& record = records[i];
+        record.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        record.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        record.materialIndex = mesh.materialIndex;
+        record.flags = (mesh.hasTangentSpace ? MESH_FLAG_TANGENT_SPACE : 0) |
+                       (mesh.factors.enabled ? MESH_FLAG_MATERIAL_FACTORS : 0);
+        for (int c = 0; c < 3; c++)
+            record.baseColorFactor[c] = mesh.factors.baseColor[c];
+        record.metallicFactor = mesh.factors.metallic;
+        record.roughnessFactor = mesh.factors.roughness;
+        record.vertexOffset = offset;
+        offset = alignUp(offset + mesh.vertices.size() * sizeof(Vertex));
+        record.indexOffset = offset;
+        offset = alignUp(offset + mesh.indices.size() * sizeof(unsigned int));
+    }
+    
+    FileHeader header;
+    header.magic = CACHE_MAGIC;
+    header.version = VERSION;
+    header.key = key;
+    header.vertexSize = sizeof(Vertex);
+    header.meshCount = static_cast<uint32_t>(meshes.size());
+    
+    // 다른 프로세스가 동시에 읽어도 반쯤 쓴 파일을 보지 않도록 임시 파일에 쓴 뒤 교체
+    std::string tempPath = cachePath + ".tmp" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cout << "  Mesh cache: cannot write " << tempPath << std::endl;
+            return false;
+        }
+        
+        static const char padding[DATA_ALIGNMENT] = {};
+        size_t written = 0;
+        auto writeBytes = [&](const void* data, size_t size) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            written += size;
+        };
+        auto padTo = [&](size_t target) {
+            if (target > written)
+                writeBytes(padding, target - written);
+        };
+        
+        writeBytes(&header, sizeof(header));
+        writeBytes(records.data(), records.size() * sizeof(MeshRecord));
+        writeBytes(strings.data(), strings.size());
+        for (size_t i = 0; i < meshes.size(); i++)
+        {
+            padTo(records[i].vertexOffset);
+            writeBytes(meshes[i].vertices.data(), meshes[i].vertices.size() * sizeof(Vertex));
+            padTo(records[i].indexOffset);
+            writeBytes(meshes[i].indices.data(), meshes[i].indices.size() * sizeof(unsigned int));
+        }
+        padTo(offset);
+        
+        if (!out)
+        {
+            out.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    
+    std::remove(cachePath.c_str());
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    
+    std::cout << "  Mesh cache written: " << cachePath << std::endl;
+    return true;
+}
+
+bool MeshCache::load(const std::string& cachePath, uint64_t key)
+{
+    meshEntries.clear();
+    if (!file.open(cachePath))
+        return false;
+    
+    const unsigned char* data = file.data();
+    size_t size = file.size();
+    
+    FileHeader header;
+    if (size < sizeof(header))
+        return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != CACHE_MAGIC || header.version != VERSION ||
+        header.key != key || header.vertexSize != sizeof(Vertex))
+    {
+        std::cout << "  Mesh cache stale, re-importing: " << cachePath << std::endl;
+        file.close();
+        return false;
+    }
+    
+    size_t recordsEnd = sizeof(header) + static_cast<size_t>(header.meshCount) * sizeof(MeshRecord);
+    if (recordsEnd > size)
+    {
+        file.close();
+        return false;
+    }
+    
+    meshEntries.reserve(header.meshCount);
+    for (uint32_t i = 0; i < header.meshCount; i++)
+    {
+        MeshRecord record;
+        std::memcpy(&record, data + sizeof(header) + i * sizeof(MeshRecord), sizeof(record));
+        
+        uint64_t vertexBytes = static_cast<uint64_t>(record.vertexCount) * sizeof(Vertex);
+        uint64_t indexBytes = static_cast<uint64_t>(record.indexCount) * sizeof(unsigned int);
+        if (record.vertexOffset % DATA_ALIGNMENT != 0 || record.indexOffset % DATA_ALIGNMENT != 0 ||
+            record.vertexOffset + vertexBytes > size || record.indexOffset + indexBytes > size)
+        {
+            meshEntries.clear();
+            file.close();
+            return false;
+        }
+        
+        MeshEntry entry;
+        entry.vertices = reinterpret_cast<const Vertex*>(data + record.vertexOffset);
+        entry.vertexCount = record.vertexCount;
+        entry.indices = reinterpret_cast<const unsigned int*>(data + record.indexOffset);
+        entry.indexCount = record.indexCount;
+        entry.materialIndex = record.materialIndex;
+        entry.hasTangentSpace = (record.flags & MESH_FLAG_TANGENT_SPACE) != 0;
+        entry.factors.enabled = (record.flags & MESH_FLAG_MATERIAL_FACTORS) != 0;
+        entry.factors.baseColor = glm::vec3(record.baseColorFactor[0], record.baseColorFactor[1], record.baseColorFactor[2]);
+        entry.factors.metallic = record.metallicFactor;
+        entry.factors.roughness = record.roughnessFactor;
+        
+        size_t stringOffset = static_cast<size_t>(record.textureOffset);
+        for (uint32_t t = 0; t < record.textureCount; t++)
+        {
+            TextureEntry texture;
+            if (!readString(data, size, stringOffset, texture.type) ||
+                !readString(data, size, stringOffset, texture.path))
+            {
+                meshEntries.clear();
+                file.close();
+                return false;
+            }
+            entry.textures.push_back(texture);
+        }
+        
+        uint64_t lodBytes = static_cast<uint64_t>(record.lodCount) * sizeof(MeshLod);
+        if (record.lodOffset + lodBytes > size)
+        {
+            meshEntries.clear();
+            file.close();
+            return false;
+        }
+        entry.lods.resize(record.lodCount);
+        std::memcpy(entry.lods.data(), data + record.lodOffset, lodBytes);
+        for (const MeshLod& lod : entry.lods)
+        {
+            if (static_cast<uint64_t>(lod.indexOffset) + lod.indexCount > record.indexCount)
+            {
+                meshEntries.clear();
+                file.close();
+                return false;
+            }
+        }
+        
+        uint64_t meshletBytes = static_cast<uint64_t>(record.meshletCount) * sizeof(Meshlet);
+        if (record.meshletOffset + meshletBytes > size)
+        {
+            meshEntries.clear();
+            file.close();
+            return false;
+        }
+        entry.meshlets.resize(record.meshletCount);
+        std::memcpy(entry.meshlets.data(), data + record.meshletOffset, meshletBytes);
+        
+        meshEntries.push_back(entry);
+    }
+    
+    return true;
+}
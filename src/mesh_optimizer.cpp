@@ -0,0 +1,447 @@
+#include "../include/mesh_optimizer.h"
+#include "../include/hash_util.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+constexpr unsigned int INVALID_INDEX = ~0u;
+
+// Forsyth "Linear-Speed Vertex Cache Optimisation" 점수 함수 상수
+constexpr int FORSYTH_CACHE_SIZE = 32;
+constexpr float CACHE_DECAY_POWER = 1.5f;
+constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float VALENCE_BOOST_SCALE = 2.0f;
+constexpr float VALENCE_BOOST_POWER = 0.5f;
+constexpr unsigned int VALENCE_TABLE_SIZE = 64;
+
+struct ForsythTables {
+    float cache[FORSYTH_CACHE_SIZE];
+    float valence[VALENCE_TABLE_SIZE];
+    
+    ForsythTables()
+    {
+        for (int i = 0; i < FORSYTH_CACHE_SIZE; i++)
+        {
+            // 직전 삼각형의 세 정점은 고정 점수 (바로 다시 쓰는 것보다 주변으로 퍼지는 편이 유리)
+            if (i < 3)
+                cache[i] = LAST_TRIANGLE_SCORE;
+            else
+                cache[i] = std::pow(1.0f - static_cast<float>(i - 3) / (FORSYTH_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+        }
+        valence[0] = 0.0f;
+        for (unsigned int i = 1; i < VALENCE_TABLE_SIZE; i++)
+            valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+    }
+};
+
+const ForsythTables& forsythTables()
+{
+    static const ForsythTables tables;
+    return tables;
+}
+
+// 남은 삼각형이 적은 정점일수록 점수를 높여 고립된 삼각형이 남지 않게 함
+float vertexScore(int cachePosition, unsigned int remaining)
+{
+    if (remaining == 0)
+        return -1.0f;
+    const ForsythTables& tables = forsythTables();
+    float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+    if (remaining < VALENCE_TABLE_SIZE)
+        score += tables.valence[remaining];
+    else
+        score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining), -VALENCE_BOOST_POWER);
+    return score;
+}
+
+// 정점별로 인접 삼각형 목록을 한 배열에 연속 저장
+struct Adjacency {
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> counts;
+    std::vector<unsigned int> triangles;
+    
+    Adjacency(const std::vector<unsigned int>& indices, size_t vertexCount)
+        : offsets(vertexCount + 1, 0), counts(vertexCount, 0), triangles(indices.size())
+    {
+        for (unsigned int index : indices)
+            counts[index]++;
+        for (size_t v = 0; v < vertexCount; v++)
+            offsets[v + 1] = offsets[v] + counts[v];
+        std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+            triangles[cursor[indices[i]]++] = static_cast<unsigned int>(i / 3);
+    }
+    
+    // 출력된 삼각형을 정점의 남은 목록에서 제거 (순서는 중요하지 않음)
+    void remove(unsigned int vertex, unsigned int triangle)
+    {
+        unsigned int* begin = triangles.data() + offsets[vertex];
+        unsigned int* end = begin + counts[vertex];
+        unsigned int* found = std::find(begin, end, triangle);
+        if (found != end)
+        {
+            *found = *(end - 1);
+            counts[vertex]--;
+        }
+    }
+};
+
+// FIFO 캐시 시뮬레이터: 미스 때만 시각이 흐르므로 (현재 시각 - 들어온 시각) < 크기면 캐시에 있음
+class FifoCache {
+public:
+    FifoCache(size_t vertexCount, unsigned int size)
+        : size(size), timestamps(vertexCount, 0), time(size + 1) {}
+    
+    // 미스면 true
+    bool access(unsigned int vertex)
+    {
+        if (time - timestamps[vertex] <= size)
+            return false;
+        timestamps[vertex] = time++;
+        return true;
+    }
+    
+    void flush() { time += size + 1; }
+    
+private:
+    size_t size;
+    std::vector<size_t> timestamps;
+    size_t time;
+};
+
+struct VertexKeyHash {
+    const Vertex* vertices;
+    
+    uint64_t operator()(unsigned int index) const
+    {
+        return hashBytes(reinterpret_cast<const unsigned char*>(&vertices[index]), sizeof(Vertex), 0);
+    }
+};
+
+} // namespace
+
+void MeshOptimizationReport::add(const MeshOptimizationReport& other)
+{
+    triangles += other.triangles;
+    verticesBefore += other.verticesBefore;
+    verticesAfter += other.verticesAfter;
+    transformedBefore += other.transformedBefore;
+    transformedAfter += other.transformedAfter;
+}
+
+float MeshOptimizationReport::acmrBefore() const
+{
+    return triangles > 0 ? static_cast<float>(transformedBefore) / triangles : 0.0f;
+}
+
+float MeshOptimizationReport::acmrAfter() const
+{
+    return triangles > 0 ? static_cast<float>(transformedAfter) / triangles : 0.0f;
+}
+
+// 용접 전 배열은 정점이 중복되어 있으므로 두 값 모두 용접 후 고유 정점 수 기준 (이상값 1.0)
+float MeshOptimizationReport::atvrBefore() const
+{
+    return verticesAfter > 0 ? static_cast<float>(transformedBefore) / verticesAfter : 0.0f;
+}
+
+float MeshOptimizationReport::atvrAfter() const
+{
+    return verticesAfter > 0 ? static_cast<float>(transformedAfter) / verticesAfter : 0.0f;
+}
+
+namespace MeshOptimizer {
+
+MeshOptimizerSettings& settings()
+{
+    static MeshOptimizerSettings instance;
+    return instance;
+}
+
+uint64_t settingsSeed(const MeshOptimizerSettings& settings)
+{
+    unsigned char bytes[sizeof(bool) + sizeof(float)];
+    std::memcpy(bytes, &settings.enabled, sizeof(bool));
+    std::memcpy(bytes + sizeof(bool), &settings.overdrawThreshold, sizeof(float));
+    return hashBytes(bytes, sizeof(bytes), 0x6D6F7074ull);
+}
+
+MeshOptimizationReport optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                const MeshOptimizerSettings& settings)
+{
+    MeshOptimizationReport report;
+    report.triangles = indices.size() / 3;
+    report.verticesBefore = vertices.size();
+    report.transformedBefore = countTransformedVertices(indices, vertices.size(), settings.analysisCacheSize);
+    
+    if (settings.enabled && !indices.empty())
+    {
+        weldVertices(vertices, indices);
+        optimizeVertexCache(indices, vertices.size());
+        optimizeOverdraw(indices, vertices, settings.overdrawThreshold, settings.analysisCacheSize);
+        optimizeVertexFetch(vertices, indices);
+    }
+    
+    report.verticesAfter = vertices.size();
+    report.transformedAfter = countTransformedVertices(indices, vertices.size(), settings.analysisCacheSize);
+    return report;
+}
+
+size_t weldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+    size_t vertexCount = vertices.size();
+    if (vertexCount == 0)
+        return 0;
+    
+    // 개방 주소법 해시 테이블 (부하율 50% 이하)
+    size_t tableSize = 1;
+    while (tableSize < vertexCount * 2)
+        tableSize <<= 1;
+    std::vector<unsigned int> table(tableSize, INVALID_INDEX);
+    VertexKeyHash hasher{vertices.data()};
+    
+    std::vector<unsigned int> remap(vertexCount);
+    size_t unique = 0;
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        size_t slot = hasher(static_cast<unsigned int>(v)) & (tableSize - 1);
+        for (;;)
+        {
+            unsigned int existing = table[slot];
+            if (existing == INVALID_INDEX)
+            {
+                // 첫 등장: 앞쪽 빈자리로 당겨서 저장
+                table[slot] = static_cast<unsigned int>(unique);
+                remap[v] = static_cast<unsigned int>(unique);
+                vertices[unique] = vertices[v];
+                unique++;
+                break;
+            }
+            if (std::memcmp(&vertices[existing], &vertices[v], sizeof(Vertex)) == 0)
+            {
+                remap[v] = existing;
+                break;
+            }
+            slot = (slot + 1) & (tableSize - 1);
+        }
+    }
+    
+    vertices.resize(unique);
+    for (unsigned int& index : indices)
+        index = remap[index];
+    return unique;
+}
+
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+    
+    Adjacency adjacency(indices, vertexCount);
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+        vertexScores[v] = vertexScore(-1, adjacency.counts[v]);
+    
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; t++)
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+    
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+    std::vector<unsigned int> cache, nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+    
+    size_t best = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+    size_t scanCursor = 0;
+    for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+    {
+        // 캐시 주변에 후보가 없으면 아직 남은 삼각형 중 입력 순서상 첫 번째로 재시작
+        if (best == SIZE_MAX)
+        {
+            while (emitted[scanCursor])
+                scanCursor++;
+            best = scanCursor;
+        }
+        
+        const unsigned int* triangle = &indices[best * 3];
+        emitted[best] = true;
+        nextCache.clear();
+        for (int k = 0; k < 3; k++)
+        {
+            output.push_back(triangle[k]);
+            adjacency.remove(triangle[k], static_cast<unsigned int>(best));
+            nextCache.push_back(triangle[k]);
+        }
+        for (unsigned int vertex : cache)
+        {
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                nextCache.push_back(vertex);
+        }
+        
+        // 캐시 밖으로 밀려난 정점까지 포함해 점수 갱신
+        for (size_t i = 0; i < nextCache.size(); i++)
+        {
+            unsigned int vertex = nextCache[i];
+            cachePosition[vertex] = i < static_cast<size_t>(FORSYTH_CACHE_SIZE) ? static_cast<int>(i) : -1;
+            vertexScores[vertex] = vertexScore(cachePosition[vertex], adjacency.counts[vertex]);
+        }
+        
+        best = SIZE_MAX;
+        float bestScore = -1.0f;
+        for (unsigned int vertex : nextCache)
+        {
+            const unsigned int* live = adjacency.triangles.data() + adjacency.offsets[vertex];
+            for (unsigned int j = 0; j < adjacency.counts[vertex]; j++)
+            {
+                unsigned int t = live[j];
+                float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] +
+                              vertexScores[indices[t * 3 + 2]];
+                triangleScores[t] = score;
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+        
+        if (nextCache.size() > static_cast<size_t>(FORSYTH_CACHE_SIZE))
+            nextCache.resize(FORSYTH_CACHE_SIZE);
+        cache.swap(nextCache);
+    }
+    
+    indices.swap(output);
+}
+
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+                      float threshold, unsigned int cacheSize)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+        return;
+    
+    // 1) 캐시 순서를 유지한 채 클러스터로 나눔 (Sander et al. 2007)
+    //    하드 경계: 세 정점이 모두 미스인 삼각형 (이미 캐시가 끊긴 지점이라 순서를 바꿔도 손해 없음)
+    std::vector<size_t> hardStarts;
+    size_t totalMisses = 0;
+    {
+        FifoCache cache(vertices.size(), cacheSize);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            int misses = 0;
+            for (int k = 0; k < 3; k++)
+                misses += cache.access(indices[t * 3 + k]) ? 1 : 0;
+            if (t == 0 || misses == 3)
+                hardStarts.push_back(t);
+            totalMisses += misses;
+        }
+    }
+    hardStarts.push_back(triangleCount);
+    
+    //    소프트 경계: 클러스터 내 ACMR이 전체 ACMR * threshold 이하로 떨어지면 분할
+    float targetAcmr = static_cast<float>(totalMisses) / triangleCount * threshold;
+    std::vector<size_t> clusterStarts;
+    FifoCache cache(vertices.size(), cacheSize);
+    for (size_t h = 0; h + 1 < hardStarts.size(); h++)
+    {
+        size_t clusterMisses = 0, clusterTriangles = 0;
+        clusterStarts.push_back(hardStarts[h]);
+        cache.flush();
+        for (size_t t = hardStarts[h]; t < hardStarts[h + 1]; t++)
+        {
+            for (int k = 0; k < 3; k++)
+                clusterMisses += cache.access(indices[t * 3 + k]) ? 1 : 0;
+            clusterTriangles++;
+            if (t + 1 < hardStarts[h + 1] && static_cast<float>(clusterMisses) <= targetAcmr * clusterTriangles)
+            {
+                clusterStarts.push_back(t + 1);
+                clusterMisses = clusterTriangles = 0;
+                cache.flush();
+            }
+        }
+    }
+    size_t clusterCount = clusterStarts.size();
+    clusterStarts.push_back(triangleCount);
+    
+    // 2) 클러스터별 면적 가중 중심과 평균 법선. 메시 중심에서 바깥을 향하는 클러스터일수록
+    //    다른 면을 가릴 가능성이 높으므로 먼저 그림 (시점 독립 근사)
+    std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+    std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+    std::vector<float> areas(clusterCount, 0.0f);
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        for (size_t t = clusterStarts[c]; t < clusterStarts[c + 1]; t++)
+        {
+            const glm::vec3& a = vertices[indices[t * 3]].Position;
+            const glm::vec3& b = vertices[indices[t * 3 + 1]].Position;
+            const glm::vec3& d = vertices[indices[t * 3 + 2]].Position;
+            glm::vec3 normal = glm::cross(b - a, d - a);
+            float area = glm::length(normal);
+            glm::vec3 center = (a + b + d) / 3.0f;
+            centroids[c] += center * area;
+            normals[c] += normal;
+            areas[c] += area;
+        }
+        meshCentroid += centroids[c];
+        meshArea += areas[c];
+    }
+    if (meshArea > 0.0f)
+        meshCentroid = meshCentroid / meshArea;
+    
+    std::vector<float> sortKeys(clusterCount, 0.0f);
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        float normalLength = glm::length(normals[c]);
+        if (areas[c] <= 0.0f || normalLength <= 0.0f)
+            continue;
+        glm::vec3 centroid = centroids[c] / areas[c];
+        sortKeys[c] = glm::dot(centroid - meshCentroid, normals[c] / normalLength);
+    }
+    
+    std::vector<size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+    
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+    for (size_t c : order)
+        output.insert(output.end(), indices.begin() + clusterStarts[c] * 3, indices.begin() + clusterStarts[c + 1] * 3);
+    indices.swap(output);
+}
+
+void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+    std::vector<unsigned int> remap(vertices.size(), INVALID_INDEX);
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+    for (unsigned int& index : indices)
+    {
+        if (remap[index] == INVALID_INDEX)
+        {
+            remap[index] = static_cast<unsigned int>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(reordered);
+}
+
+size_t countTransformedVertices(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize)
+{
+    FifoCache cache(vertexCount, cacheSize);
+    size_t misses = 0;
+    for (unsigned int index : indices)
+        misses += cache.access(index) ? 1 : 0;
+    return misses;
+}
+
+} // namespace MeshOptimizer
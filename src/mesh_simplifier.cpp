@@ -0,0 +1,326 @@
+#include "../include/mesh_simplifier.h"
+#include "../include/hash_util.h"
+#include "../include/mesh_optimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+// 평면까지 거리 제곱의 가중합 (Garland & Heckbert)
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+    double weight = 0;
+    
+    void addPlane(const glm::vec3& normal, float distance, double w)
+    {
+        double a = normal.x, b = normal.y, c = normal.z, d = distance;
+        a2 += w * a * a; ab += w * a * b; ac += w * a * c; ad += w * a * d;
+        b2 += w * b * b; bc += w * b * c; bd += w * b * d;
+        c2 += w * c * c; cd += w * c * d;
+        d2 += w * d * d;
+        weight += w;
+    }
+    
+    void add(const Quadric& other)
+    {
+        a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+        b2 += other.b2; bc += other.bc; bd += other.bd;
+        c2 += other.c2; cd += other.cd;
+        d2 += other.d2;
+        weight += other.weight;
+    }
+    
+    // 평균 거리 제곱
+    double evaluate(const glm::vec3& p) const
+    {
+        double x = p.x, y = p.y, z = p.z;
+        double error = a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x +
+                       b2 * y * y + 2 * bc * y * z + 2 * bd * y +
+                       c2 * z * z + 2 * cd * z +
+                       d2;
+        return weight > 0 ? std::max(error, 0.0) / weight : 0.0;
+    }
+};
+
+struct Collapse {
+    unsigned int from;
+    unsigned int to;
+    double cost;
+};
+
+uint64_t edgeKey(unsigned int a, unsigned int b)
+{
+    if (a > b)
+        std::swap(a, b);
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+class Simplifier {
+public:
+    Simplifier(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+        : positions(vertices.size()), quadrics(vertices.size()), locked(vertices.size(), false), current(indices)
+    {
+        for (size_t v = 0; v < vertices.size(); v++)
+            positions[v] = vertices[v].Position;
+        
+        for (size_t t = 0; t + 2 < current.size(); t += 3)
+        {
+            const glm::vec3& a = positions[current[t]];
+            glm::vec3 normal = glm::cross(positions[current[t + 1]] - a, positions[current[t + 2]] - a);
+            float length = glm::length(normal);
+            if (length <= 0.0f)
+                continue;
+            normal = normal / length;
+            // 면적 가중
+            for (int k = 0; k < 3; k++)
+                quadrics[current[t + k]].addPlane(normal, -glm::dot(normal, a), length * 0.5);
+        }
+        
+        lockSeamsAndBorders(vertices);
+    }
+    
+    size_t triangleCount() const { return current.size() / 3; }
+    const std::vector<unsigned int>& indices() const { return current; }
+    float error() const { return static_cast<float>(std::sqrt(maxCost)); }
+    
+    // 목표 삼각형 수에 닿거나 더 축약할 수 없을 때까지 여러 패스 반복
+    void reduceTo(size_t targetTriangles, float maxError)
+    {
+        double maxErrorSquared = static_cast<double>(maxError) * maxError;
+        while (triangleCount() > targetTriangles)
+        {
+            if (!runPass(targetTriangles, maxErrorSquared))
+                break;
+        }
+    }
+    
+private:
+    std::vector<glm::vec3> positions;
+    std::vector<Quadric> quadrics;
+    std::vector<bool> locked;
+    std::vector<unsigned int> current;
+    double maxCost = 0.0;
+    
+    // 축약 중 이음새가 벌어지지 않도록 위치를 공유하는 다른 정점(UV/노말 이음새)이 있거나
+    // 한 삼각형만 쓰는 에지(열린 경계, 또는 이음새로 갈라진 에지) 위의 정점은 고정
+    void lockSeamsAndBorders(const std::vector<Vertex>& vertices)
+    {
+        std::unordered_map<uint64_t, unsigned int> positionOwners;
+        positionOwners.reserve(vertices.size());
+        for (size_t v = 0; v < vertices.size(); v++)
+        {
+            uint64_t key = hashBytes(reinterpret_cast<const unsigned char*>(&positions[v]), sizeof(glm::vec3), 0);
+            auto inserted = positionOwners.emplace(key, static_cast<unsigned int>(v));
+            if (!inserted.second && std::memcmp(&positions[inserted.first->second], &positions[v], sizeof(glm::vec3)) == 0)
+            {
+                locked[v] = true;
+                locked[inserted.first->second] = true;
+            }
+        }
+        
+        std::unordered_map<uint64_t, unsigned int> edgeUses;
+        edgeUses.reserve(current.size());
+        for (size_t t = 0; t + 2 < current.size(); t += 3)
+        {
+            for (int k = 0; k < 3; k++)
+                edgeUses[edgeKey(current[t + k], current[t + (k + 1) % 3])]++;
+        }
+        for (const auto& edge : edgeUses)
+        {
+            if (edge.second != 2)
+            {
+                locked[static_cast<unsigned int>(edge.first >> 32)] = true;
+                locked[static_cast<unsigned int>(edge.first & 0xFFFFFFFFu)] = true;
+            }
+        }
+    }
+    
+    // from을 to 위치로 옮겼을 때 뒤집히거나 거의 접히는 삼각형이 있는지
+    bool flips(unsigned int from, unsigned int to, const std::vector<unsigned int>& offsets,
+               const std::vector<unsigned int>& adjacency) const
+    {
+        for (unsigned int i = offsets[from]; i < offsets[from + 1]; i++)
+        {
+            const unsigned int* triangle = &current[adjacency[i] * 3];
+            if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                continue;
+            glm::vec3 before[3], after[3];
+            for (int k = 0; k < 3; k++)
+            {
+                before[k] = positions[triangle[k]];
+                after[k] = triangle[k] == from ? positions[to] : before[k];
+            }
+            glm::vec3 n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+            glm::vec3 n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+            if (glm::dot(n0, n1) <= 0.25f * glm::length(n0) * glm::length(n1))
+                return true;
+        }
+        return false;
+    }
+    
+    bool runPass(size_t targetTriangles, double maxErrorSquared)
+    {
+        size_t vertexCount = positions.size();
+        std::vector<unsigned int> offsets(vertexCount + 1, 0);
+        for (unsigned int index : current)
+            offsets[index + 1]++;
+        for (size_t v = 0; v < vertexCount; v++)
+            offsets[v + 1] += offsets[v];
+        std::vector<unsigned int> adjacency(current.size());
+        {
+            std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < current.size(); i++)
+                adjacency[cursor[current[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+        
+        std::vector<Collapse> candidates;
+        candidates.reserve(current.size() * 2);
+        for (size_t t = 0; t + 2 < current.size(); t += 3)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                unsigned int a = current[t + k];
+                unsigned int b = current[t + (k + 1) % 3];
+                if (!locked[a])
+                    candidates.push_back({a, b, quadrics[a].evaluate(positions[b])});
+                if (!locked[b])
+                    candidates.push_back({b, a, quadrics[b].evaluate(positions[a])});
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+        
+        // 한 패스 안에서는 축약된 정점 주변을 건드리지 않아 뒤집힘 검사가 유효하게 유지됨
+        std::vector<bool> busy(vertexCount, false);
+        std::vector<unsigned int> remap(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+            remap[v] = static_cast<unsigned int>(v);
+        
+        size_t triangles = triangleCount();
+        size_t collapses = 0;
+        for (const Collapse& collapse : candidates)
+        {
+            if (collapse.cost > maxErrorSquared || triangles <= targetTriangles)
+                break;
+            if (busy[collapse.from] || busy[collapse.to] || flips(collapse.from, collapse.to, offsets, adjacency))
+                continue;
+            
+            for (unsigned int i = offsets[collapse.from]; i < offsets[collapse.from + 1]; i++)
+            {
+                const unsigned int* triangle = &current[adjacency[i] * 3];
+                if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                    triangles--;
+                for (int k = 0; k < 3; k++)
+                    busy[triangle[k]] = true;
+            }
+            remap[collapse.from] = collapse.to;
+            quadrics[collapse.to].add(quadrics[collapse.from]);
+            maxCost = std::max(maxCost, collapse.cost);
+            collapses++;
+        }
+        
+        if (collapses == 0)
+            return false;
+        
+        // 축약 적용 후 퇴화 삼각형 제거
+        size_t write = 0;
+        for (size_t t = 0; t + 2 < current.size(); t += 3)
+        {
+            unsigned int a = remap[current[t]], b = remap[current[t + 1]], c = remap[current[t + 2]];
+            if (a == b || b == c || c == a)
+                continue;
+            current[write++] = a;
+            current[write++] = b;
+            current[write++] = c;
+        }
+        current.resize(write);
+        return true;
+    }
+};
+
+float boundingRadius(const std::vector<Vertex>& vertices)
+{
+    if (vertices.empty())
+        return 0.0f;
+    glm::vec3 minimum = vertices[0].Position, maximum = vertices[0].Position;
+    for (const Vertex& vertex : vertices)
+    {
+        minimum = glm::min(minimum, vertex.Position);
+        maximum = glm::max(maximum, vertex.Position);
+    }
+    return glm::length(maximum - minimum) * 0.5f;
+}
+
+} // namespace
+
+namespace MeshSimplifier {
+
+LodSettings& settings()
+{
+    static LodSettings instance;
+    return instance;
+}
+
+uint64_t settingsSeed(const LodSettings& settings)
+{
+    unsigned char bytes[sizeof(bool) + sizeof(unsigned int) + sizeof(float) * 2 + sizeof(uint64_t)];
+    uint64_t minTriangles = settings.minTriangles;
+    size_t offset = 0;
+    std::memcpy(bytes + offset, &settings.enabled, sizeof(bool)); offset += sizeof(bool);
+    std::memcpy(bytes + offset, &settings.maxLevels, sizeof(unsigned int)); offset += sizeof(unsigned int);
+    std::memcpy(bytes + offset, &settings.reduction, sizeof(float)); offset += sizeof(float);
+    std::memcpy(bytes + offset, &settings.maxRelativeError, sizeof(float)); offset += sizeof(float);
+    std::memcpy(bytes + offset, &minTriangles, sizeof(uint64_t));
+    return hashBytes(bytes, sizeof(bytes), 0x6C6F64ull);
+}
+
+std::vector<MeshLod> buildLodChain(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                   const LodSettings& settings)
+{
+    std::vector<MeshLod> lods;
+    lods.push_back({0, static_cast<unsigned int>(indices.size()), 0.0f});
+    if (!settings.enabled || indices.size() / 3 <= settings.minTriangles)
+        return lods;
+    
+    float maxError = boundingRadius(vertices) * settings.maxRelativeError;
+    Simplifier simplifier(vertices, indices);
+    size_t previousTriangles = indices.size() / 3;
+    float target = static_cast<float>(previousTriangles);
+    for (unsigned int level = 0; level < settings.maxLevels; level++)
+    {
+        target *= settings.reduction;
+        if (target < settings.minTriangles)
+            break;
+        simplifier.reduceTo(static_cast<size_t>(target), maxError);
+        
+        // 고정된 정점 때문에 더 줄지 않으면 거의 같은 레벨을 중복 저장하지 않음
+        size_t triangles = simplifier.triangleCount();
+        if (triangles == 0 || triangles > previousTriangles * 4 / 5)
+            break;
+        
+        std::vector<unsigned int> levelIndices = simplifier.indices();
+        MeshOptimizer::optimizeVertexCache(levelIndices, vertices.size());
+        lods.push_back({static_cast<unsigned int>(indices.size()), static_cast<unsigned int>(levelIndices.size()),
+                        simplifier.error()});
+        indices.insert(indices.end(), levelIndices.begin(), levelIndices.end());
+        previousTriangles = triangles;
+    }
+    return lods;
+}
+
+std::vector<unsigned int> simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                                   size_t targetIndexCount, float maxError, float* resultError)
+{
+    Simplifier simplifier(vertices, indices);
+    simplifier.reduceTo(targetIndexCount / 3, maxError);
+    if (resultError)
+        *resultError = simplifier.error();
+    return simplifier.indices();
+}
+
+} // namespace MeshSimplifier
@@ -0,0 +1,192 @@
+#include "../include/meshlet.h"
+#include "../include/hash_util.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr unsigned int INVALID_INDEX = ~0u;
+// 원뿔이 반구보다 넓으면 뒷면 판정이 불가능하므로 이 값으로 표시
+constexpr float NO_CONE_CULLING = 2.0f;
+
+glm::vec3 triangleNormal(const std::vector<Vertex>& vertices, const unsigned int* triangle)
+{
+    const glm::vec3& a = vertices[triangle[0]].Position;
+    glm::vec3 normal = glm::cross(vertices[triangle[1]].Position - a, vertices[triangle[2]].Position - a);
+    float length = glm::length(normal);
+    return length > 0.0f ? normal / length : glm::vec3(0.0f);
+}
+
+void computeBounds(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& meshletVertices,
+                   const std::vector<glm::vec3>& normals, Meshlet& meshlet)
+{
+    glm::vec3 minimum = vertices[meshletVertices[0]].Position, maximum = minimum;
+    for (unsigned int v : meshletVertices)
+    {
+        minimum = glm::min(minimum, vertices[v].Position);
+        maximum = glm::max(maximum, vertices[v].Position);
+    }
+    meshlet.center = (minimum + maximum) * 0.5f;
+    meshlet.radius = 0.0f;
+    for (unsigned int v : meshletVertices)
+        meshlet.radius = std::max(meshlet.radius, glm::length(vertices[v].Position - meshlet.center));
+    
+    glm::vec3 axis(0.0f);
+    for (const glm::vec3& normal : normals)
+        axis += normal;
+    float axisLength = glm::length(axis);
+    meshlet.coneAxis = axisLength > 0.0f ? axis / axisLength : glm::vec3(0.0f, 0.0f, 1.0f);
+    meshlet.coneCutoff = NO_CONE_CULLING;
+    if (axisLength <= 0.0f)
+        return;
+    
+    float minDot = 1.0f;
+    for (const glm::vec3& normal : normals)
+    {
+        if (normal != glm::vec3(0.0f))
+            minDot = std::min(minDot, glm::dot(normal, meshlet.coneAxis));
+    }
+    if (minDot > 0.0f)
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+} // namespace
+
+namespace MeshletBuilder {
+
+MeshletSettings& settings()
+{
+    static MeshletSettings instance;
+    return instance;
+}
+
+uint64_t settingsSeed(const MeshletSettings& settings)
+{
+    uint64_t values[4] = {settings.enabled ? 1u : 0u, settings.maxVertices, settings.maxTriangles, settings.minMeshTriangles};
+    return hashBytes(reinterpret_cast<const unsigned char*>(values), sizeof(values), 0x6D6C74ull);
+}
+
+std::vector<Meshlet> build(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                           const MeshletSettings& settings)
+{
+    std::vector<Meshlet> meshlets;
+    size_t triangleCount = indices.size() / 3;
+    if (!settings.enabled || triangleCount < settings.minMeshTriangles || settings.maxVertices < 3)
+        return meshlets;
+    
+    // 정점 -> 삼각형 인접 목록
+    size_t vertexCount = vertices.size();
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (unsigned int index : indices)
+        offsets[index + 1]++;
+    for (size_t v = 0; v < vertexCount; v++)
+        offsets[v + 1] += offsets[v];
+    std::vector<unsigned int> adjacency(indices.size());
+    {
+        std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+            adjacency[cursor[indices[i]]++] = static_cast<unsigned int>(i / 3);
+    }
+    
+    std::vector<glm::vec3> triangleNormals(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++)
+        triangleNormals[t] = triangleNormal(vertices, &indices[t * 3]);
+    
+    std::vector<bool> used(triangleCount, false);
+    // 정점이 현재 메시렛에 들어 있는지 (메시렛 번호로 표시해 매번 지우지 않음)
+    std::vector<unsigned int> vertexOwner(vertexCount, INVALID_INDEX);
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+    
+    std::vector<unsigned int> meshletVertices, candidates;
+    std::vector<glm::vec3> meshletNormals;
+    size_t scanCursor = 0;
+    size_t emitted = 0;
+    while (emitted < triangleCount)
+    {
+        unsigned int id = static_cast<unsigned int>(meshlets.size());
+        Meshlet meshlet;
+        meshlet.indexOffset = static_cast<unsigned int>(output.size());
+        meshlet.triangleCount = 0;
+        meshletVertices.clear();
+        meshletNormals.clear();
+        candidates.clear();
+        glm::vec3 normalSum(0.0f);
+        
+        auto addTriangle = [&](unsigned int t) {
+            used[t] = true;
+            emitted++;
+            for (int k = 0; k < 3; k++)
+            {
+                unsigned int v = indices[t * 3 + k];
+                output.push_back(v);
+                if (vertexOwner[v] != id)
+                {
+                    vertexOwner[v] = id;
+                    meshletVertices.push_back(v);
+                    for (unsigned int i = offsets[v]; i < offsets[v + 1]; i++)
+                    {
+                        if (!used[adjacency[i]])
+                            candidates.push_back(adjacency[i]);
+                    }
+                }
+            }
+            meshletNormals.push_back(triangleNormals[t]);
+            normalSum += triangleNormals[t];
+            meshlet.triangleCount++;
+        };
+        
+        // 캐시 최적화된 입력 순서상 첫 미사용 삼각형에서 시작
+        while (used[scanCursor])
+            scanCursor++;
+        addTriangle(static_cast<unsigned int>(scanCursor));
+        
+        // 새 정점을 가장 적게 추가하는 인접 삼각형부터, 같으면 평균 법선과 가까운 것부터 (원뿔을 좁게 유지)
+        while (meshlet.triangleCount < settings.maxTriangles)
+        {
+            unsigned int best = INVALID_INDEX;
+            int bestNew = 4;
+            float bestDot = -2.0f;
+            size_t write = 0;
+            for (size_t i = 0; i < candidates.size(); i++)
+            {
+                unsigned int t = candidates[i];
+                if (used[t])
+                    continue;
+                candidates[write++] = t;
+                
+                int newVertices = 0;
+                for (int k = 0; k < 3; k++)
+                    newVertices += vertexOwner[indices[t * 3 + k]] != id ? 1 : 0;
+                if (meshletVertices.size() + newVertices > settings.maxVertices)
+                    continue;
+                float alignment = glm::dot(triangleNormals[t], normalSum);
+                if (newVertices < bestNew || (newVertices == bestNew && alignment > bestDot))
+                {
+                    best = t;
+                    bestNew = newVertices;
+                    bestDot = alignment;
+                }
+            }
+            candidates.resize(write);
+            if (best == INVALID_INDEX)
+                break;
+            addTriangle(best);
+        }
+        
+        computeBounds(vertices, meshletVertices, meshletNormals, meshlet);
+        meshlets.push_back(meshlet);
+    }
+    
+    indices.swap(output);
+    return meshlets;
+}
+
+bool isBackFacing(const Meshlet& meshlet, const glm::vec3& cameraPosition)
+{
+    glm::vec3 toCenter = meshlet.center - cameraPosition;
+    return glm::dot(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * glm::length(toCenter) + meshlet.radius;
+}
+
+} // namespace MeshletBuilder
@@ -0,0 +1,375 @@
+#include "../include/mip_generator.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MIP_GENERATOR_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float KAISER_ALPHA = 4.0f;
+
+// 커널 반경 (출력 픽셀 단위)
+float kernelRadius(MipFilter filter)
+{
+    switch (filter)
+    {
+        case MipFilter::Box:      return 0.5f;
+        case MipFilter::Triangle: return 1.0f;
+        case MipFilter::Kaiser:
+        default:                  return 2.0f;
+    }
+}
+
+// 0차 수정 베셀 함수 (급수 전개)
+float besselI0(float x)
+{
+    float sum = 1.0f;
+    float term = 1.0f;
+    float halfX = x * 0.5f;
+    for (int k = 1; k < 32; k++)
+    {
+        term *= halfX / k;
+        float squared = term * term;
+        sum += squared;
+        if (squared < sum * 1e-8f)
+            break;
+    }
+    return sum;
+}
+
+float evaluateKernel(MipFilter filter, float d)
+{
+    d = std::fabs(d);
+    switch (filter)
+    {
+        case MipFilter::Box:
+            return d < 0.5f ? 1.0f : (d == 0.5f ? 0.5f : 0.0f);
+        case MipFilter::Triangle:
+            return std::max(0.0f, 1.0f - d);
+        case MipFilter::Kaiser:
+        default:
+        {
+            float radius = kernelRadius(MipFilter::Kaiser);
+            if (d >= radius)
+                return 0.0f;
+            float sinc = d < 1e-6f ? 1.0f : std::sin(PI * d) / (PI * d);
+            float t = d / radius;
+            return sinc * besselI0(KAISER_ALPHA * std::sqrt(1.0f - t * t)) / besselI0(KAISER_ALPHA);
+        }
+    }
+}
+
+// 한 축의 출력 좌표별 소스 인덱스와 가중치 (합이 1이 되도록 정규화)
+struct AxisTaps {
+    int tapCount = 0;
+    std::vector<int> index;
+    std::vector<float> weight;
+};
+
+AxisTaps buildTaps(int inSize, int outSize, const MipSettings& settings)
+{
+    AxisTaps taps;
+    float scale = static_cast<float>(inSize) / outSize;
+    float radius = kernelRadius(settings.filter) * scale;
+    taps.tapCount = static_cast<int>(std::ceil(radius * 2.0f)) + 1;
+    taps.index.resize(static_cast<size_t>(outSize) * taps.tapCount);
+    taps.weight.resize(taps.index.size());
+    
+    for (int o = 0; o < outSize; o++)
+    {
+        float center = (o + 0.5f) * scale;
+        int first = static_cast<int>(std::ceil(center - radius - 0.5f));
+        float sum = 0.0f;
+        for (int t = 0; t < taps.tapCount; t++)
+        {
+            int i = first + t;
+            float w = evaluateKernel(settings.filter, (i + 0.5f - center) / scale);
+            if (settings.wrap)
+                i = ((i % inSize) + inSize) % inSize;
+            else
+                i = std::clamp(i, 0, inSize - 1);
+            taps.index[o * taps.tapCount + t] = i;
+            taps.weight[o * taps.tapCount + t] = w;
+            sum += w;
+        }
+        for (int t = 0; t < taps.tapCount; t++)
+            taps.weight[o * taps.tapCount + t] /= sum;
+    }
+    return taps;
+}
+
+// 8비트 <-> 실수 변환 테이블
+struct ConversionTables {
+    float srgbToLinear[256];
+    float unorm[256];
+    float snorm[256];
+    unsigned char linearToSrgb[4096];
+    
+    ConversionTables()
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            float v = i / 255.0f;
+            srgbToLinear[i] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+            unorm[i] = v;
+            snorm[i] = v * 2.0f - 1.0f;
+        }
+        for (int i = 0; i < 4096; i++)
+        {
+            float v = i / 4095.0f;
+            float s = v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+            linearToSrgb[i] = static_cast<unsigned char>(std::clamp(s * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+    }
+};
+
+const ConversionTables& tables()
+{
+    static const ConversionTables conversionTables;
+    return conversionTables;
+}
+
+enum class ChannelEncoding { Linear, Srgb, Signed };
+
+// 용도와 채널 수에 따른 채널별 인코딩
+struct PixelLayout {
+    int channels = 0;       // 저장 채널 수
+    int workChannels = 0;   // 필터링 중 채널 수 (2채널 노말은 Z 복원으로 3)
+    bool normal = false;    // 필터링 후 XYZ 재정규화
+    ChannelEncoding encoding[4] = {};
+};
+
+PixelLayout makeLayout(TextureUsage usage, int channels)
+{
+    PixelLayout layout;
+    layout.channels = channels;
+    layout.workChannels = channels;
+    bool alphaIndex[4] = {false, channels == 2, false, channels == 4};
+    for (int c = 0; c < channels; c++)
+    {
+        switch (usage)
+        {
+            case TextureUsage::Color:
+                layout.encoding[c] = alphaIndex[c] ? ChannelEncoding::Linear : ChannelEncoding::Srgb;
+                break;
+            case TextureUsage::Normal:
+                layout.encoding[c] = (channels >= 2 && c < 3) ? ChannelEncoding::Signed : ChannelEncoding::Linear;
+                break;
+            default:
+                layout.encoding[c] = ChannelEncoding::Linear;
+                break;
+        }
+    }
+    if (usage == TextureUsage::Normal && channels >= 2)
+    {
+        layout.normal = true;
+        if (channels == 2)
+        {
+            layout.workChannels = 3;
+            layout.encoding[2] = ChannelEncoding::Signed;
+        }
+    }
+    return layout;
+}
+
+void convertRow(const PixelLayout& layout, const unsigned char* src, int width, float* dst)
+{
+    const ConversionTables& t = tables();
+    for (int x = 0; x < width; x++)
+    {
+        const unsigned char* texel = src + static_cast<size_t>(x) * layout.channels;
+        float* out = dst + static_cast<size_t>(x) * layout.workChannels;
+        for (int c = 0; c < layout.channels; c++)
+        {
+            switch (layout.encoding[c])
+            {
+                case ChannelEncoding::Srgb:   out[c] = t.srgbToLinear[texel[c]]; break;
+                case ChannelEncoding::Signed: out[c] = t.snorm[texel[c]]; break;
+                default:                      out[c] = t.unorm[texel[c]]; break;
+            }
+        }
+        if (layout.workChannels > layout.channels)
+            out[2] = std::sqrt(std::max(0.0f, 1.0f - out[0] * out[0] - out[1] * out[1]));
+    }
+}
+
+void quantizeRow(const PixelLayout& layout, float* src, int width, unsigned char* dst)
+{
+    const ConversionTables& t = tables();
+    for (int x = 0; x < width; x++)
+    {
+        float* texel = src + static_cast<size_t>(x) * layout.workChannels;
+        unsigned char* out = dst + static_cast<size_t>(x) * layout.channels;
+        if (layout.normal)
+        {
+            float length = std::sqrt(texel[0] * texel[0] + texel[1] * texel[1] + texel[2] * texel[2]);
+            if (length > 1e-6f)
+            {
+                texel[0] /= length;
+                texel[1] /= length;
+                texel[2] /= length;
+            }
+            else
+            {
+                texel[0] = 0.0f;
+                texel[1] = 0.0f;
+                texel[2] = 1.0f;
+            }
+        }
+        for (int c = 0; c < layout.channels; c++)
+        {
+            float v = texel[c];
+            switch (layout.encoding[c])
+            {
+                case ChannelEncoding::Srgb:
+                    out[c] = t.linearToSrgb[static_cast<int>(std::clamp(v, 0.0f, 1.0f) * 4095.0f + 0.5f)];
+                    break;
+                case ChannelEncoding::Signed:
+                    out[c] = static_cast<unsigned char>(std::clamp((v * 0.5f + 0.5f) * 255.0f + 0.5f, 0.0f, 255.0f));
+                    break;
+                default:
+                    out[c] = static_cast<unsigned char>(std::clamp(v * 255.0f + 0.5f, 0.0f, 255.0f));
+                    break;
+            }
+        }
+    }
+}
+
+// acc += src * weight (세로 방향 필터링의 핵심 루프)
+void accumulateRow(float* acc, const float* src, float weight, size_t count)
+{
+    size_t i = 0;
+#ifdef MIP_GENERATOR_SSE
+    __m128 w = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(_mm_loadu_ps(src + i), w)));
+#endif
+    for (; i < count; i++)
+        acc[i] += src[i] * weight;
+}
+
+// 한 레벨 다운샘플: 세로 필터로 소스 행들을 한 행으로 모은 뒤 가로 필터 적용
+void downsample(const PixelLayout& layout, const MipSettings& settings, ThreadPool& pool,
+                const unsigned char* src, int inWidth, int inHeight,
+                unsigned char* dst, int outWidth, int outHeight)
+{
+    AxisTaps xTaps = buildTaps(inWidth, outWidth, settings);
+    AxisTaps yTaps = buildTaps(inHeight, outHeight, settings);
+    size_t rowFloats = static_cast<size_t>(inWidth) * layout.workChannels;
+    size_t srcStride = static_cast<size_t>(inWidth) * layout.channels;
+    size_t dstStride = static_cast<size_t>(outWidth) * layout.channels;
+    size_t grain = std::max<size_t>(1, 32768 / static_cast<size_t>(outWidth));
+    
+    pool.parallelFor(static_cast<size_t>(outHeight), grain, [&](size_t begin, size_t end) {
+        // 인접 출력 행은 소스 행을 공유하므로 변환한 행을 링 버퍼에 보관
+        int ringSize = yTaps.tapCount + 2;
+        std::vector<float> converted(rowFloats * ringSize);
+        std::vector<int> convertedRow(ringSize, -1);
+        std::vector<float> column(rowFloats);
+        std::vector<float> outRow(static_cast<size_t>(outWidth) * layout.workChannels);
+        
+        for (size_t y = begin; y < end; y++)
+        {
+            std::fill(column.begin(), column.end(), 0.0f);
+            for (int t = 0; t < yTaps.tapCount; t++)
+            {
+                float w = yTaps.weight[y * yTaps.tapCount + t];
+                if (w == 0.0f)
+                    continue;
+                int sy = yTaps.index[y * yTaps.tapCount + t];
+                int slot = sy % ringSize;
+                float* row = converted.data() + rowFloats * slot;
+                if (convertedRow[slot] != sy)
+                {
+                    convertRow(layout, src + srcStride * sy, inWidth, row);
+                    convertedRow[slot] = sy;
+                }
+                accumulateRow(column.data(), row, w, rowFloats);
+            }
+            
+            for (int x = 0; x < outWidth; x++)
+            {
+                float* out = outRow.data() + static_cast<size_t>(x) * layout.workChannels;
+                for (int c = 0; c < layout.workChannels; c++)
+                    out[c] = 0.0f;
+                for (int t = 0; t < xTaps.tapCount; t++)
+                {
+                    float w = xTaps.weight[x * xTaps.tapCount + t];
+                    const float* in = column.data() + static_cast<size_t>(xTaps.index[x * xTaps.tapCount + t]) * layout.workChannels;
+                    for (int c = 0; c < layout.workChannels; c++)
+                        out[c] += in[c] * w;
+                }
+            }
+            quantizeRow(layout, outRow.data(), outWidth, dst + dstStride * y);
+        }
+    });
+}
+
+// 0번 레벨(원본 버퍼)과 생성한 레벨들을 함께 소유
+struct MipStorage {
+    std::shared_ptr<const void> base;
+    std::vector<unsigned char> data;
+};
+
+} // namespace
+
+namespace MipGenerator {
+
+DecodedImage generate(const DecodedImage& base, TextureUsage usage, const MipSettings& settings, ThreadPool& pool)
+{
+    if (!base.isValid() || base.compressed || base.channels < 1 || base.channels > 4)
+        return base;
+    
+    DecodedImage image = base;
+    image.levels.resize(1);
+    int channels = base.channels;
+    
+    // 레벨 크기를 먼저 계산해 한 버퍼에 담음
+    std::vector<DecodedImage::Level> levels;
+    size_t total = 0;
+    int width = base.width(), height = base.height();
+    while (width > 1 || height > 1)
+    {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        DecodedImage::Level level;
+        level.width = width;
+        level.height = height;
+        level.size = static_cast<size_t>(width) * height * channels;
+        levels.push_back(level);
+        total += level.size;
+    }
+    if (levels.empty())
+        return image;
+    // previous가 가리키는 레벨이 재할당으로 옮겨지지 않게 미리 확보
+    image.levels.reserve(levels.size() + 1);
+    
+    auto storage = std::make_shared<MipStorage>();
+    storage->base = base.storage;
+    storage->data.resize(total);
+    
+    PixelLayout layout = makeLayout(usage, channels);
+    const DecodedImage::Level* previous = &base.levels[0];
+    size_t offset = 0;
+    for (DecodedImage::Level& level : levels)
+    {
+        unsigned char* dst = storage->data.data() + offset;
+        downsample(layout, settings, pool, previous->data, previous->width, previous->height,
+                   dst, level.width, level.height);
+        level.data = dst;
+        offset += level.size;
+        image.levels.push_back(level);
+        previous = &image.levels.back();
+    }
+    image.storage = storage;
+    return image;
+}
+
+} // namespace MipGenerator
@@ -1,415 +1,761 @@
 #include "../include/model.h"
+#include "../include/asset_manager.h"
+#include "../include/frustum.h"
+#include "../include/gltf_loader.h"
+#include "../include/mesh_cache.h"
+#include "../include/mesh_optimizer.h"
+#include "../include/mesh_simplifier.h"
+#include "../include/meshlet.h"
+#include "../include/obj_loader.h"
+#include "../include/render_queue.h"
+#include "../include/tangent_generator.h"
+#include "../include/thread_pool.h"
+#include "../include/vertex_format.h"
 #include <iostream>
 #include <filesystem>
 #include <cstring>
+#include <unordered_set>
 #include <vector>
 #include <algorithm>
+#include <cctype>
 
-#define STB_IMAGE_IMPLEMENTATION
-#include "../include/stb_image.h"
+namespace {
 
-Model::Model(std::string const &path, bool gamma) : gammaCorrection(gamma)
+const unsigned int IMPORT_FLAGS =
+    aiProcess_Triangulate |
+    aiProcess_GenSmoothNormals |
+    aiProcess_FlipUVs |
+    aiProcess_PreTransformVertices; // 플랫하게 변환해 계층 오프셋 제거
+
+// 내장 탄젠트 생성기를 끄면 Assimp CalcTangentSpace로 대체
+unsigned int assimpImportFlags()
+{
+    return TangentGenerator::settings().enabled ? IMPORT_FLAGS : IMPORT_FLAGS | aiProcess_CalcTangentSpace;
+}
+
+// 소문자 확장자 (점 포함, 없으면 빈 문자열)
+std::string lowerExtension(const std::string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return std::string();
+    std::string extension = path.substr(dot);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension;
+}
+
+// 내장 OBJ 로더를 쓸 파일인지 (확장자 대소문자 무시)
+bool usesObjLoader(const std::string& path)
+{
+    return ObjLoader::settings().enabled && lowerExtension(path) == ".obj";
+}
+
+bool usesGltfLoader(const std::string& path)
+{
+    if (!GltfLoader::settings().enabled)
+        return false;
+    std::string extension = lowerExtension(path);
+    return extension == ".gltf" || extension == ".glb";
+}
+
+// AO/roughness/metallic은 한 장의 ORM 텍스처로 묶어 프래그먼트당 한 번만 샘플링
+void appendOrmTexture(const std::string& aoPath, const std::string& roughnessPath, const std::string& metallicPath,
+                      std::vector<std::pair<std::string, std::string>>& textures)
+{
+    if(!aoPath.empty() || !roughnessPath.empty() || !metallicPath.empty())
+        textures.emplace_back("texture_orm", aoPath + "|" + roughnessPath + "|" + metallicPath);
+}
+
+} // namespace
+
+Model::Model(std::string const &path, bool gamma, bool keepCpuData)
+    : gammaCorrection(gamma), keepCpuData(keepCpuData)
 {
     loadModel(path);
 }
 
-void Model::Draw(Shader &shader, bool enableTangentSpace)
+Model::Model(bool gamma, bool keepCpuData) : gammaCorrection(gamma), keepCpuData(keepCpuData)
 {
-    for(unsigned int i = 0; i < meshes.size(); i++)
-        meshes[i].Draw(shader, enableTangentSpace);
 }
 
-void Model::loadModel(std::string const &path)
+Model::~Model()
 {
-    Assimp::Importer importer;
-    const aiScene *scene = importer.ReadFile(
-        path,
-        aiProcess_Triangulate |
-        aiProcess_GenSmoothNormals |
-        aiProcess_FlipUVs |
-        aiProcess_CalcTangentSpace |
-        aiProcess_PreTransformVertices // 플랫하게 변환해 계층 오프셋 제거
-    );
-    
-    if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+    AssetManager::instance().release(meshHandle);
+}
+
+Model::Model(Model&& other) noexcept
+    : meshHandle(other.meshHandle), directory(std::move(other.directory)), gammaCorrection(other.gammaCorrection),
+      keepCpuData(other.keepCpuData)
+{
+    other.meshHandle = MeshHandle();
+}
+
+Model& Model::operator=(Model&& other) noexcept
+{
+    if (this != &other)
     {
-        std::cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
-        return;
+        AssetManager::instance().release(meshHandle);
+        meshHandle = other.meshHandle;
+        directory = std::move(other.directory);
+        gammaCorrection = other.gammaCorrection;
+        keepCpuData = other.keepCpuData;
+        other.meshHandle = MeshHandle();
+        // 다른 메시 묶음의 바운드이므로 다음 enqueue에서 다시 만듦
+        meshBounds.clear();
     }
-    size_t lastSlash = path.find_last_of("/\\");
-    if (lastSlash != std::string::npos)
-        directory = path.substr(0, lastSlash);
-    else
-        directory = ".";
-    
-    processNode(scene->mRootNode, scene);
+    return *this;
 }
 
-void Model::processNode(aiNode *node, const aiScene *scene)
+void Model::enqueue(RenderQueue& queue, bool enableTangentSpace, const DrawView& view)
 {
-    for(unsigned int i = 0; i < node->mNumMeshes; i++)
+    std::vector<Mesh>& sharedMeshes = AssetManager::instance().meshes(meshHandle);
+    if (sharedMeshes.empty())
+        return;
+    
+    if (view.culling)
     {
-        aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
-        meshes.push_back(processMesh(mesh, scene));
+        // 하위 메시 AABB를 모델 공간에서 한 번에 검사 (메시 묶음은 로드 뒤 바뀌지 않으므로 처음 한 번만 채움)
+        if (meshBounds.size() != sharedMeshes.size())
+        {
+            meshBounds.clear();
+            meshBounds.reserve(sharedMeshes.size());
+            for (const Mesh& mesh : sharedMeshes)
+                meshBounds.push(mesh.bounds());
+        }
+        meshVisible.resize(sharedMeshes.size());
+        meshBounds.cull(Frustum::fromMatrix(view.viewProjection * view.model), meshVisible.data());
     }
     
-    for(unsigned int i = 0; i < node->mNumChildren; i++)
+    uint32_t transform = queue.addTransform(view.model);
+    for(unsigned int i = 0; i < sharedMeshes.size(); i++)
     {
-        processNode(node->mChildren[i], scene);
+        if (view.culling && !meshVisible[i])
+            continue;
+        sharedMeshes[i].enqueue(queue, transform, enableTangentSpace, view);
     }
 }
 
-Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene)
+Aabb Model::bounds() const
 {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
+    const std::vector<Mesh>& sharedMeshes = AssetManager::instance().meshes(meshHandle);
+    if (sharedMeshes.empty())
+        return Aabb();
+    Aabb box = sharedMeshes[0].bounds();
+    for (const Mesh& mesh : sharedMeshes)
+        box = box.merged(mesh.bounds());
+    return box;
+}
 
-    // Tangent-space normal mapping requires UVs and tangents/bitangents.
-    // Track availability so we can disable normal maps when data is missing.
-    bool hasTexCoords = mesh->mTextureCoords[0] != nullptr;
-    bool hasTangentSpace = hasTexCoords && mesh->mTangents && mesh->mBitangents;
+void Model::enqueueInstanced(RenderQueue& queue, const InstanceGroup& instances, bool enableTangentSpace,
+                             const DrawView& view)
+{
+    std::vector<Mesh>& sharedMeshes = AssetManager::instance().meshes(meshHandle);
+    if (sharedMeshes.empty() || instances.empty())
+        return;
     
-    for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+    // 월드 공간 절두체로 인스턴스 BVH를 검사 (끄면 전부)
+    visibleIndices.clear();
+    if (view.culling)
+        instances.cull(Frustum::fromMatrix(view.viewProjection), visibleIndices);
+    else
     {
-        Vertex vertex;
-        glm::vec3 vector;
-        
-        vector.x = mesh->mVertices[i].x;
-        vector.y = mesh->mVertices[i].y;
-        vector.z = mesh->mVertices[i].z;
-        vertex.Position = vector;
-        
-        if (mesh->mNormals)
-        {
-            vector.x = mesh->mNormals[i].x;
-            vector.y = mesh->mNormals[i].y;
-            vector.z = mesh->mNormals[i].z;
-            vertex.Normal = vector;
-        }
-        
-        if(mesh->mTextureCoords[0])
-        {
-            glm::vec2 vec;
-            vec.x = mesh->mTextureCoords[0][i].x;
-            vec.y = mesh->mTextureCoords[0][i].y;
-            vertex.TexCoords = vec;
-        }
-        else
-            vertex.TexCoords = glm::vec2(0.0f, 0.0f);
-        
-        if(hasTangentSpace)
-        {
-            vector.x = mesh->mTangents[i].x;
-            vector.y = mesh->mTangents[i].y;
-            vector.z = mesh->mTangents[i].z;
-            vertex.Tangent = vector;
-        }
-        else
-        {
-            vertex.Tangent = glm::vec3(0.0f);
-        }
-        
-        if(hasTangentSpace)
-        {
-            vector.x = mesh->mBitangents[i].x;
-            vector.y = mesh->mBitangents[i].y;
-            vector.z = mesh->mBitangents[i].z;
-            vertex.Bitangent = vector;
-        }
-        else
+        visibleIndices.resize(instances.size());
+        for (size_t i = 0; i < visibleIndices.size(); i++)
+            visibleIndices[i] = static_cast<uint32_t>(i);
+    }
+    if (visibleIndices.empty())
+        return;
+    
+    visibleInstances.clear();
+    size_t nearest = 0;
+    float nearestDistance = 0.0f;
+    for (uint32_t index : visibleIndices)
+    {
+        float distance = glm::length(instances.worldBounds(index).center - view.cameraPosition);
+        if (visibleInstances.empty() || distance < nearestDistance)
         {
-            vertex.Bitangent = glm::vec3(0.0f);
+            nearest = visibleInstances.size();
+            nearestDistance = distance;
         }
-        
-        vertices.push_back(vertex);
+        visibleInstances.push_back(instances.instances()[index]);
     }
     
-    for(unsigned int i = 0; i < mesh->mNumFaces; i++)
+    // 메시/메시렛 컬링은 인스턴스마다 다르므로 끄고 인스턴스 단위 컬링만 사용
+    DrawView meshView = view;
+    meshView.model = visibleInstances[nearest].model;
+    meshView.culling = false;
+    uint32_t batch = queue.addInstances(visibleInstances.data(), visibleInstances.size());
+    for (Mesh& mesh : sharedMeshes)
+        mesh.enqueue(queue, 0, enableTangentSpace, meshView, batch);
+}
+
+std::vector<unsigned int> Model::shaderFeatures(bool enableTangentSpace, unsigned int globalFeatures) const
+{
+    std::vector<unsigned int> features;
+    if (!meshHandle.isValid())
+        return features;
+    for (const Mesh& mesh : AssetManager::instance().meshes(meshHandle))
     {
-        aiFace face = mesh->mFaces[i];
-        for(unsigned int j = 0; j < face.mNumIndices; j++)
-            indices.push_back(face.mIndices[j]);
+        unsigned int meshFeatures = mesh.shaderFeatures(enableTangentSpace, globalFeatures);
+        if (std::find(features.begin(), features.end(), meshFeatures) == features.end())
+            features.push_back(meshFeatures);
     }
+    return features;
+}
+
+void Model::loadModel(std::string const &path)
+{
+    ImportResult import;
+    import.path = path;
+    if (beginLoad(import))
+        return;
     
-    aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
-    
-    // PBR 텍스처 맵 로드
-    std::vector<Texture> diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_albedo");
-    textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
+    importFile(import);
+    finishLoad(import);
+}
+
+std::vector<Model> Model::loadModels(const std::vector<std::string>& paths, bool gamma, bool keepCpuData)
+{
+    std::vector<Model> models;
+    models.reserve(paths.size());
+    std::vector<ImportResult> imports(paths.size());
+    std::unordered_set<std::string> importingKeys;
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        models.push_back(Model(gamma, keepCpuData));
+        imports[i].path = paths[i];
+        if (models[i].beginLoad(imports[i]))
+            continue;
+        // 같은 파일이 목록에 여러 번 있으면 한 번만 임포트하고 나머지는 마무리 단계에서 공유
+        imports[i].duplicate = !importingKeys.insert(imports[i].assetKey).second;
+    }
     
-    std::vector<Texture> specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
-    textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
+    // 파일마다 작업 하나 (파일 안의 메시도 같은 풀에서 병렬로 처리됨)
+    ThreadPool::shared().parallelFor(imports.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            if (!models[i].meshHandle.isValid() && !imports[i].duplicate)
+                importFile(imports[i]);
+        }
+    });
     
-    std::vector<Texture> normalMaps = loadMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal");
-    if(!hasTangentSpace && !normalMaps.empty())
+    for (size_t i = 0; i < models.size(); i++)
     {
-        std::cout << "Normal map ignored for mesh (no UVs/tangents in model)" << std::endl;
-        normalMaps.clear();
+        if (!models[i].meshHandle.isValid())
+            models[i].finishLoad(imports[i]);
     }
-    textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
+    return models;
+}
+
+bool Model::beginLoad(ImportResult& import)
+{
+    size_t lastSlash = import.path.find_last_of("/\\");
+    if (lastSlash != std::string::npos)
+        directory = import.path.substr(0, lastSlash);
+    else
+        directory = ".";
     
-    // Metallic과 Roughness는 일반적으로 다른 타입으로 저장될 수 있음
-    // aiTextureType_METALNESS, aiTextureType_DIFFUSE_ROUGHNESS 등
-    std::vector<Texture> metallicMaps = loadMaterialTextures(material, aiTextureType_METALNESS, "texture_metallic");
-    if(metallicMaps.empty())
+    // 같은 파일을 이미 로드한 모델이 있으면 GPU 자원을 그대로 공유.
+    // keepCpuData가 다른 모델끼리는 공유하지 않음 (먼저 로드한 쪽이 CPU 사본을 이미 해제했을 수 있음)
+    import.assetKey = AssetManager::canonicalKey(import.path, ".") + (keepCpuData ? "#cpu" : "");
+    meshHandle = AssetManager::instance().acquireMeshes(import.assetKey);
+    if (!meshHandle.isValid())
+        return false;
+    
+    std::cout << "Sharing already loaded meshes: " << import.path << std::endl;
+    return true;
+}
+
+void Model::importFile(ImportResult& import)
+{
+    // 캐시가 원본과 일치하면 Assimp 임포트를 건너뜀
+    import.cachePath = MeshCache::pathFor(import.path);
+    uint64_t settingsSeed = ((MeshOptimizer::settingsSeed(MeshOptimizer::settings()) * 31 +
+                              MeshSimplifier::settingsSeed(MeshSimplifier::settings())) * 31 +
+                             MeshletBuilder::settingsSeed(MeshletBuilder::settings())) * 31 +
+                            TangentGenerator::settingsSeed(TangentGenerator::settings());
+    // 내장 OBJ/glTF 로더 결과는 Assimp 플래그와 무관하므로 플래그 자리에 0을 넣어 캐시를 구분
+    bool nativeObj = usesObjLoader(import.path);
+    bool nativeGltf = usesGltfLoader(import.path);
+    import.cacheKey = MeshCache::computeKey(import.path, nativeObj || nativeGltf ? 0u : assimpImportFlags(), settingsSeed);
+    ThreadPool& pool = ThreadPool::shared();
+    if (import.cacheKey != 0)
     {
-        // Metallic 맵이 없으면 specular를 사용
-        metallicMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_metallic");
+        auto cache = std::make_unique<MeshCache>();
+        if (cache->load(import.cachePath, import.cacheKey))
+        {
+            // 매핑된 캐시에서 바로 압축 (CPU 사본을 만들지 않음)
+            const std::vector<MeshCache::MeshEntry>& entries = cache->entries();
+            import.packed.resize(entries.size());
+            pool.parallelFor(entries.size(), 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++)
+                    import.packed[i] = VertexFormat::pack(entries[i].vertices, entries[i].vertexCount, entries[i].indices,
+                                                          entries[i].indexCount, VertexFormat::settings());
+            });
+            import.cache = std::move(cache);
+            // 캐시에 저장된 텍스처 경로 중 glTF 내장 이미지는 파일이 없으므로 메모리 이미지로 다시 등록
+            if (nativeGltf)
+                GltfLoader::registerEmbeddedImages(import.path);
+            return;
+        }
     }
-    textures.insert(textures.end(), metallicMaps.begin(), metallicMaps.end());
     
-    std::vector<Texture> roughnessMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE_ROUGHNESS, "texture_roughness");
-    if(roughnessMaps.empty())
+    if (nativeObj)
     {
-        // Roughness 맵이 없으면 shininess를 사용 (roughness = 1.0 - shininess/256.0)
-        // 또는 다른 텍스처 타입에서 찾기
-        roughnessMaps = loadMaterialTextures(material, aiTextureType_SHININESS, "texture_roughness");
+        importObj(import);
+        return;
+    }
+    if (nativeGltf)
+    {
+        importGltf(import);
+        return;
     }
-    textures.insert(textures.end(), roughnessMaps.begin(), roughnessMaps.end());
     
-    std::vector<Texture> aoMaps = loadMaterialTextures(material, aiTextureType_LIGHTMAP, "texture_ao");
-    textures.insert(textures.end(), aoMaps.begin(), aoMaps.end());
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(import.path, assimpImportFlags());
     
-    // 텍스처가 하나도 없으면 Pbr 디렉토리에서 기본 텍스처 로드 시도
-    if (textures.empty())
+    if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
     {
-        static bool defaultTexturesLoaded = false;
-        static Texture defaultBaseColor, defaultNormal, defaultMetallic, defaultRoughness;
-        
-        if (!defaultTexturesLoaded)
+        std::cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
+        import.failed = true;
+        return;
+    }
+    
+    std::vector<aiMesh*> sceneMeshes;
+    collectMeshes(scene->mRootNode, scene, sceneMeshes);
+    import.meshes.resize(sceneMeshes.size());
+    import.packed.resize(sceneMeshes.size());
+    // 메시마다 작업 하나: 변환/최적화/메시렛/LOD/정점 압축은 메시끼리 독립
+    pool.parallelFor(sceneMeshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
         {
-            std::cout << "No textures found in material, loading default PBR textures..." << std::endl;
+            ImportedMesh& imported = import.meshes[i];
+            processMesh(sceneMeshes[i], scene, imported);
+            import.packed[i] = VertexFormat::pack(imported.vertices.data(), imported.vertices.size(),
+                                                  imported.indices.data(), imported.indices.size(),
+                                                  VertexFormat::settings());
+        }
+    });
+}
+
+void Model::importObj(ImportResult& import)
+{
+    ObjScene scene;
+    if (!ObjLoader::load(import.path, scene))
+    {
+        import.failed = true;
+        return;
+    }
+    
+    import.meshes.resize(scene.meshes.size());
+    import.packed.resize(scene.meshes.size());
+    ThreadPool::shared().parallelFor(scene.meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            ObjMesh& source = scene.meshes[i];
+            ImportedMesh& imported = import.meshes[i];
+            imported.vertices = std::move(source.vertices);
+            imported.indices = std::move(source.indices);
+            imported.materialIndex = source.materialIndex;
+            // OBJ에는 탄젠트가 없으므로 UV가 있으면 processGeometry에서 생성
+            imported.hasTexCoords = scene.hasTexCoords;
+            imported.hasTangentSpace = false;
+            processGeometry(imported);
             
-            // BaseColor 텍스처 로드
-            defaultBaseColor.id = TextureFromFile("mjolnir3_lp_GreyMetal_BaseColor.png", "Pbr");
-            if (defaultBaseColor.id == 0)
-                defaultBaseColor.id = TextureFromFile("mjolnir3_lp_GreyMetal_BaseColor.png", "../Pbr");
-            if (defaultBaseColor.id != 0)
-            {
-                defaultBaseColor.type = "texture_albedo";
-                defaultBaseColor.path = "Pbr/mjolnir3_lp_GreyMetal_BaseColor.png";
-                std::cout << "  ✓ Loaded BaseColor texture (ID: " << defaultBaseColor.id << ")" << std::endl;
-            }
+            const ObjMaterial& material = scene.materials[source.materialIndex];
+            if (!material.diffuseMap.empty())
+                imported.textures.emplace_back("texture_albedo", material.diffuseMap);
+            if (!material.specularMap.empty())
+                imported.textures.emplace_back("texture_specular", material.specularMap);
+            if (imported.hasTangentSpace && !material.normalMap.empty())
+                imported.textures.emplace_back("texture_normal", material.normalMap);
+            else if (!material.normalMap.empty())
+                std::cout << "Normal map ignored for mesh (no UVs/tangents in model)" << std::endl;
+            // Metallic 맵이 없으면 specular를 사용 (Assimp 경로와 같은 규칙)
+            appendOrmTexture(std::string(), material.roughnessMap,
+                             material.metallicMap.empty() ? material.specularMap : material.metallicMap,
+                             imported.textures);
             
-            // Normal 텍스처 로드
-            defaultNormal.id = TextureFromFile("mjolnir3_lp_GreyMetal_Normal.png", "Pbr");
-            if (defaultNormal.id == 0)
-                defaultNormal.id = TextureFromFile("mjolnir3_lp_GreyMetal_Normal.png", "../Pbr");
-            if (defaultNormal.id != 0)
-            {
-                defaultNormal.type = "texture_normal";
-                defaultNormal.path = "Pbr/mjolnir3_lp_GreyMetal_Normal.png";
-                std::cout << "  ✓ Loaded Normal texture (ID: " << defaultNormal.id << ")" << std::endl;
-            }
+            import.packed[i] = VertexFormat::pack(imported.vertices.data(), imported.vertices.size(),
+                                                  imported.indices.data(), imported.indices.size(),
+                                                  VertexFormat::settings());
+        }
+    });
+}
+
+void Model::importGltf(ImportResult& import)
+{
+    GltfScene scene;
+    if (!GltfLoader::load(import.path, scene))
+    {
+        import.failed = true;
+        return;
+    }
+    
+    import.meshes.resize(scene.meshes.size());
+    import.packed.resize(scene.meshes.size());
+    ThreadPool::shared().parallelFor(scene.meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            GltfMesh& source = scene.meshes[i];
+            ImportedMesh& imported = import.meshes[i];
+            imported.vertices = std::move(source.vertices);
+            imported.indices = std::move(source.indices);
+            imported.materialIndex = source.materialIndex;
+            imported.hasTexCoords = source.hasTexCoords;
+            imported.hasTangentSpace = source.hasTangents;
+            // TANGENT 속성이 없으면 glTF 스펙대로 MikkTSpace 탄젠트 생성
+            processGeometry(imported);
             
-            // Metallic 텍스처 로드
-            defaultMetallic.id = TextureFromFile("mjolnir3_lp_GreyMetal_Metallic.png", "Pbr");
-            if (defaultMetallic.id == 0)
-                defaultMetallic.id = TextureFromFile("mjolnir3_lp_GreyMetal_Metallic.png", "../Pbr");
-            if (defaultMetallic.id != 0)
-            {
-                defaultMetallic.type = "texture_metallic";
-                defaultMetallic.path = "Pbr/mjolnir3_lp_GreyMetal_Metallic.png";
-                std::cout << "  ✓ Loaded Metallic texture (ID: " << defaultMetallic.id << ")" << std::endl;
-            }
+            // metallic-roughness 계수는 셰이더가 맵 값에 곱함 (맵이 없으면 계수가 곧 값)
+            const GltfMaterial& material = scene.materials[source.materialIndex];
+            imported.factors.enabled = true;
+            imported.factors.baseColor = glm::vec3(material.baseColorFactor);
+            imported.factors.metallic = material.metallicFactor;
+            imported.factors.roughness = material.roughnessFactor;
             
-            // Roughness 텍스처 로드
-            defaultRoughness.id = TextureFromFile("mjolnir3_lp_GreyMetal_Roughness.png", "Pbr");
-            if (defaultRoughness.id == 0)
-                defaultRoughness.id = TextureFromFile("mjolnir3_lp_GreyMetal_Roughness.png", "../Pbr");
-            if (defaultRoughness.id != 0)
-            {
-                defaultRoughness.type = "texture_roughness";
-                defaultRoughness.path = "Pbr/mjolnir3_lp_GreyMetal_Roughness.png";
-                std::cout << "  ✓ Loaded Roughness texture (ID: " << defaultRoughness.id << ")" << std::endl;
-            }
+            if (!material.baseColorMap.empty())
+                imported.textures.emplace_back("texture_albedo", material.baseColorMap);
+            if (imported.hasTangentSpace && !material.normalMap.empty())
+                imported.textures.emplace_back("texture_normal", material.normalMap);
+            else if (!material.normalMap.empty())
+                std::cout << "Normal map ignored for mesh (no UVs/tangents in model)" << std::endl;
             
-            defaultTexturesLoaded = true;
+            // metallicRoughness 텍스처(G/B)와 occlusion(R)을 ORM 한 장으로. 같은 이미지면 그대로 쓰고,
+            // occlusion이 별도 이미지면 requestTexture에서 채널을 골라 묶음
+            const std::string& metallicRoughness = material.metallicRoughnessMap;
+            appendOrmTexture(material.occlusionMap, metallicRoughness, metallicRoughness, imported.textures);
+            
+            import.packed[i] = VertexFormat::pack(imported.vertices.data(), imported.vertices.size(),
+                                                  imported.indices.data(), imported.indices.size(),
+                                                  VertexFormat::settings());
         }
-        
-        // 기본 텍스처를 메시에 추가
-        if (defaultBaseColor.id != 0) textures.push_back(defaultBaseColor);
-        if (defaultNormal.id != 0) textures.push_back(defaultNormal);
-        if (defaultMetallic.id != 0) textures.push_back(defaultMetallic);
-        if (defaultRoughness.id != 0) textures.push_back(defaultRoughness);
-    }
-    
-    return Mesh(vertices, indices, textures, hasTangentSpace);
+    });
 }
 
-std::vector<Texture> Model::loadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName)
+void Model::finishLoad(ImportResult& import)
 {
-    std::vector<Texture> textures;
-    for(unsigned int i = 0; i < mat->GetTextureCount(type); i++)
+    // 같은 묶음에서 먼저 끝난 모델이 등록했으면 공유
+    AssetManager& assets = AssetManager::instance();
+    meshHandle = assets.acquireMeshes(import.assetKey);
+    if (meshHandle.isValid() || import.failed || import.duplicate)
+        return;
+    
+    if (import.cache)
     {
-        aiString str;
-        mat->GetTexture(type, i, &str);
-        bool skip = false;
-        for(unsigned int j = 0; j < textures_loaded.size(); j++)
+        std::cout << "Loading meshes from cache: " << import.cachePath << std::endl;
+        const std::vector<MeshCache::MeshEntry>& entries = import.cache->entries();
+        meshes.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); i++)
         {
-            if(std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0)
-            {
-                textures.push_back(textures_loaded[j]);
-                skip = true;
-                break;
-            }
+            const MeshCache::MeshEntry& entry = entries[i];
+            std::vector<Texture> textures;
+            for (const MeshCache::TextureEntry& cached : entry.textures)
+                textures.push_back(requestTexture(cached.path, cached.type));
+            
+            meshes.emplace_back(import.packed[i], std::move(textures), entry.hasTangentSpace, entry.lods, entry.meshlets);
+            meshes.back().materialIndex = entry.materialIndex;
+            meshes.back().factors = entry.factors;
         }
-        if(!skip)
+        resolveTextures();
+    }
+    else
+    {
+        optimizationReport = MeshOptimizationReport();
+        meshes.reserve(import.meshes.size());
+        for (size_t i = 0; i < import.meshes.size(); i++)
         {
-            Texture texture;
-            texture.id = TextureFromFile(str.C_Str(), this->directory);
-            if (texture.id == 0)
-            {
-                std::cout << "  Skipping texture (failed to load): " << str.C_Str() << std::endl;
-                continue;
-            }
-            texture.type = typeName;
-            texture.path = str.C_Str();
-            textures.push_back(texture);
-            textures_loaded.push_back(texture);
+            ImportedMesh& imported = import.meshes[i];
+            std::vector<Texture> textures;
+            for (const auto& [type, path] : imported.textures)
+                textures.push_back(requestTexture(path, type));
+            // 텍스처가 하나도 없으면 Pbr 디렉토리에서 기본 텍스처 로드 시도
+            if (textures.empty())
+                textures = requestDefaultTextures();
+            
+            meshes.emplace_back(import.packed[i], std::move(textures), imported.hasTangentSpace,
+                                std::move(imported.lods), std::move(imported.meshlets));
+            Mesh& mesh = meshes.back();
+            mesh.materialIndex = imported.materialIndex;
+            mesh.factors = imported.factors;
+            // 메시 캐시 저장용 (keepCpuData가 아니면 저장 후 해제)
+            mesh.vertices = std::move(imported.vertices);
+            mesh.indices = std::move(imported.indices);
+            optimizationReport.add(imported.report);
+        }
+        resolveTextures();
+        
+        if (MeshOptimizer::settings().enabled)
+        {
+            std::cout << "Mesh optimization: " << import.path
+                      << "\n  vertices " << optimizationReport.verticesBefore << " -> " << optimizationReport.verticesAfter
+                      << "\n  ACMR " << optimizationReport.acmrBefore() << " -> " << optimizationReport.acmrAfter()
+                      << "\n  ATVR " << optimizationReport.atvrBefore() << " -> " << optimizationReport.atvrAfter()
+                      << std::endl;
+        }
+        
+        if (import.cacheKey != 0 && !meshes.empty())
+            MeshCache::save(import.cachePath, import.cacheKey, meshes);
+        
+        if (!keepCpuData)
+        {
+            for (Mesh& mesh : meshes)
+                mesh.releaseCpuData();
         }
     }
-    return textures;
+    
+    meshHandle = assets.registerMeshes(import.assetKey, std::move(meshes));
+    meshes.clear();
 }
 
-// 텍스처 로딩 헬퍼: 여러 경로에서 텍스처 로드 시도
-unsigned char* Model::tryLoadTextureFromPaths(const std::vector<std::string>& paths, int& width, int& height, int& nrComponents)
+void Model::collectMeshes(aiNode *node, const aiScene *scene, std::vector<aiMesh*>& result)
 {
-    for (const auto& path : paths)
-    {
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrComponents, 0);
-        if (data)
-        {
-            std::cout << "  ✓ Loaded texture from: " << path << std::endl;
-            return data;
-        }
-    }
-    return nullptr;
+    for(unsigned int i = 0; i < node->mNumMeshes; i++)
+        result.push_back(scene->mMeshes[node->mMeshes[i]]);
+    
+    for(unsigned int i = 0; i < node->mNumChildren; i++)
+        collectMeshes(node->mChildren[i], scene, result);
 }
 
-// 기본 텍스처 경로 생성
-std::vector<std::string> Model::getDefaultTexturePaths(const std::string& baseName, const std::string& textureName)
+void Model::processMesh(aiMesh *mesh, const aiScene *scene, ImportedMesh& result)
 {
-    std::vector<std::string> paths;
+    std::vector<Vertex>& vertices = result.vertices;
+    std::vector<unsigned int>& indices = result.indices;
+    
+    // Tangent-space normal mapping requires UVs and tangents/bitangents.
+    // Track availability so we can disable normal maps when data is missing.
+    // 파일에 탄젠트가 없으면 processGeometry에서 생성하므로 여기서는 있는 데이터만 기록
+    bool hasTexCoords = mesh->mTextureCoords[0] != nullptr;
+    bool hasTangentSpace = hasTexCoords && mesh->mTangents && mesh->mBitangents;
+    result.hasTexCoords = hasTexCoords;
+    result.hasTangentSpace = hasTangentSpace;
+    result.materialIndex = mesh->mMaterialIndex;
     
-    // BaseColor, Diffuse 관련
-    if (baseName.find("diffuse") != std::string::npos || 
-        baseName.find("albedo") != std::string::npos ||
-        baseName.find("base") != std::string::npos ||
-        baseName.find("color") != std::string::npos)
+    // 원소별 push_back 대신 한 번에 할당하고 속성별로 채움 (없는 속성은 0)
+    vertices.assign(mesh->mNumVertices, Vertex{});
+    for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+        vertices[i].Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+    if (mesh->mNormals)
     {
-        paths = {"Pbr/mjolnir3_lp_GreyMetal_BaseColor.png", "../Pbr/mjolnir3_lp_GreyMetal_BaseColor.png"};
+        for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+            vertices[i].Normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
     }
-    // Normal 관련
-    else if (baseName.find("normal") != std::string::npos)
+    if (hasTexCoords)
     {
-        paths = {"Pbr/mjolnir3_lp_GreyMetal_Normal.png", "../Pbr/mjolnir3_lp_GreyMetal_Normal.png"};
+        const aiVector3D* texCoords = mesh->mTextureCoords[0];
+        for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+            vertices[i].TexCoords = glm::vec2(texCoords[i].x, texCoords[i].y);
     }
-    // Metallic 관련
-    else if (baseName.find("metallic") != std::string::npos)
+    if (hasTangentSpace)
     {
-        paths = {"Pbr/mjolnir3_lp_GreyMetal_Metallic.png", "../Pbr/mjolnir3_lp_GreyMetal_Metallic.png"};
+        for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+        {
+            vertices[i].Tangent = glm::vec3(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z);
+            vertices[i].Bitangent = glm::vec3(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z);
+        }
     }
-    // Roughness 관련
-    else if (baseName.find("roughness") != std::string::npos || baseName.find("rough") != std::string::npos)
+    
+    // Triangulate 후처리로 모든 면이 삼각형 (점/선 프리미티브는 건너뜀)
+    indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
+    for(unsigned int i = 0; i < mesh->mNumFaces; i++)
     {
-        paths = {"Pbr/mjolnir3_lp_GreyMetal_Roughness.png", "../Pbr/mjolnir3_lp_GreyMetal_Roughness.png"};
+        const aiFace& face = mesh->mFaces[i];
+        if (face.mNumIndices == 3)
+            indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
     }
-    // AO, Height 관련
-    else if (baseName.find("ao") != std::string::npos || 
-             baseName.find("height") != std::string::npos ||
-             baseName.find("occlusion") != std::string::npos)
+    
+    processGeometry(result);
+    
+    aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
+    std::vector<std::pair<std::string, std::string>>& textures = result.textures;
+    
+    // PBR 텍스처 맵 경로 (요청은 렌더 스레드에서)
+    collectMaterialTextures(material, aiTextureType_DIFFUSE, "texture_albedo", textures);
+    collectMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular", textures);
+    
+    if(result.hasTangentSpace)
+        collectMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal", textures);
+    else if(material->GetTextureCount(aiTextureType_HEIGHT) > 0)
+        std::cout << "Normal map ignored for mesh (no UVs/tangents in model)" << std::endl;
+    
+    // Metallic과 Roughness는 일반적으로 다른 타입으로 저장될 수 있음
+    // aiTextureType_METALNESS, aiTextureType_DIFFUSE_ROUGHNESS 등
+    std::string metallicPath = firstTexturePath(material, aiTextureType_METALNESS);
+    if(metallicPath.empty())
     {
-        paths = {"Pbr/mjolnir3_lp_GreyMetal_Height.png", "../Pbr/mjolnir3_lp_GreyMetal_Height.png"};
+        // Metallic 맵이 없으면 specular를 사용
+        metallicPath = firstTexturePath(material, aiTextureType_SPECULAR);
     }
-    // 기본 경로들
-    else
+    
+    std::string roughnessPath = firstTexturePath(material, aiTextureType_DIFFUSE_ROUGHNESS);
+    if(roughnessPath.empty())
     {
-        paths = {
-            "Pbr/" + textureName,
-            "../Pbr/" + textureName,
-            "Pbr/mjolnir3_lp_GreyMetal_BaseColor.png",
-            "../Pbr/mjolnir3_lp_GreyMetal_BaseColor.png"
-        };
+        // Roughness 맵이 없으면 shininess를 사용 (roughness = 1.0 - shininess/256.0)
+        // 또는 다른 텍스처 타입에서 찾기
+        roughnessPath = firstTexturePath(material, aiTextureType_SHININESS);
     }
     
-    return paths;
+    std::string aoPath = firstTexturePath(material, aiTextureType_LIGHTMAP);
+    
+    appendOrmTexture(aoPath, roughnessPath, metallicPath, textures);
 }
 
-// OpenGL 텍스처 생성
-unsigned int Model::createGLTexture(unsigned char* data, int width, int height, int nrComponents)
+void Model::processGeometry(ImportedMesh& mesh)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    
-    GLenum format;
-    if (nrComponents == 1)
-        format = GL_RED;
-    else if (nrComponents == 3)
-        format = GL_RGB;
-    else if (nrComponents == 4)
-        format = GL_RGBA;
-    
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    
-    return textureID;
+    // 탄젠트가 없거나 강제 설정이면 MikkTSpace 호환 탄젠트 생성 (UV가 있어야 함, 용접 전에 해야 미러링 정점이 분리됨)
+    const TangentGeneratorSettings& tangentSettings = TangentGenerator::settings();
+    if (tangentSettings.enabled && mesh.hasTexCoords && (!mesh.hasTangentSpace || tangentSettings.force))
+    {
+        TangentGenerator::generate(mesh.vertices, mesh.indices);
+        mesh.hasTangentSpace = true;
+    }
+    // 용접/정점 캐시/오버드로/fetch 순서 최적화 (결과는 메시 캐시에 그대로 저장됨)
+    mesh.report = MeshOptimizer::optimize(mesh.vertices, mesh.indices, MeshOptimizer::settings());
+    // LOD0을 메시렛 단위로 재배치한 뒤 그 순서에 맞춰 정점 fetch 순서를 다시 정렬
+    mesh.meshlets = MeshletBuilder::build(mesh.vertices, mesh.indices, MeshletBuilder::settings());
+    if (!mesh.meshlets.empty())
+        MeshOptimizer::optimizeVertexFetch(mesh.vertices, mesh.indices);
+    // 하위 LOD 인덱스는 같은 배열 뒤에 이어 붙임
+    mesh.lods = MeshSimplifier::buildLodChain(mesh.vertices, mesh.indices, MeshSimplifier::settings());
 }
 
-unsigned int Model::TextureFromFile(const char *path, const std::string &directory, bool gamma)
+std::string Model::firstTexturePath(aiMaterial *mat, aiTextureType type)
 {
-    std::string filename = std::string(path);
-    
-    // 먼저 원본 경로로 시도
-    std::string fullPath = filename;
-    if (!directory.empty() && directory != ".")
+    if(mat->GetTextureCount(type) == 0)
+        return std::string();
+    aiString str;
+    mat->GetTexture(type, 0, &str);
+    return str.C_Str();
+}
+
+void Model::collectMaterialTextures(aiMaterial *mat, aiTextureType type, const std::string& typeName,
+                                    std::vector<std::pair<std::string, std::string>>& textures)
+{
+    for(unsigned int i = 0; i < mat->GetTextureCount(type); i++)
     {
-        fullPath = directory + '/' + filename;
+        aiString str;
+        mat->GetTexture(type, i, &str);
+        textures.emplace_back(typeName, str.C_Str());
     }
+}
+
+// 디코딩만 워커 스레드에 예약하고, GL ID는 resolveTextures()에서 채움
+// (다른 모델이 이미 로드한 텍스처면 AssetManager가 그대로 공유)
+Texture Model::requestTexture(const std::string& path, const std::string& typeName)
+{
+    Texture texture;
+    texture.id = 0;
+    texture.type = typeName;
+    texture.path = path;
     
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(fullPath.c_str(), &width, &height, &nrComponents, 0);
-    
-    // 원본 경로에서 찾지 못하면 Pbr 디렉토리에서 시도
-    if (!data)
+    AssetManager& assets = AssetManager::instance();
+    if (typeName == "texture_orm")
     {
-        std::cout << "  Trying to load texture: " << fullPath;
-        if (!directory.empty() && directory != ".")
-            std::cout << " (from directory: " << directory << ")";
-        std::cout << std::endl;
-        
-        // 파일명만 추출
-        size_t lastSlash = filename.find_last_of("/\\");
-        std::string textureName = (lastSlash != std::string::npos) ? filename.substr(lastSlash + 1) : filename;
-        
-        // 파일 확장자 제거
-        size_t dotPos = textureName.find_last_of(".");
-        std::string baseName = (dotPos != std::string::npos) ? textureName.substr(0, dotPos) : textureName;
+        // "AO|roughness|metallic" 경로 분해
+        std::array<std::string, 3> sources;
+        size_t start = 0;
+        for (int c = 0; c < 3; c++)
+        {
+            size_t end = c < 2 ? path.find('|', start) : std::string::npos;
+            sources[c] = path.substr(start, end == std::string::npos ? std::string::npos : end - start);
+            start = end == std::string::npos ? path.size() : end + 1;
+            if (!sources[c].empty())
+                texture.ormChannels |= 1u << c;
+        }
         
-        // 기본 텍스처 경로 가져오기
-        std::vector<std::string> paths = getDefaultTexturePaths(baseName, textureName);
-        data = tryLoadTextureFromPaths(paths, width, height, nrComponents);
+        // 맵이 하나뿐이면 RGB로 묶지 않고 R8 한 장으로 (업로드 시 RGB 모두 R을 읽도록 스위즐)
+        if (texture.ormChannels == ORM_OCCLUSION || texture.ormChannels == ORM_ROUGHNESS ||
+            texture.ormChannels == ORM_METALLIC)
+        {
+            for (const std::string& source : sources)
+            {
+                if (!source.empty())
+                    texture.handle = assets.requestTexture(source, this->directory, TextureUsage::Scalar);
+            }
+        }
+        // 모든 채널이 한 파일이면 (glTF metallicRoughness 등) 이미 ORM 배치이므로 채널을 다시 묶지 않음
+        else if ((sources[0].empty() || sources[0] == sources[1]) && sources[1] == sources[2])
+            texture.handle = assets.requestTexture(sources[1], this->directory, TextureUsage::Packed);
+        else
+        {
+            // roughness와 metallic이 한 이미지면 glTF 배치(G: roughness, B: metallic)이고 AO는 occlusion 이미지의 R
+            // 그 외에는 채널마다 별도의 회색조 맵이므로 휘도를 읽음
+            std::array<int, 3> channels = { PACKED_LUMINANCE, PACKED_LUMINANCE, PACKED_LUMINANCE };
+            if (!sources[1].empty() && sources[1] == sources[2])
+                channels = { 0, 1, 2 };
+            texture.handle = assets.requestPackedTexture(sources, channels, this->directory);
+        }
+        return texture;
     }
     
-    if (data)
+    // 용도에 따라 압축 포맷이 정해짐 (노말: BC5, 단일 채널 맵: BC4, 그 외 색상: BC1/BC3)
+    TextureUsage usage = TextureUsage::Color;
+    if (typeName == "texture_normal")
+        usage = TextureUsage::Normal;
+    else if (typeName == "texture_specular")
+        usage = TextureUsage::Scalar;
+    texture.handle = assets.requestTexture(path, this->directory, usage);
+    return texture;
+}
+
+std::vector<Texture> Model::requestDefaultTextures()
+{
+    // 기본 경로는 Pbr/ 이름 그대로 두면 디코딩 단계의 폴백 경로 탐색이 ../Pbr까지 찾아줌
+    return {
+        requestTexture("Pbr/mjolnir3_lp_GreyMetal_BaseColor.png", "texture_albedo"),
+        requestTexture("Pbr/mjolnir3_lp_GreyMetal_Normal.png", "texture_normal"),
+        requestTexture("|Pbr/mjolnir3_lp_GreyMetal_Roughness.png|Pbr/mjolnir3_lp_GreyMetal_Metallic.png", "texture_orm")
+    };
+}
+
+// 렌더 스레드: 디코딩이 끝난 텍스처를 GL에 올리고 메시의 텍스처 ID를 채움
+void Model::resolveTextures()
+{
+    AssetManager& assets = AssetManager::instance();
+    assets.resolvePendingTextures();
+    
+    // ID를 채우고, 로드에 실패한 텍스처는 참조를 반환한 뒤 제거
+    auto resolveIds = [&assets](std::vector<Texture>& textures) {
+        for (Texture& texture : textures)
+        {
+            texture.id = assets.textureId(texture.handle);
+            // 여러 맵을 묶은 ORM은 일부 소스가 빠져도 로드되므로, 요청한 채널 대신 실제로 묶인 채널로 셰이더 기능을 고름
+            if (texture.type == "texture_orm")
+            {
+                if (unsigned int packed = assets.packedChannels(texture.handle))
+                    texture.ormChannels = packed;
+            }
+        }
+        auto failed = std::stable_partition(textures.begin(), textures.end(),
+                                            [](const Texture& t) { return t.id != 0; });
+        for (auto it = failed; it != textures.end(); ++it)
+            assets.release(it->handle);
+        textures.erase(failed, textures.end());
+    };
+    
+    std::vector<Mesh*> needDefaults;
+    for (Mesh& mesh : meshes)
     {
-        unsigned int textureID = createGLTexture(data, width, height, nrComponents);
-        stbi_image_free(data);
-        return textureID;
+        bool hadTextures = !mesh.textures.empty();
+        resolveIds(mesh.textures);
+        if (hadTextures && mesh.textures.empty())
+            needDefaults.push_back(&mesh);
     }
-    else
+    
+    // 머티리얼 텍스처가 전부 실패한 메시는 기본 텍스처로 대체
+    if (!needDefaults.empty())
     {
-        std::cout << "  Texture failed to load at path: " << fullPath;
-        if (!directory.empty() && directory != ".")
-            std::cout << " (directory: " << directory << ")";
-        std::cout << std::endl;
-        return 0;
+        std::cout << "Material textures failed to load, loading default PBR textures..." << std::endl;
+        for (Mesh* mesh : needDefaults)
+            mesh->textures = requestDefaultTextures();
+        assets.resolvePendingTextures();
+        for (Mesh* mesh : needDefaults)
+            resolveIds(mesh->textures);
     }
+    
+    // 텍스처 목록이 확정됐으므로 메시마다 셰이더 변형을 고름
+    for (Mesh& mesh : meshes)
+        mesh.updateShaderFeatures();
 }
@@ -0,0 +1,667 @@
+#include "../include/obj_loader.h"
+#include "../include/mapped_file.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+
+// 0부터 시작하는 전역 번호 (없으면 -1)
+struct Corner {
+    int position;
+    int texCoord;
+    int normal;
+    
+    bool operator==(const Corner& other) const
+    {
+        return position == other.position && texCoord == other.texCoord && normal == other.normal;
+    }
+};
+
+struct CornerHash {
+    size_t operator()(const Corner& corner) const
+    {
+        uint64_t hash = static_cast<uint32_t>(corner.position) * 0x9E3779B97F4A7C15ull;
+        hash ^= static_cast<uint32_t>(corner.texCoord) * 0xC2B2AE3D27D4EB4Full;
+        hash ^= static_cast<uint32_t>(corner.normal) * 0x165667B19E3779F9ull;
+        return static_cast<size_t>(hash ^ (hash >> 29));
+    }
+};
+
+// Corner -> 번호 해시 표 (열린 주소법). 키는 corners[번호]로 비교하므로 슬롯에는 번호만 저장
+class CornerTable
+{
+public:
+    // corner가 이미 있으면 (번호, false), 없으면 corners 뒤에 추가하고 (새 번호, true)
+    std::pair<unsigned int, bool> insert(const Corner& corner, std::vector<Corner>& corners)
+    {
+        // 사용률을 1/2 이하로 유지
+        if ((corners.size() + 1) * 2 > slots.size())
+            grow(corners);
+        size_t mask = slots.size() - 1;
+        for (size_t slot = CornerHash()(corner) & mask; ; slot = (slot + 1) & mask)
+        {
+            unsigned int id = slots[slot];
+            if (id == EMPTY)
+            {
+                id = static_cast<unsigned int>(corners.size());
+                slots[slot] = id;
+                corners.push_back(corner);
+                return {id, true};
+            }
+            if (corners[id] == corner)
+                return {id, false};
+        }
+    }
+    
+private:
+    static constexpr unsigned int EMPTY = ~0u;
+    std::vector<unsigned int> slots;
+    
+    void grow(const std::vector<Corner>& corners)
+    {
+        slots.assign(std::max<size_t>(slots.size() * 2, 1024), EMPTY);
+        size_t mask = slots.size() - 1;
+        for (size_t id = 0; id < corners.size(); id++)
+        {
+            size_t slot = CornerHash()(corners[id]) & mask;
+            while (slots[slot] != EMPTY)
+                slot = (slot + 1) & mask;
+            slots[slot] = static_cast<unsigned int>(id);
+        }
+    }
+};
+
+// 구간 안에서 한 머티리얼에 속한 삼각형들 (꼭짓점 중복은 구간 안에서 먼저 제거)
+struct ChunkPart {
+    unsigned int material = 0;          // 전역 머티리얼 번호
+    std::vector<Corner> corners;        // 구간 안에서 처음 나온 순서
+    std::vector<unsigned int> indices;  // corners 번호
+    std::vector<unsigned int> vertices; // corners[i]의 메시 정점 번호 (병합 단계에서 채움)
+    size_t indexOffset = 0;             // 메시 인덱스 배열에서 이 부분이 시작하는 위치
+};
+
+// 워커 하나가 맡는 줄 경계 구간
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    
+    // 1단계: 구간 안의 개수와 머티리얼 변경
+    size_t positionCount = 0;
+    size_t texCoordCount = 0;
+    size_t normalCount = 0;
+    bool changesMaterial = false;
+    std::string lastMaterial;
+    std::vector<std::string> materialLibraries;
+    
+    // 앞 구간들의 합으로 정해지는 전역 시작 번호와 시작 머티리얼
+    size_t positionBase = 0;
+    size_t texCoordBase = 0;
+    size_t normalBase = 0;
+    std::string initialMaterial;
+    
+    // 2단계: 삼각형마다 꼭짓점 3개와 구간 내 머티리얼 번호 ([0]은 initialMaterial)
+    std::vector<Corner> corners;
+    std::vector<unsigned int> triangleMaterials;
+    std::vector<std::string> materialNames;
+    std::vector<unsigned int> globalMaterials;
+    size_t invalidFaces = 0;
+    
+    // 3단계: 로컬 머티리얼 번호별 부분과 범위를 벗어나 버린 삼각형 수
+    std::vector<ChunkPart> parts;
+    size_t outOfRange = 0;
+};
+
+const char* skipSpaces(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+        p++;
+    return p;
+}
+
+const char* findLineEnd(const char* p, const char* end)
+{
+    const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+const char* trimEnd(const char* begin, const char* end)
+{
+    while (end > begin && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t'))
+        end--;
+    return end;
+}
+
+bool isKeyword(const char* p, const char* end, const char* keyword)
+{
+    size_t length = std::strlen(keyword);
+    return static_cast<size_t>(end - p) > length && std::memcmp(p, keyword, length) == 0 &&
+           (p[length] == ' ' || p[length] == '\t');
+}
+
+std::string restOfLine(const char* p, const char* end, size_t keywordLength)
+{
+    const char* begin = skipSpaces(p + keywordLength, end);
+    return std::string(begin, trimEnd(begin, end));
+}
+
+template <class T>
+bool parseNumber(const char*& p, const char* end, T& value)
+{
+    p = skipSpaces(p, end);
+    // from_chars는 앞의 '+'를 받지 않음
+    if (p < end && *p == '+')
+        p++;
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc())
+        return false;
+    p = result.ptr;
+    return true;
+}
+
+// OBJ 인덱스(1부터, 음수는 현재까지 개수 기준 상대)를 0부터 시작하는 전역 번호로
+int resolveIndex(int index, size_t countSoFar)
+{
+    if (index > 0)
+        return index - 1;
+    if (index < 0)
+        return static_cast<int>(countSoFar) + index;
+    return -1;
+}
+
+void countChunk(Chunk& chunk)
+{
+    for (const char* line = chunk.begin; line < chunk.end; )
+    {
+        const char* end = findLineEnd(line, chunk.end);
+        const char* p = skipSpaces(line, end);
+        if (end - p >= 2 && p[0] == 'v')
+        {
+            if (p[1] == ' ' || p[1] == '\t')
+                chunk.positionCount++;
+            else if (end - p >= 3 && (p[2] == ' ' || p[2] == '\t'))
+            {
+                if (p[1] == 't')
+                    chunk.texCoordCount++;
+                else if (p[1] == 'n')
+                    chunk.normalCount++;
+            }
+        }
+        else if (isKeyword(p, end, "usemtl"))
+        {
+            chunk.changesMaterial = true;
+            chunk.lastMaterial = restOfLine(p, end, 6);
+        }
+        else if (isKeyword(p, end, "mtllib"))
+            chunk.materialLibraries.push_back(restOfLine(p, end, 6));
+        line = end + 1;
+    }
+}
+
+void parseChunk(Chunk& chunk, glm::vec3* positions, glm::vec2* texCoords, glm::vec3* normals)
+{
+    size_t position = chunk.positionBase;
+    size_t texCoord = chunk.texCoordBase;
+    size_t normal = chunk.normalBase;
+    chunk.materialNames.assign(1, chunk.initialMaterial);
+    unsigned int material = 0;
+    // 대략 한 줄 30바이트, 면 하나당 삼각형 하나로 가정
+    chunk.corners.reserve(static_cast<size_t>(chunk.end - chunk.begin) / 30);
+    std::vector<Corner> polygon;
+    
+    for (const char* line = chunk.begin; line < chunk.end; )
+    {
+        const char* lineEnd = findLineEnd(line, chunk.end);
+        const char* next = lineEnd + 1;
+        const char* end = trimEnd(line, lineEnd);
+        const char* p = skipSpaces(line, end);
+        if (end - p < 2)
+        {
+            line = next;
+            continue;
+        }
+        
+        if (p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+        {
+            glm::vec3 value(0.0f);
+            p += 1;
+            parseNumber(p, end, value.x);
+            parseNumber(p, end, value.y);
+            parseNumber(p, end, value.z);
+            positions[position++] = value;
+        }
+        else if (p[0] == 'v' && p[1] == 't' && (p[2] == ' ' || p[2] == '\t'))
+        {
+            glm::vec2 value(0.0f);
+            p += 2;
+            parseNumber(p, end, value.x);
+            parseNumber(p, end, value.y);
+            // Assimp aiProcess_FlipUVs와 같은 방향
+            value.y = 1.0f - value.y;
+            texCoords[texCoord++] = value;
+        }
+        else if (p[0] == 'v' && p[1] == 'n' && (p[2] == ' ' || p[2] == '\t'))
+        {
+            glm::vec3 value(0.0f);
+            p += 2;
+            parseNumber(p, end, value.x);
+            parseNumber(p, end, value.y);
+            parseNumber(p, end, value.z);
+            normals[normal++] = value;
+        }
+        else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+        {
+            polygon.clear();
+            p += 1;
+            bool valid = true;
+            for (;;)
+            {
+                p = skipSpaces(p, end);
+                if (p >= end)
+                    break;
+                
+                // v, v/vt, v//vn, v/vt/vn
+                int index = 0;
+                Corner corner = {-1, -1, -1};
+                if (!parseNumber(p, end, index))
+                {
+                    valid = false;
+                    break;
+                }
+                corner.position = resolveIndex(index, position);
+                if (p < end && *p == '/')
+                {
+                    p++;
+                    if (p < end && *p != '/')
+                    {
+                        if (!parseNumber(p, end, index))
+                        {
+                            valid = false;
+                            break;
+                        }
+                        corner.texCoord = resolveIndex(index, texCoord);
+                    }
+                    if (p < end && *p == '/')
+                    {
+                        p++;
+                        if (!parseNumber(p, end, index))
+                        {
+                            valid = false;
+                            break;
+                        }
+                        corner.normal = resolveIndex(index, normal);
+                    }
+                }
+                if (corner.position < 0)
+                    valid = false;
+                polygon.push_back(corner);
+            }
+            
+            if (!valid || polygon.size() < 3)
+                chunk.invalidFaces++;
+            else
+            {
+                // 팬 분할 (aiProcess_Triangulate와 같은 순서)
+                for (size_t i = 1; i + 1 < polygon.size(); i++)
+                {
+                    chunk.corners.push_back(polygon[0]);
+                    chunk.corners.push_back(polygon[i]);
+                    chunk.corners.push_back(polygon[i + 1]);
+                    chunk.triangleMaterials.push_back(material);
+                }
+            }
+        }
+        else if (isKeyword(p, end, "usemtl"))
+        {
+            std::string name = restOfLine(p, end, 6);
+            auto it = std::find(chunk.materialNames.begin(), chunk.materialNames.end(), name);
+            material = static_cast<unsigned int>(it - chunk.materialNames.begin());
+            if (it == chunk.materialNames.end())
+                chunk.materialNames.push_back(name);
+        }
+        line = next;
+    }
+}
+
+// 3단계 (구간마다): 범위를 벗어난 삼각형을 버리고 머티리얼별로 구간 안의 꼭짓점 중복 제거
+void dedupeChunk(Chunk& chunk, size_t positionCount, size_t texCoordCount, size_t normalCount)
+{
+    chunk.parts.resize(chunk.materialNames.size());
+    std::vector<CornerTable> tables(chunk.parts.size());
+    for (size_t m = 0; m < chunk.parts.size(); m++)
+        chunk.parts[m].material = chunk.globalMaterials[m];
+    
+    for (size_t t = 0; t < chunk.triangleMaterials.size(); t++)
+    {
+        const Corner* triangle = &chunk.corners[t * 3];
+        bool inRange = true;
+        for (int k = 0; k < 3; k++)
+        {
+            inRange = inRange && static_cast<size_t>(triangle[k].position) < positionCount &&
+                      (triangle[k].texCoord < 0 || static_cast<size_t>(triangle[k].texCoord) < texCoordCount) &&
+                      (triangle[k].normal < 0 || static_cast<size_t>(triangle[k].normal) < normalCount);
+        }
+        if (!inRange)
+        {
+            chunk.outOfRange++;
+            continue;
+        }
+        
+        unsigned int local = chunk.triangleMaterials[t];
+        ChunkPart& part = chunk.parts[local];
+        for (int k = 0; k < 3; k++)
+            part.indices.push_back(tables[local].insert(triangle[k], part.corners).first);
+    }
+    // 구간 꼭짓점은 part.corners로 옮겼으므로 해제
+    std::vector<Corner>().swap(chunk.corners);
+}
+
+// 3단계 (머티리얼마다): 구간 순서대로 부분들의 꼭짓점을 합쳐 메시 정점 번호를 정함.
+// 구간 안 중복은 이미 없으므로 구간 경계를 넘는 중복만 여기서 걸러짐 (정점 순서는 파일에서 처음 나온 순서)
+void mergeParts(const std::vector<ChunkPart*>& parts, std::vector<Corner>& vertexCorners, size_t& indexCount)
+{
+    size_t cornerCount = 0;
+    for (const ChunkPart* part : parts)
+        cornerCount += part->corners.size();
+    vertexCorners.reserve(cornerCount);
+    
+    CornerTable table;
+    indexCount = 0;
+    for (ChunkPart* part : parts)
+    {
+        part->vertices.resize(part->corners.size());
+        for (size_t i = 0; i < part->corners.size(); i++)
+            part->vertices[i] = table.insert(part->corners[i], vertexCorners).first;
+        part->indexOffset = indexCount;
+        indexCount += part->indices.size();
+    }
+}
+
+// 꼭짓점이 노말을 갖지 않은 정점에 같은 위치를 공유하는 면들의 면적 가중 노말을 넣음
+void generateMissingNormals(ObjMesh& mesh, const std::vector<Corner>& vertexCorners)
+{
+    std::unordered_map<int, glm::vec3> accumulated;
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3)
+    {
+        const glm::vec3& a = mesh.vertices[mesh.indices[t]].Position;
+        const glm::vec3& b = mesh.vertices[mesh.indices[t + 1]].Position;
+        const glm::vec3& c = mesh.vertices[mesh.indices[t + 2]].Position;
+        glm::vec3 faceNormal = glm::cross(b - a, c - a);
+        for (int k = 0; k < 3; k++)
+        {
+            const Corner& corner = vertexCorners[mesh.indices[t + k]];
+            if (corner.normal < 0)
+                accumulated[corner.position] += faceNormal;
+        }
+    }
+    for (size_t v = 0; v < mesh.vertices.size(); v++)
+    {
+        if (vertexCorners[v].normal >= 0)
+            continue;
+        glm::vec3 sum = accumulated[vertexCorners[v].position];
+        float length = glm::length(sum);
+        mesh.vertices[v].Normal = length > 0.0f ? sum / length : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+}
+
+std::string directoryOf(const std::string& path)
+{
+    size_t lastSlash = path.find_last_of("/\\");
+    return lastSlash == std::string::npos ? std::string() : path.substr(0, lastSlash + 1);
+}
+
+} // namespace
+
+namespace ObjLoader {
+
+ObjLoaderSettings& settings()
+{
+    static ObjLoaderSettings instance;
+    return instance;
+}
+
+bool loadMaterials(const std::string& path, std::vector<ObjMaterial>& materials)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+    
+    std::string line;
+    ObjMaterial* current = nullptr;
+    while (std::getline(file, line))
+    {
+        const char* begin = line.data();
+        const char* end = trimEnd(begin, begin + line.size());
+        const char* p = skipSpaces(begin, end);
+        if (isKeyword(p, end, "newmtl"))
+        {
+            materials.emplace_back();
+            current = &materials.back();
+            current->name = restOfLine(p, end, 6);
+            continue;
+        }
+        if (!current)
+            continue;
+        
+        // 텍스처 옵션(-bm 1.0 등)이 앞에 올 수 있으므로 마지막 토큰을 경로로 사용
+        const char* keywordEnd = p;
+        while (keywordEnd < end && *keywordEnd != ' ' && *keywordEnd != '\t')
+            keywordEnd++;
+        std::string keyword(p, keywordEnd);
+        const char* pathBegin = end;
+        while (pathBegin > keywordEnd && pathBegin[-1] != ' ' && pathBegin[-1] != '\t')
+            pathBegin--;
+        std::string texture(pathBegin, end);
+        if (texture.empty())
+            continue;
+        
+        if (keyword == "map_Kd")
+            current->diffuseMap = texture;
+        else if (keyword == "map_Ks")
+            current->specularMap = texture;
+        else if (keyword == "map_Bump" || keyword == "map_bump" || keyword == "bump" || keyword == "norm")
+            current->normalMap = texture;
+        else if (keyword == "map_Pr")
+            current->roughnessMap = texture;
+        else if (keyword == "map_Pm")
+            current->metallicMap = texture;
+    }
+    return true;
+}
+
+bool load(const std::string& path, ObjScene& scene, ThreadPool& pool)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        std::cout << "ERROR::OBJ_LOADER::Failed to open " << path << std::endl;
+        return false;
+    }
+    
+    // 줄 경계에 맞춘 구간으로 분할
+    const char* data = reinterpret_cast<const char*>(file.data());
+    const char* dataEnd = data + file.size();
+    size_t chunkBytes = std::max<size_t>(settings().chunkBytes, 4096);
+    std::vector<Chunk> chunks;
+    for (const char* begin = data; begin < dataEnd; )
+    {
+        const char* end = begin + std::min(chunkBytes, static_cast<size_t>(dataEnd - begin));
+        if (end < dataEnd)
+            end = std::min(dataEnd, findLineEnd(end, dataEnd) + 1);
+        chunks.emplace_back();
+        chunks.back().begin = begin;
+        chunks.back().end = end;
+        begin = end;
+    }
+    
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            countChunk(chunks[i]);
+    });
+    
+    // 전역 시작 번호와 구간 시작 시점의 머티리얼
+    size_t positionCount = 0, texCoordCount = 0, normalCount = 0;
+    std::string material;
+    std::vector<std::string> libraries;
+    for (Chunk& chunk : chunks)
+    {
+        chunk.positionBase = positionCount;
+        chunk.texCoordBase = texCoordCount;
+        chunk.normalBase = normalCount;
+        chunk.initialMaterial = material;
+        positionCount += chunk.positionCount;
+        texCoordCount += chunk.texCoordCount;
+        normalCount += chunk.normalCount;
+        if (chunk.changesMaterial)
+            material = chunk.lastMaterial;
+        libraries.insert(libraries.end(), chunk.materialLibraries.begin(), chunk.materialLibraries.end());
+    }
+    
+    std::vector<glm::vec3> positions(positionCount);
+    std::vector<glm::vec2> texCoords(texCoordCount);
+    std::vector<glm::vec3> normals(normalCount);
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            parseChunk(chunks[i], positions.data(), texCoords.data(), normals.data());
+    });
+    
+    // 머티리얼 이름 -> 전역 번호 (MTL 순서 뒤에 MTL에 없는 이름을 처음 등장 순서로)
+    scene.materials.clear();
+    std::string directory = directoryOf(path);
+    for (const std::string& library : libraries)
+    {
+        if (!loadMaterials(directory + library, scene.materials))
+            std::cout << "OBJ material library not found: " << directory + library << std::endl;
+    }
+    std::unordered_map<std::string, unsigned int> materialIds;
+    for (size_t i = 0; i < scene.materials.size(); i++)
+        materialIds.emplace(scene.materials[i].name, static_cast<unsigned int>(i));
+    
+    size_t invalidFaces = 0;
+    std::vector<size_t> materialTriangles;
+    for (Chunk& chunk : chunks)
+    {
+        invalidFaces += chunk.invalidFaces;
+        for (const std::string& name : chunk.materialNames)
+        {
+            auto [it, inserted] = materialIds.emplace(name, static_cast<unsigned int>(scene.materials.size()));
+            if (inserted)
+            {
+                scene.materials.emplace_back();
+                scene.materials.back().name = name;
+            }
+            chunk.globalMaterials.push_back(it->second);
+        }
+        materialTriangles.resize(scene.materials.size(), 0);
+        for (unsigned int local : chunk.triangleMaterials)
+            materialTriangles[chunk.globalMaterials[local]]++;
+    }
+    if (invalidFaces > 0)
+        std::cout << "OBJ: skipped " << invalidFaces << " malformed faces in " << path << std::endl;
+    
+    // 삼각형이 있는 머티리얼마다 메시 하나
+    scene.meshes.clear();
+    scene.hasTexCoords = texCoordCount > 0;
+    for (size_t m = 0; m < materialTriangles.size(); m++)
+    {
+        if (materialTriangles[m] == 0)
+            continue;
+        scene.meshes.emplace_back();
+        scene.meshes.back().materialIndex = static_cast<unsigned int>(m);
+    }
+    
+    // 구간마다 병렬로 머티리얼별 중복 제거 (한 머티리얼뿐인 큰 파일도 구간 수만큼 나눠 처리)
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            dedupeChunk(chunks[i], positionCount, texCoordCount, normalCount);
+    });
+    
+    // 메시마다 자기 머티리얼의 부분만 구간 순서대로 모음 (어떤 작업도 모든 구간을 다시 훑지 않음)
+    std::vector<unsigned int> meshOfMaterial(scene.materials.size(), 0);
+    for (size_t m = 0; m < scene.meshes.size(); m++)
+        meshOfMaterial[scene.meshes[m].materialIndex] = static_cast<unsigned int>(m);
+    std::vector<std::vector<ChunkPart*>> meshParts(scene.meshes.size());
+    for (Chunk& chunk : chunks)
+    {
+        for (ChunkPart& part : chunk.parts)
+        {
+            if (!part.indices.empty())
+                meshParts[meshOfMaterial[part.material]].push_back(&part);
+        }
+    }
+    
+    std::vector<std::vector<Corner>> vertexCorners(scene.meshes.size());
+    pool.parallelFor(scene.meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; m++)
+        {
+            size_t indexCount = 0;
+            mergeParts(meshParts[m], vertexCorners[m], indexCount);
+            scene.meshes[m].indices.resize(indexCount);
+        }
+    });
+    
+    // 부분마다 자기 구간에 인덱스를 씀 (구간 번호 -> 메시 정점 번호)
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            for (const ChunkPart& part : chunks[i].parts)
+            {
+                if (part.indices.empty())
+                    continue;
+                unsigned int* indices = scene.meshes[meshOfMaterial[part.material]].indices.data() + part.indexOffset;
+                for (size_t k = 0; k < part.indices.size(); k++)
+                    indices[k] = part.vertices[part.indices[k]];
+            }
+        }
+    });
+    
+    pool.parallelFor(scene.meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; m++)
+        {
+            ObjMesh& mesh = scene.meshes[m];
+            const std::vector<Corner>& corners = vertexCorners[m];
+            mesh.vertices.resize(corners.size());
+            std::atomic<bool> missingNormals{false};
+            pool.parallelFor(corners.size(), 65536, [&](size_t first, size_t last) {
+                bool missing = false;
+                for (size_t v = first; v < last; v++)
+                {
+                    const Corner& corner = corners[v];
+                    Vertex vertex{};
+                    vertex.Position = positions[corner.position];
+                    if (corner.texCoord >= 0)
+                        vertex.TexCoords = texCoords[corner.texCoord];
+                    if (corner.normal >= 0)
+                        vertex.Normal = normals[corner.normal];
+                    else
+                        missing = true;
+                    mesh.vertices[v] = vertex;
+                }
+                if (missing)
+                    missingNormals.store(true, std::memory_order_relaxed);
+            });
+            
+            // Assimp aiProcess_GenSmoothNormals 대응
+            if (missingNormals.load())
+                generateMissingNormals(mesh, corners);
+        }
+    });
+    
+    size_t skipped = 0;
+    for (const Chunk& chunk : chunks)
+        skipped += chunk.outOfRange;
+    if (skipped > 0)
+        std::cout << "OBJ: skipped " << skipped << " triangles with out-of-range indices in " << path << std::endl;
+    
+    scene.meshes.erase(std::remove_if(scene.meshes.begin(), scene.meshes.end(),
+                                      [](const ObjMesh& mesh) { return mesh.indices.empty(); }),
+                       scene.meshes.end());
+    return !scene.meshes.empty();
+}
+
+} // namespace ObjLoader
@@ -0,0 +1,162 @@
+#include "../include/render_queue.h"
+#include "../include/mesh.h"
+#include "../include/uniform_blocks.h"
+#include "../include/instancing.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr unsigned int RADIX_BITS = 8;
+constexpr size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+constexpr unsigned int RADIX_PASSES = 64 / RADIX_BITS;
+
+uint64_t field(uint32_t value, unsigned int bits, unsigned int shift)
+{
+    return (static_cast<uint64_t>(value) & ((uint64_t(1) << bits) - 1)) << shift;
+}
+
+} // namespace
+
+uint64_t RenderSortKey::make(RenderPass pass, unsigned int variant, uint32_t material, uint32_t mesh, uint32_t depth)
+{
+    return field(pass, PASS_BITS, PASS_SHIFT) |
+           field(variant, VARIANT_BITS, VARIANT_SHIFT) |
+           field(material, MATERIAL_BITS, MATERIAL_SHIFT) |
+           field(mesh, MESH_BITS, MESH_SHIFT) |
+           field(depth, DEPTH_BITS, DEPTH_SHIFT);
+}
+
+uint32_t RenderSortKey::depth(float distance, RenderPass pass)
+{
+    // 양수 float의 비트 패턴은 값과 같은 순서이므로 부호를 뺀 상위 비트를 그대로 씀 (거리 범위를 정할 필요 없음)
+    distance = std::max(distance, 0.0f);
+    uint32_t bits;
+    std::memcpy(&bits, &distance, sizeof(bits));
+    uint32_t quantized = bits >> (31 - DEPTH_BITS);
+    if (pass == PASS_TRANSPARENT)
+        quantized = ~quantized & ((1u << DEPTH_BITS) - 1);
+    return quantized;
+}
+
+void RenderQueue::clear()
+{
+    items.clear();
+    transforms.clear();
+    instances.clear();
+    instanceBatches.clear();
+    rangeCounts.clear();
+    rangeOffsets.clear();
+    order.clear();
+}
+
+uint32_t RenderQueue::addTransform(const glm::mat4& model)
+{
+    transforms.push_back(model);
+    return static_cast<uint32_t>(transforms.size() - 1);
+}
+
+uint32_t RenderQueue::addInstances(const ModelInstance* source, size_t count)
+{
+    InstanceBatch batch;
+    batch.first = static_cast<uint32_t>(instances.size());
+    batch.count = static_cast<uint32_t>(count);
+    for (size_t i = 0; i < count; i++)
+        instances.push_back(Instancing::pack(source[i]));
+    instanceBatches.push_back(batch);
+    return static_cast<uint32_t>(instanceBatches.size() - 1);
+}
+
+void RenderQueue::push(uint64_t key, Mesh* mesh, unsigned int features, uint32_t transform, uint32_t instanceBatch,
+                       const GLsizei* counts, const void* const* offsets, size_t rangeCount)
+{
+    Item item;
+    item.key = key;
+    item.mesh = mesh;
+    item.features = features;
+    item.transform = transform;
+    item.instanceBatch = instanceBatch;
+    item.firstRange = static_cast<uint32_t>(rangeCounts.size());
+    item.rangeCount = static_cast<uint32_t>(rangeCount);
+    rangeCounts.insert(rangeCounts.end(), counts, counts + rangeCount);
+    rangeOffsets.insert(rangeOffsets.end(), offsets, offsets + rangeCount);
+    items.push_back(item);
+}
+
+void RenderQueue::sort()
+{
+    size_t count = items.size();
+    order.resize(count);
+    for (size_t i = 0; i < count; i++)
+        order[i] = {items[i].key, static_cast<uint32_t>(i)};
+    if (count < 2)
+        return;
+    scratch.resize(count);
+    
+    // 자리마다 히스토그램을 한 번에 세어 두고 (LSD 기수 정렬, 8비트씩 8자리)
+    size_t histograms[RADIX_PASSES][RADIX_BUCKETS] = {};
+    for (const SortEntry& entry : order)
+    {
+        for (unsigned int pass = 0; pass < RADIX_PASSES; pass++)
+            histograms[pass][(entry.key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+    }
+    
+    SortEntry* source = order.data();
+    SortEntry* target = scratch.data();
+    for (unsigned int pass = 0; pass < RADIX_PASSES; pass++)
+    {
+        unsigned int shift = pass * RADIX_BITS;
+        size_t* histogram = histograms[pass];
+        // 모든 키의 이 자리가 같으면 (빈 필드, 한 변형만 쓰는 장면 등) 순서가 그대로이므로 건너뜀
+        if (histogram[(source[0].key >> shift) & (RADIX_BUCKETS - 1)] == count)
+            continue;
+        
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+        {
+            size_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; i++)
+            target[histogram[(source[i].key >> shift) & (RADIX_BUCKETS - 1)]++] = source[i];
+        std::swap(source, target);
+    }
+    if (source != order.data())
+        order.swap(scratch);
+}
+
+void RenderQueue::submit(Shader& shader, const MeshUniforms& uniforms, UniformBlockBuffers& uniformBlocks,
+                         InstanceBuffer& instanceBuffer)
+{
+    // sort()를 부르지 않았으면 넣은 순서대로
+    if (order.size() != items.size())
+    {
+        order.resize(items.size());
+        for (size_t i = 0; i < items.size(); i++)
+            order[i] = {items[i].key, static_cast<uint32_t>(i)};
+    }
+    
+    size_t instanceBase = instanceBuffer.upload(instances.data(), instances.size());
+    
+    uint32_t boundTransform = ~0u;
+    for (const SortEntry& entry : order)
+    {
+        const Item& item = items[entry.item];
+        InstanceRange range;
+        if (item.instanceBatch != NO_INSTANCE_BATCH)
+        {
+            const InstanceBatch& batch = instanceBatches[item.instanceBatch];
+            range.buffer = instanceBuffer.buffer();
+            range.byteOffset = instanceBase + batch.first * sizeof(InstanceData);
+            range.count = static_cast<GLsizei>(batch.count);
+        }
+        else if (item.transform != boundTransform)
+        {
+            uniformBlocks.pushDraw(transforms[item.transform]);
+            boundTransform = item.transform;
+        }
+        item.mesh->submit(shader, uniforms, item.features, rangeCounts.data() + item.firstRange,
+                          rangeOffsets.data() + item.firstRange, item.rangeCount, range);
+    }
+}
@@ -1,40 +1,123 @@
 #include "../include/shader.h"
+#include "../include/shader_cache.h"
+#include "../include/gl_capabilities.h"
+#include "../include/gl_state.h"
+#include "../include/uniform_blocks.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
-#include <fstream>
-#include <sstream>
+#include <utility>
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath)
+namespace {
+
+// 리플렉션으로 읽은 GL 타입이 핸들 타입과 맞는지 (샘플러는 유닛 번호를 int로 받음)
+bool matchesKind(GLenum type, UniformKind kind)
+{
+    switch (type)
+    {
+        case GL_INT:
+        case GL_BOOL:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_ARRAY:
+            return kind == UNIFORM_INT;
+        case GL_FLOAT: return kind == UNIFORM_FLOAT;
+        case GL_FLOAT_VEC2: return kind == UNIFORM_VEC2;
+        case GL_FLOAT_VEC3: return kind == UNIFORM_VEC3;
+        case GL_FLOAT_VEC4: return kind == UNIFORM_VEC4;
+        case GL_FLOAT_MAT2: return kind == UNIFORM_MAT2;
+        case GL_FLOAT_MAT3: return kind == UNIFORM_MAT3;
+        case GL_FLOAT_MAT4: return kind == UNIFORM_MAT4;
+        default: return false;
+    }
+}
+
+} // namespace
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath, std::vector<std::string> featureDefines)
+    : vertexPath(vertexPath), fragmentPath(fragmentPath), featureDefines(std::move(featureDefines))
 {
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
+    ShaderCache::readSource(vertexPath, vertexCode);
+    ShaderCache::readSource(fragmentPath, fragmentCode);
     
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    // 기본 변형은 바로 만들어 둠 (소스 오류를 시작 시점에 보고)
+    variant(0);
+}
+
+void Shader::use()
+{
+    bind(current ? *current : variant(0));
+}
+
+void Shader::use(unsigned int features)
+{
+    // 다른 Shader가 프로그램을 바꿨을 수 있으므로 항상 bind (같은 프로그램이면 GLState가 생략)
+    bind(variant(features));
+}
+
+void Shader::warmUp(const std::vector<unsigned int>& featureSets)
+{
+    for (unsigned int features : featureSets)
+        variant(features);
+}
+
+Shader::Variant& Shader::variant(unsigned int features)
+{
+    auto it = variants.find(features);
+    if (it != variants.end())
+        return *it->second;
     
-    try
+    std::unique_ptr<Variant>& created = variants[features];
+    created = std::make_unique<Variant>();
+    compileVariant(*created, features);
+    reflect(*created);
+    return *created;
+}
+
+std::string Shader::withDefines(const std::string& code, unsigned int features) const
+{
+    std::string defines;
+    for (size_t i = 0; i < featureDefines.size(); i++)
     {
-        vShaderFile.open(vertexPath);
-        fShaderFile.open(fragmentPath);
-        std::stringstream vShaderStream, fShaderStream;
-        
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
-        
-        vShaderFile.close();
-        fShaderFile.close();
-        
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+        if (features & (1u << i))
+            defines += "#define " + featureDefines[i] + "\n";
     }
-    catch(std::ifstream::failure& e)
+    if (defines.empty())
+        return code;
+    
+    // #version은 첫 줄이어야 하므로 그 다음 줄에 넣음
+    size_t insertAt = 0;
+    if (code.compare(0, 8, "#version") == 0)
     {
-        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
+        size_t lineEnd = code.find('\n');
+        insertAt = lineEnd == std::string::npos ? code.size() : lineEnd + 1;
     }
+    return code.substr(0, insertAt) + defines + code.substr(insertAt);
+}
+
+void Shader::compileVariant(Variant& variant, unsigned int features)
+{
+    std::string variantVertexCode = withDefines(vertexCode, features);
+    std::string variantFragmentCode = withDefines(fragmentCode, features);
     
-    const char* vShaderCode = vertexCode.c_str();
-    const char* fShaderCode = fragmentCode.c_str();
+    // 소스와 드라이버가 같으면 저장해 둔 바이너리로 컴파일/링크를 건너뜀
+    // (#define이 소스에 들어가므로 변형마다 키가 다름)
+    std::string cachePath;
+    uint64_t cacheKey = 0;
+    if (ShaderCache::available())
+    {
+        std::stringstream variantName;
+        if (!featureDefines.empty())
+            variantName << std::hex << features;
+        cachePath = ShaderCache::pathFor(vertexPath, fragmentPath, variantName.str());
+        cacheKey = ShaderCache::computeKey(variantVertexCode, variantFragmentCode);
+        variant.program = GLProgram::create();
+        if (ShaderCache::load(variant.program.get(), cachePath, cacheKey))
+            return;
+    }
+    
+    const char* vShaderCode = variantVertexCode.c_str();
+    const char* fShaderCode = variantFragmentCode.c_str();
     
     unsigned int vertex, fragment;
     
@@ -48,82 +131,253 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath)
     glCompileShader(fragment);
     checkCompileErrors(fragment, "FRAGMENT");
     
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
-    checkCompileErrors(ID, "PROGRAM");
+    // 거부된 바이너리를 올린 프로그램은 상태가 남아 있을 수 있으므로 새로 만듦
+    variant.program = GLProgram::create();
+    if (cacheKey != 0)
+        GLCapabilities::get().programParameteri(variant.program.get(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(variant.program.get(), vertex);
+    glAttachShader(variant.program.get(), fragment);
+    glLinkProgram(variant.program.get());
+    bool linked = checkCompileErrors(variant.program.get(), "PROGRAM");
     
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+    
+    if (linked && cacheKey != 0)
+        ShaderCache::save(variant.program.get(), cachePath, cacheKey);
 }
 
-void Shader::use()
+void Shader::reflect(Variant& variant)
+{
+    GLuint program = variant.program.get();
+    GLint activeCount = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &activeCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    
+    std::vector<char> nameBuffer(static_cast<size_t>(std::max(maxLength, 1)));
+    variant.active.clear();
+    variant.active.reserve(static_cast<size_t>(activeCount));
+    for (GLint i = 0; i < activeCount; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()), &length, &size, &type,
+                           nameBuffer.data());
+        std::string name(nameBuffer.data(), static_cast<size_t>(length));
+        // 배열은 "name[0]"으로 보고되므로 핸들 이름과 맞추기 위해 잘라냄
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+            name.resize(name.size() - 3);
+        
+        // uniform 블록 안의 변수는 위치가 없음
+        GLint location = glGetUniformLocation(program, name.c_str());
+        if (location >= 0)
+            variant.active.push_back({name, location, size, type});
+    }
+    
+    // 공유 uniform 블록은 모든 프로그램에서 같은 바인딩 포인트를 쓰도록 지정
+    // (프로그램 바이너리에서 올린 경우에도 바인딩이 남는다는 보장이 없으므로 매번 지정)
+    GLint blockCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+    for (GLint i = 0; i < blockCount; i++)
+    {
+        GLint nameLength = 0;
+        glGetActiveUniformBlockiv(program, static_cast<GLuint>(i), GL_UNIFORM_BLOCK_NAME_LENGTH, &nameLength);
+        std::vector<char> blockName(static_cast<size_t>(std::max(nameLength, 1)));
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(program, static_cast<GLuint>(i), static_cast<GLsizei>(blockName.size()), &length,
+                                    blockName.data());
+        int binding = UniformBlocks::bindingFor(std::string(blockName.data(), static_cast<size_t>(length)));
+        if (binding >= 0)
+            glUniformBlockBinding(program, static_cast<GLuint>(i), static_cast<GLuint>(binding));
+        else
+            std::cout << "ERROR::SHADER::UNKNOWN_UNIFORM_BLOCK: " << blockName.data() << std::endl;
+    }
+}
+
+void Shader::bind(Variant& variant)
+{
+    GLState::instance().useProgram(variant.program.get());
+    current = &variant;
+    
+    // 이 변형이 마지막으로 바인딩된 뒤 바뀐 값만 올림
+    if (variant.appliedRevision < revision)
+    {
+        for (uint32_t slot = 0; slot < uniforms.size(); slot++)
+        {
+            if (uniforms[slot].revision > variant.appliedRevision)
+                applyUniform(variant, slot);
+        }
+        variant.appliedRevision = revision;
+    }
+}
+
+uint32_t Shader::slotFor(const std::string& name, UniformKind kind)
+{
+    auto it = uniformSlots.find(name);
+    if (it != uniformSlots.end())
+    {
+        if (uniforms[it->second].kind == kind)
+            return it->second;
+        std::cout << "ERROR::SHADER::UNIFORM_TYPE_MISMATCH: " << name << std::endl;
+        return UniformHandle<int>::INVALID;
+    }
+    
+    uint32_t slot = static_cast<uint32_t>(uniforms.size());
+    uniformSlots.emplace(name, slot);
+    uniforms.emplace_back();
+    uniforms.back().name = name;
+    uniforms.back().kind = kind;
+    return slot;
+}
+
+void Shader::setSlot(uint32_t slot, const void* data, size_t elementSize, size_t count)
 {
-    glUseProgram(ID);
+    if (slot >= uniforms.size() || count == 0)
+        return;
+    
+    UniformValue& uniform = uniforms[slot];
+    size_t bytes = elementSize * count;
+    // 값이 같으면 GL 호출도, 다른 변형의 재적용도 필요 없음
+    if (uniform.revision != 0 && uniform.data.size() == bytes && std::memcmp(uniform.data.data(), data, bytes) == 0)
+    {
+        GLState::instance().countUniform(true);
+        return;
+    }
+    // 크기가 같으면 기존 버퍼에 덮어씀 (프레임마다 할당하지 않음)
+    uniform.data.resize(bytes);
+    std::memcpy(uniform.data.data(), data, bytes);
+    uniform.count = static_cast<GLsizei>(count);
+    
+    // current가 아직 바인딩되어 있을 때만 바로 올림. 다른 Shader가 프로그램을 바꿨으면 glUniform*이
+    // 그 프로그램에 들어가므로 리비전만 남겨 두고 다음 bind()에서 올림
+    bool currentBound = current && GLState::instance().boundProgram() == current->program.get();
+    // 바인딩된 변형이 최신 상태였다면 이 값까지 반영한 상태로 유지
+    bool currentUpToDate = currentBound && current->appliedRevision == revision;
+    uniform.revision = ++revision;
+    if (currentBound)
+    {
+        applyUniform(*current, slot);
+        if (currentUpToDate)
+            current->appliedRevision = revision;
+    }
+}
+
+const Shader::UniformBinding& Shader::binding(Variant& variant, uint32_t slot)
+{
+    if (variant.bindings.size() <= slot)
+        variant.bindings.resize(uniforms.size());
+    UniformBinding& result = variant.bindings[slot];
+    if (!result.resolved)
+    {
+        result.resolved = true;
+        const UniformValue& uniform = uniforms[slot];
+        for (const ActiveUniform& active : variant.active)
+        {
+            if (active.name != uniform.name)
+                continue;
+            if (matchesKind(active.type, uniform.kind))
+            {
+                result.location = active.location;
+                result.size = active.size;
+            }
+            else
+                std::cout << "ERROR::SHADER::UNIFORM_TYPE_MISMATCH: " << uniform.name << std::endl;
+            break;
+        }
+    }
+    return result;
+}
+
+void Shader::applyUniform(Variant& variant, uint32_t slot)
+{
+    const UniformBinding& target = binding(variant, slot);
+    // 변형에서 쓰지 않아 제거된 uniform
+    if (target.location < 0)
+        return;
+    
+    // 변형 바인딩 중에만 호출되므로 glUseProgram은 이미 되어 있음
+    const UniformValue& uniform = uniforms[slot];
+    GLState::instance().countUniform(false);
+    GLsizei count = std::min(uniform.count, target.size);
+    const GLint location = target.location;
+    const GLint* i = reinterpret_cast<const GLint*>(uniform.data.data());
+    const GLfloat* v = reinterpret_cast<const GLfloat*>(uniform.data.data());
+    switch (uniform.kind)
+    {
+        case UNIFORM_INT: glUniform1iv(location, count, i); break;
+        case UNIFORM_FLOAT: glUniform1fv(location, count, v); break;
+        case UNIFORM_VEC2: glUniform2fv(location, count, v); break;
+        case UNIFORM_VEC3: glUniform3fv(location, count, v); break;
+        case UNIFORM_VEC4: glUniform4fv(location, count, v); break;
+        case UNIFORM_MAT2: glUniformMatrix2fv(location, count, GL_FALSE, v); break;
+        case UNIFORM_MAT3: glUniformMatrix3fv(location, count, GL_FALSE, v); break;
+        case UNIFORM_MAT4: glUniformMatrix4fv(location, count, GL_FALSE, v); break;
+    }
 }
 
-void Shader::setBool(const std::string &name, bool value) const
+void Shader::setBool(const std::string &name, bool value)
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+    set(uniform<bool>(name), value);
 }
 
-void Shader::setInt(const std::string &name, int value) const
+void Shader::setInt(const std::string &name, int value)
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    set(uniform<int>(name), value);
 }
 
-void Shader::setFloat(const std::string &name, float value) const
+void Shader::setFloat(const std::string &name, float value)
 {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    set(uniform<float>(name), value);
 }
 
-void Shader::setVec2(const std::string &name, const glm::vec2 &value) const
+void Shader::setVec2(const std::string &name, const glm::vec2 &value)
 {
-    glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    set(uniform<glm::vec2>(name), value);
 }
 
-void Shader::setVec2(const std::string &name, float x, float y) const
+void Shader::setVec2(const std::string &name, float x, float y)
 {
-    glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+    setVec2(name, glm::vec2(x, y));
 }
 
-void Shader::setVec3(const std::string &name, const glm::vec3 &value) const
+void Shader::setVec3(const std::string &name, const glm::vec3 &value)
 {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    set(uniform<glm::vec3>(name), value);
 }
 
-void Shader::setVec3(const std::string &name, float x, float y, float z) const
+void Shader::setVec3(const std::string &name, float x, float y, float z)
 {
-    glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+    setVec3(name, glm::vec3(x, y, z));
 }
 
-void Shader::setVec4(const std::string &name, const glm::vec4 &value) const
+void Shader::setVec4(const std::string &name, const glm::vec4 &value)
 {
-    glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    set(uniform<glm::vec4>(name), value);
 }
 
-void Shader::setVec4(const std::string &name, float x, float y, float z, float w) const
+void Shader::setVec4(const std::string &name, float x, float y, float z, float w)
 {
-    glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+    setVec4(name, glm::vec4(x, y, z, w));
 }
 
-void Shader::setMat2(const std::string &name, const glm::mat2 &mat) const
+void Shader::setMat2(const std::string &name, const glm::mat2 &mat)
 {
-    glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    set(uniform<glm::mat2>(name), mat);
 }
 
-void Shader::setMat3(const std::string &name, const glm::mat3 &mat) const
+void Shader::setMat3(const std::string &name, const glm::mat3 &mat)
 {
-    glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    set(uniform<glm::mat3>(name), mat);
 }
 
-void Shader::setMat4(const std::string &name, const glm::mat4 &mat) const
+void Shader::setMat4(const std::string &name, const glm::mat4 &mat)
 {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    set(uniform<glm::mat4>(name), mat);
 }
 
-void Shader::checkCompileErrors(unsigned int shader, std::string type)
+bool Shader::checkCompileErrors(unsigned int shader, std::string type)
 {
     int success;
     char infoLog[1024];
@@ -145,5 +399,6 @@ void Shader::checkCompileErrors(unsigned int shader, std::string type)
             std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
         }
     }
+    return success != 0;
 }
 
@@ -0,0 +1,197 @@
+#include "../include/shader_cache.h"
+#include "../include/gl_capabilities.h"
+#include "../include/hash_util.h"
+#include "../include/mapped_file.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x47525042; // "BPRG"
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t binaryFormat;
+    uint32_t binaryLength;
+};
+
+#ifdef PBR_EMBEDDED_SHADERS
+struct EmbeddedShaderEntry {
+    const char* name;
+    const unsigned char* data;
+    size_t size;
+};
+
+// cmake/embed_shaders.cmake가 빌드 디렉터리에 생성 (embeddedShaderEntries 배열)
+#include "embedded_shaders_data.h"
+
+bool findEmbedded(const std::string& path, std::string& out)
+{
+    std::string name = path.substr(path.find_last_of("/\\") + 1);
+    for (const EmbeddedShaderEntry& entry : embeddedShaderEntries)
+    {
+        if (name == entry.name)
+        {
+            out.assign(reinterpret_cast<const char*>(entry.data), entry.size);
+            return true;
+        }
+    }
+    return false;
+}
+#else
+bool findEmbedded(const std::string&, std::string&)
+{
+    return false;
+}
+#endif
+
+} // namespace
+
+ShaderCacheSettings& ShaderCache::settings()
+{
+    static ShaderCacheSettings instance;
+    return instance;
+}
+
+bool ShaderCache::readSource(const std::string& path, std::string& out)
+{
+    if (settings().embeddedSources && findEmbedded(path, out))
+        return true;
+    
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << path << std::endl;
+        return false;
+    }
+    std::stringstream stream;
+    stream << file.rdbuf();
+    out = stream.str();
+    return true;
+}
+
+std::string ShaderCache::pathFor(const std::string& vertexPath, const std::string& fragmentPath,
+                                 const std::string& variantName)
+{
+    // 같은 프래그먼트 셰이더를 다른 정점 셰이더와 묶는 경우를 구분
+    std::string vertexName = vertexPath.substr(vertexPath.find_last_of("/\\") + 1);
+    std::string path = fragmentPath + "." + vertexName;
+    if (!variantName.empty())
+        path += "." + variantName;
+    return path + ".glprogram";
+}
+
+uint64_t ShaderCache::computeKey(const std::string& vertexCode, const std::string& fragmentCode)
+{
+    // 드라이버 업데이트 후 예전 바이너리는 거부되거나 (최악의 경우) 잘못 동작할 수 있으므로 키에 포함
+    const GLCapabilities& caps = GLCapabilities::get();
+    const std::string* parts[] = { &vertexCode, &fragmentCode, &caps.vendor, &caps.renderer, &caps.version };
+    
+    uint64_t key = 0xCBF29CE484222325ull ^ (static_cast<uint64_t>(VERSION) << 32);
+    for (const std::string* part : parts)
+        key = hashBytes(reinterpret_cast<const unsigned char*>(part->data()), part->size(), key);
+    return key != 0 ? key : 1;
+}
+
+bool ShaderCache::available()
+{
+    return settings().enabled && GLCapabilities::get().programBinary;
+}
+
+bool ShaderCache::load(GLuint program, const std::string& cachePath, uint64_t key)
+{
+    if (!available())
+        return false;
+    
+    MappedFile file;
+    if (!file.open(cachePath))
+        return false;
+    
+    FileHeader header;
+    if (file.size() < sizeof(header))
+        return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != CACHE_MAGIC || header.version != VERSION || header.key != key ||
+        header.binaryLength == 0 || sizeof(header) + static_cast<size_t>(header.binaryLength) > file.size())
+    {
+        std::cout << "  Shader cache stale, relinking: " << cachePath << std::endl;
+        return false;
+    }
+    
+    const GLCapabilities& caps = GLCapabilities::get();
+    caps.programBinaryUpload(program, header.binaryFormat, file.data() + sizeof(header),
+                             static_cast<GLsizei>(header.binaryLength));
+    // 지원하지 않는 포맷이면 GL_INVALID_ENUM이 남으므로 비워 둠
+    while (glGetError() != GL_NO_ERROR) {}
+    
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        std::cout << "  Shader cache rejected by driver, relinking: " << cachePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ShaderCache::save(GLuint program, const std::string& cachePath, uint64_t key)
+{
+    if (!available())
+        return false;
+    
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+    
+    std::vector<unsigned char> binary(static_cast<size_t>(length));
+    GLsizei written = 0;
+    GLenum format = 0;
+    GLCapabilities::get().getProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0)
+        return false;
+    
+    FileHeader header;
+    header.magic = CACHE_MAGIC;
+    header.version = VERSION;
+    header.key = key;
+    header.binaryFormat = format;
+    header.binaryLength = static_cast<uint32_t>(written);
+    
+    // 다른 프로세스가 동시에 읽어도 반쯤 쓴 파일을 보지 않도록 임시 파일에 쓴 뒤 교체
+    std::string tempPath = cachePath + ".tmp" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cout << "  Shader cache: cannot write " << tempPath << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(binary.data()), written);
+        if (!out)
+        {
+            out.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    
+    std::remove(cachePath.c_str());
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    
+    std::cout << "  Shader cache written: " << cachePath << std::endl;
+    return true;
+}
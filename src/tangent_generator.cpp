@@ -0,0 +1,319 @@
+#include "../include/tangent_generator.h"
+#include "../include/hash_util.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define TANGENT_GENERATOR_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace {
+
+// 블록 하나가 맡는 삼각형 수 (꼭짓점 수가 4의 배수가 되도록)
+constexpr size_t BLOCK_TRIANGLES = 256;
+constexpr size_t BLOCK_CORNERS = BLOCK_TRIANGLES * 3;
+constexpr unsigned int INVALID_INDEX = ~0u;
+// MikkTSpace의 VNotZero와 같은 기준
+const float MIN_LENGTH_SQ = std::numeric_limits<float>::min();
+
+// UV 방향 비트 (정점 하나가 두 방향 모두에 쓰이면 복제)
+enum Orientation : unsigned char {
+    ORIENT_NONE = 0,
+    ORIENT_POSITIVE = 1,
+    ORIENT_NEGATIVE = 2
+};
+
+// 위치/노말/UV (Vertex 앞쪽 연속 구간)가 비트 단위로 같은 정점을 MikkTSpace처럼 하나로 본다
+constexpr size_t WELD_BYTES = offsetof(Vertex, Tangent);
+
+// 꼭짓점 블록 (SoA: 같은 성분끼리 연속이라 SSE로 4개씩 읽음)
+struct CornerBlock {
+    float nx[BLOCK_CORNERS], ny[BLOCK_CORNERS], nz[BLOCK_CORNERS]; // 꼭짓점 노말
+    float tx[BLOCK_CORNERS], ty[BLOCK_CORNERS], tz[BLOCK_CORNERS]; // 삼각형 탄젠트 -> 노말 평면에 투영
+    float ax[BLOCK_CORNERS], ay[BLOCK_CORNERS], az[BLOCK_CORNERS]; // 이전 꼭짓점으로 향하는 변
+    float bx[BLOCK_CORNERS], by[BLOCK_CORNERS], bz[BLOCK_CORNERS]; // 다음 꼭짓점으로 향하는 변
+    float weight[BLOCK_CORNERS]; // 위치가 퇴화한 삼각형은 0, 계산 후에는 내각
+};
+
+// 삼각형 count개의 꼭짓점을 블록에 채우고 삼각형별 UV 부호 면적을 기록
+void fillBlock(const std::vector<Vertex>& vertices, const unsigned int* triangles, size_t count,
+               CornerBlock& block, float* signedAreas)
+{
+    for (size_t t = 0; t < count; t++)
+    {
+        const unsigned int* triangle = triangles + t * 3;
+        const Vertex& v0 = vertices[triangle[0]];
+        const Vertex& v1 = vertices[triangle[1]];
+        const Vertex& v2 = vertices[triangle[2]];
+        glm::vec3 d1 = v1.Position - v0.Position;
+        glm::vec3 d2 = v2.Position - v0.Position;
+        glm::vec2 t21 = v1.TexCoords - v0.TexCoords;
+        glm::vec2 t31 = v2.TexCoords - v0.TexCoords;
+        signedAreas[t] = t21.x * t31.y - t21.y * t31.x;
+        // 정규화는 투영 후에 하므로 방향만 필요 (MikkTSpace vOs, 면적 부호를 곱해 미러링 UV에서도 +U 방향)
+        // UV 면적이 0인 삼각형은 기여하지 않음
+        float orientation = signedAreas[t] > 0.0f ? 1.0f : (signedAreas[t] < 0.0f ? -1.0f : 0.0f);
+        glm::vec3 tangent = (d1 * t31.y - d2 * t21.y) * orientation;
+        bool degenerate = v0.Position == v1.Position || v1.Position == v2.Position || v0.Position == v2.Position;
+        
+        for (int c = 0; c < 3; c++)
+        {
+            size_t k = t * 3 + c;
+            const Vertex& corner = vertices[triangle[c]];
+            const glm::vec3& previous = vertices[triangle[(c + 2) % 3]].Position;
+            const glm::vec3& next = vertices[triangle[(c + 1) % 3]].Position;
+            block.nx[k] = corner.Normal.x;
+            block.ny[k] = corner.Normal.y;
+            block.nz[k] = corner.Normal.z;
+            block.tx[k] = tangent.x;
+            block.ty[k] = tangent.y;
+            block.tz[k] = tangent.z;
+            block.ax[k] = previous.x - corner.Position.x;
+            block.ay[k] = previous.y - corner.Position.y;
+            block.az[k] = previous.z - corner.Position.z;
+            block.bx[k] = next.x - corner.Position.x;
+            block.by[k] = next.y - corner.Position.y;
+            block.bz[k] = next.z - corner.Position.z;
+            block.weight[k] = degenerate ? 0.0f : 1.0f;
+        }
+    }
+}
+
+// v -= n * dot(n, v) 후 정규화 (길이가 0이면 0 벡터)
+void projectAndNormalize(const CornerBlock& block, float* x, float* y, float* z, size_t count)
+{
+    size_t i = 0;
+#ifdef TANGENT_GENERATOR_SSE
+    const __m128 minLengthSq = _mm_set1_ps(MIN_LENGTH_SQ);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 nx = _mm_loadu_ps(block.nx + i), ny = _mm_loadu_ps(block.ny + i), nz = _mm_loadu_ps(block.nz + i);
+        __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+        __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, vx), _mm_mul_ps(ny, vy)), _mm_mul_ps(nz, vz));
+        vx = _mm_sub_ps(vx, _mm_mul_ps(nx, d));
+        vy = _mm_sub_ps(vy, _mm_mul_ps(ny, d));
+        vz = _mm_sub_ps(vz, _mm_mul_ps(nz, d));
+        __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+        // 길이가 0이면 1/sqrt(0) = inf를 마스크로 지워 0 벡터로 만듦
+        __m128 scale = _mm_and_ps(_mm_cmpgt_ps(lengthSq, minLengthSq), _mm_div_ps(one, _mm_sqrt_ps(lengthSq)));
+        _mm_storeu_ps(x + i, _mm_mul_ps(vx, scale));
+        _mm_storeu_ps(y + i, _mm_mul_ps(vy, scale));
+        _mm_storeu_ps(z + i, _mm_mul_ps(vz, scale));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        float d = block.nx[i] * x[i] + block.ny[i] * y[i] + block.nz[i] * z[i];
+        float vx = x[i] - block.nx[i] * d;
+        float vy = y[i] - block.ny[i] * d;
+        float vz = z[i] - block.nz[i] * d;
+        float lengthSq = vx * vx + vy * vy + vz * vz;
+        float scale = lengthSq > MIN_LENGTH_SQ ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+        x[i] = vx * scale;
+        y[i] = vy * scale;
+        z[i] = vz * scale;
+    }
+}
+
+// weight *= 투영된 두 변 사이의 내각
+void applyCornerAngles(CornerBlock& block, size_t count)
+{
+    size_t i = 0;
+#ifdef TANGENT_GENERATOR_SSE
+    const __m128 lower = _mm_set1_ps(-1.0f);
+    const __m128 upper = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 cosine = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(block.ax + i), _mm_loadu_ps(block.bx + i)),
+                                              _mm_mul_ps(_mm_loadu_ps(block.ay + i), _mm_loadu_ps(block.by + i))),
+                                   _mm_mul_ps(_mm_loadu_ps(block.az + i), _mm_loadu_ps(block.bz + i)));
+        _mm_storeu_ps(block.ax + i, _mm_min_ps(_mm_max_ps(cosine, lower), upper));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        float cosine = block.ax[i] * block.bx[i] + block.ay[i] * block.by[i] + block.az[i] * block.bz[i];
+        block.ax[i] = std::clamp(cosine, -1.0f, 1.0f);
+    }
+    // acos는 벡터화하지 않음 (MikkTSpace와 같은 가중치를 쓰려고 근사하지 않음)
+    for (i = 0; i < count; i++)
+        block.weight[i] *= std::acos(block.ax[i]);
+}
+
+// 정점마다 위치/노말/UV가 같은 첫 정점 번호 (열린 주소법 해시 테이블, 노드 할당 없음)
+std::vector<unsigned int> findRepresentatives(const std::vector<Vertex>& vertices)
+{
+    size_t capacity = 1;
+    while (capacity < vertices.size() * 2)
+        capacity <<= 1;
+    std::vector<unsigned int> table(capacity, INVALID_INDEX);
+    std::vector<unsigned int> representative(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        const unsigned char* key = reinterpret_cast<const unsigned char*>(&vertices[i]);
+        size_t slot = static_cast<size_t>(hashBytes(key, WELD_BYTES, 0)) & (capacity - 1);
+        while (true)
+        {
+            unsigned int existing = table[slot];
+            if (existing == INVALID_INDEX)
+            {
+                table[slot] = static_cast<unsigned int>(i);
+                representative[i] = static_cast<unsigned int>(i);
+                break;
+            }
+            if (std::memcmp(&vertices[existing], key, WELD_BYTES) == 0)
+            {
+                representative[i] = existing;
+                break;
+            }
+            slot = (slot + 1) & (capacity - 1);
+        }
+    }
+    return representative;
+}
+
+// 기여가 없는 정점용: 노말에 수직인 아무 방향
+glm::vec3 perpendicular(const glm::vec3& normal)
+{
+    glm::vec3 axis = std::fabs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 tangent = glm::cross(axis, normal);
+    float length = glm::length(tangent);
+    return length > 0.0f ? tangent / length : glm::vec3(1.0f, 0.0f, 0.0f);
+}
+
+} // namespace
+
+namespace TangentGenerator {
+
+TangentGeneratorSettings& settings()
+{
+    static TangentGeneratorSettings instance;
+    return instance;
+}
+
+uint64_t settingsSeed(const TangentGeneratorSettings& settings)
+{
+    uint64_t values[2] = {settings.enabled ? 1u : 0u, settings.force ? 1u : 0u};
+    return hashBytes(reinterpret_cast<const unsigned char*>(values), sizeof(values), 0x74616Eull);
+}
+
+size_t generate(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, ThreadPool& pool)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertices.empty())
+        return 0;
+    
+    // 1) 꼭짓점마다 (투영된 삼각형 탄젠트 * 내각) 계산. 블록끼리 독립이라 워커에 나눔
+    std::vector<glm::vec3> contributions(triangleCount * 3);
+    std::vector<float> signedAreas(triangleCount);
+    size_t blockCount = (triangleCount + BLOCK_TRIANGLES - 1) / BLOCK_TRIANGLES;
+    pool.parallelFor(blockCount, 1, [&](size_t beginBlock, size_t endBlock) {
+        auto block = std::make_unique<CornerBlock>();
+        for (size_t b = beginBlock; b < endBlock; b++)
+        {
+            size_t firstTriangle = b * BLOCK_TRIANGLES;
+            size_t count = std::min(BLOCK_TRIANGLES, triangleCount - firstTriangle);
+            size_t corners = count * 3;
+            fillBlock(vertices, indices.data() + firstTriangle * 3, count, *block, signedAreas.data() + firstTriangle);
+            projectAndNormalize(*block, block->tx, block->ty, block->tz, corners);
+            projectAndNormalize(*block, block->ax, block->ay, block->az, corners);
+            projectAndNormalize(*block, block->bx, block->by, block->bz, corners);
+            applyCornerAngles(*block, corners);
+            
+            glm::vec3* out = contributions.data() + firstTriangle * 3;
+            for (size_t k = 0; k < corners; k++)
+                out[k] = glm::vec3(block->tx[k], block->ty[k], block->tz[k]) * block->weight[k];
+        }
+    });
+    
+    // 2) 위치/노말/UV가 같은 정점을 대표 정점 하나로 (인덱스가 달라도 같은 그룹)
+    std::vector<unsigned int> representative = findRepresentatives(vertices);
+    
+    // 3) 삼각형 방향. UV 면적이 0인 삼각형은 이웃이 쓰는 방향을 따름 (MikkTSpace GROUP_WITH_ANY)
+    std::vector<unsigned char> triangleOrientation(triangleCount);
+    std::vector<unsigned char> groupUsage(vertices.size(), ORIENT_NONE);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        if (signedAreas[t] == 0.0f)
+            continue;
+        triangleOrientation[t] = signedAreas[t] > 0.0f ? ORIENT_POSITIVE : ORIENT_NEGATIVE;
+        for (int c = 0; c < 3; c++)
+            groupUsage[representative[indices[t * 3 + c]]] |= triangleOrientation[t];
+    }
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        if (signedAreas[t] != 0.0f)
+            continue;
+        unsigned char usage = groupUsage[representative[indices[t * 3]]];
+        triangleOrientation[t] = (usage & ORIENT_POSITIVE) || usage == ORIENT_NONE ? ORIENT_POSITIVE : ORIENT_NEGATIVE;
+    }
+    
+    // 4) (대표 정점, 방향) 그룹마다 기여 합산. 정점 인덱스마다 쓰인 방향도 기록
+    std::vector<glm::vec3> sums(vertices.size() * 2, glm::vec3(0.0f));
+    std::vector<unsigned char> vertexUsage(vertices.size(), ORIENT_NONE);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        size_t side = triangleOrientation[t] == ORIENT_NEGATIVE ? 1 : 0;
+        for (int c = 0; c < 3; c++)
+        {
+            unsigned int index = indices[t * 3 + c];
+            sums[static_cast<size_t>(representative[index]) * 2 + side] += contributions[t * 3 + c];
+            vertexUsage[index] |= triangleOrientation[t];
+        }
+    }
+    
+    // 5) 두 방향에 모두 쓰인 정점은 음의 방향용 사본을 뒤에 추가
+    size_t originalCount = vertices.size();
+    std::vector<unsigned int> negativeCopy(originalCount, INVALID_INDEX);
+    vertices.reserve(originalCount + std::count(vertexUsage.begin(), vertexUsage.end(),
+                                                static_cast<unsigned char>(ORIENT_POSITIVE | ORIENT_NEGATIVE)));
+    for (size_t i = 0; i < originalCount; i++)
+    {
+        if (vertexUsage[i] == (ORIENT_POSITIVE | ORIENT_NEGATIVE))
+        {
+            negativeCopy[i] = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(vertices[i]);
+        }
+    }
+    
+    auto writeTangent = [&](Vertex& vertex, const glm::vec3& sum, float sign) {
+        float lengthSq = glm::dot(sum, sum);
+        vertex.Tangent = lengthSq > MIN_LENGTH_SQ ? sum / std::sqrt(lengthSq) : perpendicular(vertex.Normal);
+        vertex.Bitangent = glm::cross(vertex.Normal, vertex.Tangent) * sign;
+    };
+    for (size_t i = 0; i < originalCount; i++)
+    {
+        if (vertexUsage[i] == ORIENT_NONE)
+            continue;
+        size_t group = static_cast<size_t>(representative[i]) * 2;
+        bool negative = vertexUsage[i] == ORIENT_NEGATIVE;
+        writeTangent(vertices[i], sums[group + (negative ? 1 : 0)], negative ? -1.0f : 1.0f);
+        if (negativeCopy[i] != INVALID_INDEX)
+            writeTangent(vertices[negativeCopy[i]], sums[group + 1], -1.0f);
+    }
+    
+    size_t added = vertices.size() - originalCount;
+    if (added > 0)
+    {
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            if (triangleOrientation[t] != ORIENT_NEGATIVE)
+                continue;
+            for (int c = 0; c < 3; c++)
+            {
+                unsigned int& index = indices[t * 3 + c];
+                if (index < originalCount && negativeCopy[index] != INVALID_INDEX)
+                    index = negativeCopy[index];
+            }
+        }
+    }
+    return added;
+}
+
+} // namespace TangentGenerator
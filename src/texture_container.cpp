@@ -0,0 +1,487 @@
+#include "../include/texture_container.h"
+#include "../include/gl_capabilities.h"
+#include "../include/mapped_file.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+const unsigned char KTX2_IDENTIFIER[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+const char* SOURCE_KEY_NAME = "PBRsourceKey";
+
+// KTX2는 Vulkan 포맷 번호를 사용
+enum VkFormat : uint32_t {
+    VK_FORMAT_R8_UNORM = 9,
+    VK_FORMAT_R8G8_UNORM = 16,
+    VK_FORMAT_R8G8B8_UNORM = 23,
+    VK_FORMAT_R8G8B8_SRGB = 29,
+    VK_FORMAT_R8G8B8A8_UNORM = 37,
+    VK_FORMAT_R8G8B8A8_SRGB = 43,
+    VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131,
+    VK_FORMAT_BC1_RGB_SRGB_BLOCK = 132,
+    VK_FORMAT_BC1_RGBA_UNORM_BLOCK = 133,
+    VK_FORMAT_BC1_RGBA_SRGB_BLOCK = 134,
+    VK_FORMAT_BC2_UNORM_BLOCK = 135,
+    VK_FORMAT_BC2_SRGB_BLOCK = 136,
+    VK_FORMAT_BC3_UNORM_BLOCK = 137,
+    VK_FORMAT_BC3_SRGB_BLOCK = 138,
+    VK_FORMAT_BC4_UNORM_BLOCK = 139,
+    VK_FORMAT_BC5_UNORM_BLOCK = 141,
+    VK_FORMAT_BC7_UNORM_BLOCK = 145,
+    VK_FORMAT_BC7_SRGB_BLOCK = 146
+};
+
+struct FormatInfo {
+    unsigned int internalFormat;
+    unsigned int format;   // 비압축 업로드 포맷
+    int channels;          // 비압축 픽셀당 바이트
+};
+
+// sRGB 포맷도 UNORM으로 올린다: 셰이더가 albedoIsSRGB 토글로 직접 선형 변환하기 때문
+bool formatFromVk(uint32_t vkFormat, FormatInfo& info)
+{
+    switch (vkFormat)
+    {
+        case VK_FORMAT_R8_UNORM:             info = {GL_R8, GL_RED, 1}; return true;
+        case VK_FORMAT_R8G8_UNORM:           info = {GL_RG8, GL_RG, 2}; return true;
+        case VK_FORMAT_R8G8B8_UNORM:
+        case VK_FORMAT_R8G8B8_SRGB:          info = {GL_RGB8, GL_RGB, 3}; return true;
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:        info = {GL_RGBA8, GL_RGBA, 4}; return true;
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:   info = {GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 0, 0}; return true;
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:  info = {GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 0, 0}; return true;
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:       info = {GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 0, 0}; return true;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:       info = {GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 0, 0}; return true;
+        case VK_FORMAT_BC4_UNORM_BLOCK:      info = {GL_COMPRESSED_RED_RGTC1, 0, 0}; return true;
+        case VK_FORMAT_BC5_UNORM_BLOCK:      info = {GL_COMPRESSED_RG_RGTC2, 0, 0}; return true;
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:       info = {GL_COMPRESSED_RGBA_BPTC_UNORM, 0, 0}; return true;
+        default: return false;
+    }
+}
+
+uint32_t vkFromFormat(unsigned int internalFormat)
+{
+    switch (internalFormat)
+    {
+        case GL_R8:                             return VK_FORMAT_R8_UNORM;
+        case GL_RG8:                            return VK_FORMAT_R8G8_UNORM;
+        case GL_RGB8:                           return VK_FORMAT_R8G8B8_UNORM;
+        case GL_RGBA8:                          return VK_FORMAT_R8G8B8A8_UNORM;
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:   return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:  return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:  return VK_FORMAT_BC2_UNORM_BLOCK;
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:  return VK_FORMAT_BC3_UNORM_BLOCK;
+        case GL_COMPRESSED_RED_RGTC1:           return VK_FORMAT_BC4_UNORM_BLOCK;
+        case GL_COMPRESSED_RG_RGTC2:            return VK_FORMAT_BC5_UNORM_BLOCK;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:     return VK_FORMAT_BC7_UNORM_BLOCK;
+        default:                                return 0;
+    }
+}
+
+size_t levelBytes(const DecodedImage& image, int width, int height)
+{
+    if (image.compressed)
+        return compressedLevelBytes(image.internalFormat, width, height);
+    return static_cast<size_t>(width) * height * image.channels;
+}
+
+// 현재 드라이버가 올릴 수 없는 압축 포맷이면 거부 (호출자가 PNG로 폴백)
+bool formatUsable(const FormatInfo& info)
+{
+    if (compressedBlockBytes(info.internalFormat) == 0)
+        return true;
+    return GLCapabilities::get().supportsCompressedFormat(info.internalFormat);
+}
+
+template <class T>
+T readValue(const unsigned char* data, size_t offset)
+{
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+void appendU32(std::string& out, uint32_t value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void appendU64(std::string& out, uint64_t value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void padTo(std::string& out, size_t alignment)
+{
+    while (out.size() % alignment != 0)
+        out.push_back('\0');
+}
+
+// KTX2 필수 항목인 Data Format Descriptor (Khronos Basic Descriptor Block)
+std::string buildDFD(const DecodedImage& image)
+{
+    struct Sample { uint32_t bitOffset; uint32_t bitLength; uint32_t channel; uint32_t upper; };
+    
+    uint32_t colorModel = 1; // RGBSDA
+    uint32_t blockDim = 0;
+    uint32_t bytesPlane0 = static_cast<uint32_t>(image.channels);
+    std::vector<Sample> samples;
+    
+    switch (image.internalFormat)
+    {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            colorModel = 128; samples = {{0, 64, 0, 0xFFFFFFFFu}}; break;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+            colorModel = 129; samples = {{0, 64, 15, 0xFFFFFFFFu}, {64, 64, 0, 0xFFFFFFFFu}}; break;
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            colorModel = 130; samples = {{0, 64, 15, 0xFFFFFFFFu}, {64, 64, 0, 0xFFFFFFFFu}}; break;
+        case GL_COMPRESSED_RED_RGTC1:
+            colorModel = 131; samples = {{0, 64, 0, 0xFFFFFFFFu}}; break;
+        case GL_COMPRESSED_RG_RGTC2:
+            colorModel = 132; samples = {{0, 64, 0, 0xFFFFFFFFu}, {64, 64, 1, 0xFFFFFFFFu}}; break;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+            colorModel = 134; samples = {{0, 128, 0, 0xFFFFFFFFu}}; break;
+        default:
+        {
+            const uint32_t channelIds[4] = {0, 1, 2, 15};
+            for (int c = 0; c < image.channels; c++)
+                samples.push_back({static_cast<uint32_t>(c * 8), 8, channelIds[c], 255});
+            break;
+        }
+    }
+    if (image.compressed)
+    {
+        blockDim = 3 | (3 << 8); // 4x4 블록 (값 - 1로 기록)
+        bytesPlane0 = static_cast<uint32_t>(compressedBlockBytes(image.internalFormat));
+    }
+    
+    const uint32_t primariesBT709 = 1;
+    const uint32_t transferLinear = 1;
+    uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(samples.size());
+    
+    std::string dfd;
+    appendU32(dfd, 4 + blockSize);
+    appendU32(dfd, 0);                       // vendorId = Khronos, descriptorType = basic
+    appendU32(dfd, 2 | (blockSize << 16));   // versionNumber = 2
+    appendU32(dfd, colorModel | (primariesBT709 << 8) | (transferLinear << 16));
+    appendU32(dfd, blockDim);
+    appendU32(dfd, bytesPlane0);
+    appendU32(dfd, 0);
+    for (const Sample& sample : samples)
+    {
+        appendU32(dfd, sample.bitOffset | ((sample.bitLength - 1) << 16) | (sample.channel << 24));
+        appendU32(dfd, 0);
+        appendU32(dfd, 0);
+        appendU32(dfd, sample.upper);
+    }
+    return dfd;
+}
+
+} // namespace
+
+size_t compressedBlockBytes(unsigned int internalFormat)
+{
+    switch (internalFormat)
+    {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RED_RGTC1:
+            return 8;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RG_RGTC2:
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+size_t compressedLevelBytes(unsigned int internalFormat, int width, int height)
+{
+    size_t blocksX = static_cast<size_t>(std::max(1, (width + 3) / 4));
+    size_t blocksY = static_cast<size_t>(std::max(1, (height + 3) / 4));
+    return blocksX * blocksY * compressedBlockBytes(internalFormat);
+}
+
+namespace TextureContainer {
+
+bool readKTX2(const std::string& path, DecodedImage& out, std::string* sourceKey)
+{
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path))
+        return false;
+    
+    const unsigned char* data = file->data();
+    size_t size = file->size();
+    const size_t headerSize = 80;
+    if (size < headerSize || std::memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+        return false;
+    
+    uint32_t vkFormat = readValue<uint32_t>(data, 12);
+    uint32_t width = readValue<uint32_t>(data, 20);
+    uint32_t height = readValue<uint32_t>(data, 24);
+    uint32_t depth = readValue<uint32_t>(data, 28);
+    uint32_t layerCount = readValue<uint32_t>(data, 32);
+    uint32_t faceCount = readValue<uint32_t>(data, 36);
+    uint32_t levelCount = std::max(1u, readValue<uint32_t>(data, 40));
+    uint32_t supercompression = readValue<uint32_t>(data, 44);
+    uint32_t kvdOffset = readValue<uint32_t>(data, 56);
+    uint32_t kvdLength = readValue<uint32_t>(data, 60);
+    
+    // 2D 단일 텍스처, 초압축 없음만 지원
+    FormatInfo info;
+    if (depth > 1 || layerCount > 1 || faceCount != 1 || supercompression != 0 ||
+        width == 0 || height == 0 || !formatFromVk(vkFormat, info) || !formatUsable(info))
+        return false;
+    if (headerSize + static_cast<size_t>(levelCount) * 24 > size || kvdOffset + static_cast<size_t>(kvdLength) > size)
+        return false;
+    
+    DecodedImage image;
+    image.internalFormat = info.internalFormat;
+    image.format = info.format;
+    image.channels = info.channels;
+    image.compressed = compressedBlockBytes(info.internalFormat) != 0;
+    
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        uint64_t byteOffset = readValue<uint64_t>(data, headerSize + level * 24);
+        uint64_t byteLength = readValue<uint64_t>(data, headerSize + level * 24 + 8);
+        
+        DecodedImage::Level mip;
+        mip.width = std::max(1, static_cast<int>(width >> level));
+        mip.height = std::max(1, static_cast<int>(height >> level));
+        mip.size = levelBytes(image, mip.width, mip.height);
+        if (byteLength != mip.size || byteOffset + byteLength > size)
+            return false;
+        mip.data = data + byteOffset;
+        image.levels.push_back(mip);
+    }
+    
+    if (sourceKey)
+    {
+        sourceKey->clear();
+        size_t offset = kvdOffset;
+        size_t end = kvdOffset + kvdLength;
+        while (offset + 4 <= end)
+        {
+            uint32_t entryLength = readValue<uint32_t>(data, offset);
+            const char* entry = reinterpret_cast<const char*>(data + offset + 4);
+            if (offset + 4 + entryLength > end)
+                break;
+            size_t keyLength = strnlen(entry, entryLength);
+            if (keyLength < entryLength && std::strcmp(entry, SOURCE_KEY_NAME) == 0)
+            {
+                const char* value = entry + keyLength + 1;
+                *sourceKey = std::string(value, strnlen(value, entryLength - keyLength - 1));
+            }
+            offset += 4 + ((entryLength + 3) & ~3u);
+        }
+    }
+    
+    image.storage = file;
+    image.resolvedPath = path;
+    out = std::move(image);
+    return true;
+}
+
+bool readDDS(const std::string& path, DecodedImage& out)
+{
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path))
+        return false;
+    
+    const unsigned char* data = file->data();
+    size_t size = file->size();
+    if (size < 128 || std::memcmp(data, "DDS ", 4) != 0 || readValue<uint32_t>(data, 4) != 124)
+        return false;
+    
+    uint32_t height = readValue<uint32_t>(data, 12);
+    uint32_t width = readValue<uint32_t>(data, 16);
+    uint32_t mipCount = std::max(1u, readValue<uint32_t>(data, 28));
+    uint32_t pixelFlags = readValue<uint32_t>(data, 80);
+    uint32_t fourCC = readValue<uint32_t>(data, 84);
+    uint32_t caps2 = readValue<uint32_t>(data, 112);
+    
+    auto makeFourCC = [](const char* code) {
+        return static_cast<uint32_t>(code[0]) | (static_cast<uint32_t>(code[1]) << 8) |
+               (static_cast<uint32_t>(code[2]) << 16) | (static_cast<uint32_t>(code[3]) << 24);
+    };
+    
+    const uint32_t DDPF_FOURCC = 0x4;
+    const uint32_t DDSCAPS2_CUBEMAP = 0x200;
+    if (!(pixelFlags & DDPF_FOURCC) || (caps2 & DDSCAPS2_CUBEMAP) || width == 0 || height == 0)
+        return false;
+    
+    size_t dataOffset = 128;
+    unsigned int internalFormat = 0;
+    if (fourCC == makeFourCC("DXT1"))
+        internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    else if (fourCC == makeFourCC("DXT3"))
+        internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+    else if (fourCC == makeFourCC("DXT5"))
+        internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    else if (fourCC == makeFourCC("ATI1") || fourCC == makeFourCC("BC4U"))
+        internalFormat = GL_COMPRESSED_RED_RGTC1;
+    else if (fourCC == makeFourCC("ATI2") || fourCC == makeFourCC("BC5U"))
+        internalFormat = GL_COMPRESSED_RG_RGTC2;
+    else if (fourCC == makeFourCC("DX10"))
+    {
+        // DXGI_FORMAT 번호
+        if (size < 148 || readValue<uint32_t>(data, 140) != 3 /* TEXTURE2D */ || readValue<uint32_t>(data, 144) > 1)
+            return false;
+        switch (readValue<uint32_t>(data, 128))
+        {
+            case 71: case 72: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+            case 74: case 75: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; break;
+            case 77: case 78: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+            case 80:          internalFormat = GL_COMPRESSED_RED_RGTC1; break;
+            case 83:          internalFormat = GL_COMPRESSED_RG_RGTC2; break;
+            case 98: case 99: internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+            default: return false;
+        }
+        dataOffset = 148;
+    }
+    
+    if (internalFormat == 0 || !GLCapabilities::get().supportsCompressedFormat(internalFormat))
+        return false;
+    
+    DecodedImage image;
+    image.internalFormat = internalFormat;
+    image.compressed = true;
+    
+    // DDS는 큰 레벨부터 순서대로 이어 붙어 있음
+    size_t offset = dataOffset;
+    for (uint32_t level = 0; level < mipCount; level++)
+    {
+        DecodedImage::Level mip;
+        mip.width = std::max(1, static_cast<int>(width >> level));
+        mip.height = std::max(1, static_cast<int>(height >> level));
+        mip.size = compressedLevelBytes(internalFormat, mip.width, mip.height);
+        if (offset + mip.size > size)
+            return false;
+        mip.data = data + offset;
+        offset += mip.size;
+        image.levels.push_back(mip);
+    }
+    
+    image.storage = file;
+    image.resolvedPath = path;
+    out = std::move(image);
+    return true;
+}
+
+bool writeKTX2(const std::string& path, const DecodedImage& image, const std::string& sourceKey)
+{
+    uint32_t vkFormat = vkFromFormat(image.internalFormat);
+    if (vkFormat == 0 || !image.isValid())
+        return false;
+    
+    const size_t headerSize = 80;
+    uint32_t levelCount = static_cast<uint32_t>(image.levels.size());
+    size_t levelIndexSize = static_cast<size_t>(levelCount) * 24;
+    
+    std::string dfd = buildDFD(image);
+    
+    std::string kvd;
+    std::string keyValue = std::string(SOURCE_KEY_NAME) + '\0' + sourceKey + '\0';
+    appendU32(kvd, static_cast<uint32_t>(keyValue.size()));
+    kvd += keyValue;
+    padTo(kvd, 4);
+    
+    size_t dfdOffset = headerSize + levelIndexSize;
+    size_t kvdOffset = dfdOffset + dfd.size();
+    size_t dataStart = kvdOffset + kvd.size();
+    
+    // 레벨 데이터는 블록(또는 텍셀) 크기와 4의 최소공배수로 정렬, 작은 레벨부터 기록
+    size_t texelBytes = image.compressed ? compressedBlockBytes(image.internalFormat) : static_cast<size_t>(image.channels);
+    size_t alignment = 4;
+    while (alignment % texelBytes != 0)
+        alignment += 4;
+    
+    std::vector<uint64_t> levelOffsets(levelCount);
+    size_t offset = dataStart;
+    for (int level = static_cast<int>(levelCount) - 1; level >= 0; level--)
+    {
+        offset = (offset + alignment - 1) / alignment * alignment;
+        levelOffsets[level] = offset;
+        offset += image.levels[level].size;
+    }
+    
+    std::string header(reinterpret_cast<const char*>(KTX2_IDENTIFIER), sizeof(KTX2_IDENTIFIER));
+    appendU32(header, vkFormat);
+    appendU32(header, 1);   // typeSize
+    appendU32(header, static_cast<uint32_t>(image.width()));
+    appendU32(header, static_cast<uint32_t>(image.height()));
+    appendU32(header, 0);   // pixelDepth
+    appendU32(header, 0);   // layerCount
+    appendU32(header, 1);   // faceCount
+    appendU32(header, levelCount);
+    appendU32(header, 0);   // supercompressionScheme
+    appendU32(header, static_cast<uint32_t>(dfdOffset));
+    appendU32(header, static_cast<uint32_t>(dfd.size()));
+    appendU32(header, static_cast<uint32_t>(kvdOffset));
+    appendU32(header, static_cast<uint32_t>(kvd.size()));
+    appendU64(header, 0);   // sgdByteOffset
+    appendU64(header, 0);   // sgdByteLength
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        appendU64(header, levelOffsets[level]);
+        appendU64(header, image.levels[level].size);
+        appendU64(header, image.levels[level].size);
+    }
+    header += dfd;
+    header += kvd;
+    
+    std::string tempPath = path + ".tmp" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    {
+        std::ofstream outFile(tempPath, std::ios::binary | std::ios::trunc);
+        if (!outFile)
+            return false;
+        
+        outFile.write(header.data(), static_cast<std::streamsize>(header.size()));
+        size_t written = header.size();
+        for (int level = static_cast<int>(levelCount) - 1; level >= 0; level--)
+        {
+            static const char padding[16] = {};
+            while (written < levelOffsets[level])
+            {
+                size_t count = std::min<size_t>(sizeof(padding), levelOffsets[level] - written);
+                outFile.write(padding, static_cast<std::streamsize>(count));
+                written += count;
+            }
+            outFile.write(reinterpret_cast<const char*>(image.levels[level].data),
+                          static_cast<std::streamsize>(image.levels[level].size));
+            written += image.levels[level].size;
+        }
+        
+        if (!outFile)
+        {
+            outFile.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    
+    std::remove(path.c_str());
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace TextureContainer
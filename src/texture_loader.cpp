@@ -0,0 +1,582 @@
+#include "../include/texture_loader.h"
+#include "../include/bc_encoder.h"
+#include "../include/gl_capabilities.h"
+#include "../include/hash_util.h"
+#include "../include/mapped_file.h"
+#include "../include/mip_generator.h"
+#include "../include/texture_container.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../include/stb_image.h"
+
+namespace {
+
+// 인코더나 캐시 레이아웃이 바뀌면 올려서 기존 텍스처 캐시를 무효화
+constexpr uint64_t TEXTURE_CACHE_VERSION = 2;
+
+// addMemoryImage로 등록한 이미지 (임포트 워커와 디코딩 워커가 함께 접근)
+struct MemoryImages {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const std::vector<unsigned char>>> images;
+};
+
+MemoryImages& memoryImages()
+{
+    static MemoryImages registry;
+    return registry;
+}
+
+// 원본 이미지 바이트: 등록된 메모리 이미지거나 매핑한 파일
+struct SourceImage {
+    MappedFile file;
+    std::shared_ptr<const std::vector<unsigned char>> memory;
+    
+    bool isOpen() const { return memory != nullptr || file.isOpen(); }
+    const unsigned char* data() const { return memory ? memory->data() : file.data(); }
+    size_t size() const { return memory ? memory->size() : file.size(); }
+};
+
+const char* usageName(TextureUsage usage)
+{
+    switch (usage)
+    {
+        case TextureUsage::Normal: return "normal";
+        case TextureUsage::Scalar: return "scalar";
+        case TextureUsage::Packed: return "orm";
+        default:                   return "color";
+    }
+}
+
+std::string replaceExtension(const std::string& path, const std::string& extension)
+{
+    size_t slash = path.find_last_of("/\\");
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return path + extension;
+    return path.substr(0, dot) + extension;
+}
+
+// 용도별 블록 압축 포맷 (해당 드라이버에서 쓸 수 없으면 0 = 비압축 유지)
+unsigned int compressedFormatFor(TextureUsage usage, const unsigned char* pixels, int width, int height, int channels)
+{
+    const GLCapabilities& caps = GLCapabilities::get();
+    switch (usage)
+    {
+        case TextureUsage::Normal:
+            return GL_COMPRESSED_RG_RGTC2;
+        case TextureUsage::Scalar:
+            return GL_COMPRESSED_RED_RGTC1;
+        case TextureUsage::Packed:
+            // 채널 간 상관이 낮아 BC1 오차가 색상보다 크지만, 채널별 BC4 세 장 대비 1/3 크기
+            return caps.textureCompressionS3TC ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : 0;
+        case TextureUsage::Color:
+        default:
+        {
+            if (!caps.textureCompressionS3TC)
+                return 0;
+            bool hasAlpha = false;
+            if (channels == 2 || channels == 4)
+            {
+                size_t count = static_cast<size_t>(width) * height;
+                for (size_t i = 0; i < count && !hasAlpha; i++)
+                    hasAlpha = pixels[i * channels + channels - 1] != 255;
+            }
+            return hasAlpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        }
+    }
+}
+
+// 밉 체인의 각 레벨을 블록 압축 (블록 행 단위로 나눠 병렬 인코딩)
+DecodedImage compressLevels(const DecodedImage& source, unsigned int internalFormat, ThreadPool& pool)
+{
+    DecodedImage image;
+    image.internalFormat = internalFormat;
+    image.compressed = true;
+    image.resolvedPath = source.resolvedPath;
+    
+    size_t total = 0;
+    for (const DecodedImage::Level& level : source.levels)
+        total += compressedLevelBytes(internalFormat, level.width, level.height);
+    auto storage = std::make_shared<std::vector<unsigned char>>(total);
+    
+    size_t blockBytes = compressedBlockBytes(internalFormat);
+    int channels = source.channels;
+    size_t offset = 0;
+    for (const DecodedImage::Level& mip : source.levels)
+    {
+        DecodedImage::Level level;
+        level.width = mip.width;
+        level.height = mip.height;
+        level.data = storage->data() + offset;
+        level.size = compressedLevelBytes(internalFormat, mip.width, mip.height);
+        
+        size_t blocksPerRow = static_cast<size_t>((mip.width + 3) / 4);
+        size_t blockRows = static_cast<size_t>((mip.height + 3) / 4);
+        unsigned char* dst = storage->data() + offset;
+        pool.parallelFor(blockRows, std::max<size_t>(1, 16384 / blocksPerRow), [&](size_t begin, size_t end) {
+            int y0 = static_cast<int>(begin) * 4;
+            int bandHeight = std::min(mip.height, static_cast<int>(end) * 4) - y0;
+            std::vector<unsigned char> blocks = BCEncoder::compress(
+                mip.data + static_cast<size_t>(y0) * mip.width * channels, mip.width, bandHeight, channels, internalFormat);
+            std::copy(blocks.begin(), blocks.end(), dst + begin * blocksPerRow * blockBytes);
+        });
+        
+        offset += level.size;
+        image.levels.push_back(level);
+    }
+    image.storage = storage;
+    return image;
+}
+
+// 캐시 키에 들어가는 임포트 설정 (설정이 바뀌면 캐시를 다시 만듦)
+uint64_t settingsSeed(TextureUsage usage, const TextureImportSettings& settings)
+{
+    unsigned char fields[] = {
+        static_cast<unsigned char>(TEXTURE_CACHE_VERSION),
+        static_cast<unsigned char>(usage),
+        settings.compressOnImport,
+        settings.generateMips,
+        static_cast<unsigned char>(settings.mips.filter),
+        settings.mips.wrap,
+        GLCapabilities::get().textureCompressionS3TC
+    };
+    return hashBytes(fields, sizeof(fields), 0);
+}
+
+// stb_image 버퍼를 소유하는 비압축 1레벨 이미지
+DecodedImage wrapDecodedPixels(unsigned char* data, int width, int height, int channels, const std::string& path)
+{
+    static const unsigned int internalFormats[] = {GL_R8, GL_RG8, GL_RGB8, GL_RGBA8};
+    static const unsigned int formats[] = {GL_RED, GL_RG, GL_RGB, GL_RGBA};
+    DecodedImage image;
+    DecodedImage::Level level;
+    level.width = width;
+    level.height = height;
+    level.data = data;
+    level.size = static_cast<size_t>(width) * height * channels;
+    image.levels.push_back(level);
+    image.storage = std::shared_ptr<const void>(data, [](const void* p) { stbi_image_free(const_cast<void*>(p)); });
+    image.internalFormat = internalFormats[channels - 1];
+    image.format = formats[channels - 1];
+    image.channels = channels;
+    image.resolvedPath = path;
+    return image;
+}
+
+// 디코딩한 원본으로 밉 체인 생성 후 블록 압축, 결과를 텍스처 캐시에 저장
+DecodedImage finishImport(DecodedImage image, TextureUsage usage, const TextureImportSettings& settings, ThreadPool& pool,
+                          const std::string& cachePath, const std::string& sourceKey)
+{
+    const DecodedImage::Level base = image.levels[0];
+    if (settings.generateMips)
+        image = MipGenerator::generate(image, usage, settings.mips, pool);
+    if (settings.compressOnImport)
+    {
+        unsigned int internalFormat = compressedFormatFor(usage, base.data, base.width, base.height, image.channels);
+        if (internalFormat != 0)
+            image = compressLevels(image, internalFormat, pool);
+    }
+    if (!TextureContainer::writeKTX2(cachePath, image, sourceKey))
+        std::cerr << "  Texture cache: cannot write " << cachePath << std::endl;
+    return image;
+}
+
+// 원본 바이트에서: 텍스처 캐시 확인 -> 디코딩 -> 밉/압축 후 캐시 저장 (path는 캐시 위치와 로그용)
+DecodedImage decodeSource(const unsigned char* bytes, size_t size, const std::string& path, TextureUsage usage,
+                          const TextureImportSettings& settings, ThreadPool& pool)
+{
+    DecodedImage image;
+    
+    // 2) 이전 실행에서 만들어 둔 텍스처 캐시 (원본 내용과 임포트 설정 해시가 같을 때만)
+    bool useCache = settings.compressOnImport || settings.generateMips;
+    std::string cachePath = path + "." + usageName(usage) + ".ktx2";
+    std::string sourceKey;
+    if (useCache)
+    {
+        sourceKey = std::to_string(hashBytes(bytes, size, settingsSeed(usage, settings)));
+        std::string cachedKey;
+        if (TextureContainer::readKTX2(cachePath, image, &cachedKey) && cachedKey == sourceKey)
+            return image;
+        image = DecodedImage();
+    }
+    
+    // 3) PNG 디코딩 (단일 채널 맵은 회색 RGB로 저장되어 있어도 R8로 줄이고, ORM 이미지는 RGB로 맞춤)
+    int width, height, channels;
+    int desiredChannels = usage == TextureUsage::Scalar ? 1 : (usage == TextureUsage::Packed ? 3 : 0);
+    unsigned char* data = stbi_load_from_memory(bytes, static_cast<int>(size),
+                                                &width, &height, &channels, desiredChannels);
+    if (!data)
+        return image;
+    if (desiredChannels != 0)
+        channels = desiredChannels;
+    image = wrapDecodedPixels(data, width, height, channels, path);
+    
+    if (!useCache)
+        return image;
+    return finishImport(std::move(image), usage, settings, pool, cachePath, sourceKey);
+}
+
+} // namespace
+
+TextureImportSettings& TextureLoader::settings()
+{
+    static TextureImportSettings importSettings;
+    return importSettings;
+}
+
+TextureLoader::TextureLoader(ThreadPool& pool) : pool(pool), uploader(pool)
+{
+}
+
+void TextureLoader::addMemoryImage(const std::string& name, std::vector<unsigned char> bytes)
+{
+    auto image = std::make_shared<const std::vector<unsigned char>>(std::move(bytes));
+    MemoryImages& registry = memoryImages();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.images[name] = std::move(image);
+}
+
+std::shared_ptr<const std::vector<unsigned char>> TextureLoader::findMemoryImage(const std::string& name)
+{
+    MemoryImages& registry = memoryImages();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.images.find(name);
+    return it != registry.images.end() ? it->second : nullptr;
+}
+
+size_t TextureLoader::requestPacked(const std::array<std::string, 3>& files, const std::array<int, 3>& channels,
+                                   const std::string& directory)
+{
+    Slot slot;
+    slot.file = files[0] + "|" + files[1] + "|" + files[2];
+    slot.directory = directory;
+    TextureImportSettings importSettings = settings();
+    ThreadPool& workers = pool;
+    slot.pending = pool.submit([files, channels, directory, importSettings, &workers]() {
+        return decodePacked(files, channels, directory, importSettings, workers);
+    });
+    
+    slots.push_back(std::move(slot));
+    return slots.size() - 1;
+}
+
+size_t TextureLoader::request(const std::string& file, const std::string& directory, TextureUsage usage)
+{
+    Slot slot;
+    slot.file = file;
+    slot.directory = directory;
+    TextureImportSettings importSettings = settings();
+    ThreadPool& workers = pool;
+    slot.pending = pool.submit([file, directory, usage, importSettings, &workers]() {
+        return decode(file, directory, usage, importSettings, workers);
+    });
+    
+    slots.push_back(std::move(slot));
+    return slots.size() - 1;
+}
+
+void TextureLoader::resolve()
+{
+    // 요청 순서대로 기다리므로 앞 텍스처를 올리는 동안 뒤 텍스처는 계속 디코딩됨
+    for (Slot& slot : slots)
+    {
+        if (slot.resolved)
+            continue;
+        
+        DecodedImage image = slot.pending.get();
+        slot.resolved = true;
+        if (!image.isValid())
+        {
+            std::cout << "  Texture failed to load at path: " << slot.file;
+            if (!slot.directory.empty() && slot.directory != ".")
+                std::cout << " (directory: " << slot.directory << ")";
+            std::cout << std::endl;
+            continue;
+        }
+        
+        slot.id = uploader.createTexture(image);
+        slot.packedChannels = image.packedChannels;
+        std::cout << "  ✓ Loaded texture from: " << image.resolvedPath << " (ID: " << slot.id;
+        if (image.compressed)
+            std::cout << ", block-compressed, " << image.levels.size() << " mips";
+        std::cout << ")" << std::endl;
+    }
+}
+
+unsigned int TextureLoader::textureId(size_t ticket) const
+{
+    return ticket < slots.size() ? slots[ticket].id : 0;
+}
+
+unsigned int TextureLoader::packedChannels(size_t ticket) const
+{
+    return ticket < slots.size() ? slots[ticket].packedChannels : 0;
+}
+
+void TextureLoader::clear()
+{
+    slots.clear();
+}
+
+// 워커 스레드에서 실행: GL 호출 금지
+DecodedImage TextureLoader::decode(const std::string& file, const std::string& directory, TextureUsage usage,
+                                   const TextureImportSettings& settings, ThreadPool& pool)
+{
+    // 메모리 이미지는 옆에 미리 압축된 파일이 있을 수 없으므로 바로 원본 단계로
+    if (std::shared_ptr<const std::vector<unsigned char>> memory = findMemoryImage(file))
+        return decodeSource(memory->data(), memory->size(), candidatePaths(file, directory).front(), usage, settings, pool);
+    
+    for (const auto& path : candidatePaths(file, directory))
+    {
+        DecodedImage image = decodeFile(path, usage, settings, pool);
+        if (image.isValid())
+            return image;
+    }
+    return DecodedImage();
+}
+
+DecodedImage TextureLoader::decodeFile(const std::string& path, TextureUsage usage, const TextureImportSettings& settings,
+                                       ThreadPool& pool)
+{
+    DecodedImage image;
+    
+    // 1) 미리 압축된 밉 체인 (같은 이름의 .ktx2 / .dds)
+    if (TextureContainer::readKTX2(replaceExtension(path, ".ktx2"), image) ||
+        TextureContainer::readDDS(replaceExtension(path, ".dds"), image))
+        return image;
+    
+    MappedFile source;
+    if (!source.open(path))
+        return image;
+    return decodeSource(source.data(), source.size(), path, usage, settings, pool);
+}
+
+// 워커 스레드에서 실행: 채널별 소스를 한 장의 RGB로 묶음 (없는 채널은 255)
+DecodedImage TextureLoader::decodePacked(const std::array<std::string, 3>& files, const std::array<int, 3>& channels,
+                                         const std::string& directory, const TextureImportSettings& settings,
+                                         ThreadPool& pool)
+{
+    std::array<SourceImage, 3> sources;
+    std::array<std::string, 3> resolved;
+    for (int c = 0; c < 3; c++)
+    {
+        if (files[c].empty())
+            continue;
+        sources[c].memory = findMemoryImage(files[c]);
+        if (sources[c].memory)
+        {
+            resolved[c] = candidatePaths(files[c], directory).front();
+            continue;
+        }
+        for (const std::string& path : candidatePaths(files[c], directory))
+        {
+            if (sources[c].file.open(path))
+            {
+                resolved[c] = path;
+                break;
+            }
+        }
+    }
+    
+    // 열린 소스만 묶고 나머지 채널은 기본값으로 채움 (하나도 없을 때만 실패)
+    int first = 0;
+    while (first < 3 && resolved[first].empty())
+        first++;
+    if (first == 3)
+        return DecodedImage();
+    
+    // 캐시 파일 이름: 첫 소스 + 요청한 조합(경로와 채널)의 해시 (첫 소스가 같은 다른 조합끼리 덮어쓰지 않도록)
+    uint64_t combination = 0;
+    for (int c = 0; c < 3; c++)
+    {
+        combination = hashBytes(reinterpret_cast<const unsigned char*>(files[c].data()), files[c].size(), combination);
+        combination = hashBytes(reinterpret_cast<const unsigned char*>(&channels[c]), sizeof(channels[c]), combination);
+    }
+    
+    // 캐시 키: 설정 + 채널 배치(읽는 소스 채널 포함) + 열린 소스의 내용. 저장할 때는 "키/실제로 묶은 채널"
+    bool useCache = settings.compressOnImport || settings.generateMips;
+    std::string cachePath = resolved[first] + "." + std::to_string(combination) + ".orm.ktx2";
+    std::string sourceKey;
+    DecodedImage image;
+    if (useCache)
+    {
+        uint64_t key = settingsSeed(TextureUsage::Packed, settings);
+        for (int c = 0; c < 3; c++)
+        {
+            key = hashBytes(reinterpret_cast<const unsigned char*>(&c), sizeof(c), key);
+            key = hashBytes(reinterpret_cast<const unsigned char*>(&channels[c]), sizeof(channels[c]), key);
+            if (sources[c].isOpen())
+                key = hashBytes(sources[c].data(), sources[c].size(), key);
+        }
+        sourceKey = std::to_string(key) + "/";
+        std::string cachedKey;
+        if (TextureContainer::readKTX2(cachePath, image, &cachedKey) &&
+            cachedKey.compare(0, sourceKey.size(), sourceKey) == 0)
+        {
+            image.packedChannels = static_cast<unsigned int>(std::strtoul(cachedKey.c_str() + sourceKey.size(), nullptr, 10));
+            if (image.packedChannels != 0)
+                return image;
+        }
+        image = DecodedImage();
+    }
+    
+    // 휘도 소스는 1채널로, 특정 채널을 읽는 소스는 RGBA로 디코딩해서 그 채널만 가져옴
+    // (glTF metallicRoughness는 G/B, occlusion은 R에 값이 있어 휘도로 바꾸면 섞임)
+    std::array<std::shared_ptr<unsigned char>, 3> pixels;
+    std::array<int, 3> widths = {}, heights = {};
+    std::array<int, 3> strides = {}, offsets = {};
+    int width = 0, height = 0;
+    for (int c = 0; c < 3; c++)
+    {
+        if (!sources[c].isOpen())
+            continue;
+        bool luminance = channels[c] < 0 || channels[c] > 3;
+        strides[c] = luminance ? 1 : 4;
+        offsets[c] = luminance ? 0 : channels[c];
+        // 같은 이미지를 같은 방식으로 읽는 앞 채널이 있으면 (metallicRoughness의 G/B) 한 번만 디코딩
+        int shared = 0;
+        while (shared < c && !(pixels[shared] && files[shared] == files[c] && strides[shared] == strides[c]))
+            shared++;
+        if (shared < c)
+        {
+            pixels[c] = pixels[shared];
+            widths[c] = widths[shared];
+            heights[c] = heights[shared];
+            continue;
+        }
+        int sourceChannels;
+        unsigned char* data = stbi_load_from_memory(sources[c].data(), static_cast<int>(sources[c].size()),
+                                                    &widths[c], &heights[c], &sourceChannels, strides[c]);
+        // 디코딩에 실패한 소스도 없는 채널로 처리
+        if (!data)
+            continue;
+        pixels[c] = std::shared_ptr<unsigned char>(data, [](unsigned char* p) { stbi_image_free(p); });
+        width = std::max(width, widths[c]);
+        height = std::max(height, heights[c]);
+    }
+    
+    unsigned int packedChannels = 0;
+    for (int c = 0; c < 3; c++)
+    {
+        if (pixels[c])
+            packedChannels |= 1u << c;
+    }
+    if (packedChannels == 0)
+        return image;
+    
+    // 해상도가 다른 소스는 가장 큰 해상도에 맞춰 최근접 샘플링
+    unsigned char* packed = static_cast<unsigned char*>(STBI_MALLOC(static_cast<size_t>(width) * height * 3));
+    if (!packed)
+        return image;
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            unsigned char* texel = packed + (static_cast<size_t>(y) * width + x) * 3;
+            for (int c = 0; c < 3; c++)
+            {
+                // 없는 채널은 1.0 (셰이더 기능이 꺼져 읽지 않지만, 읽어도 AO 1, 계수 그대로가 됨)
+                if (!pixels[c])
+                {
+                    texel[c] = 255;
+                    continue;
+                }
+                int sx = static_cast<int>(static_cast<long long>(x) * widths[c] / width);
+                int sy = static_cast<int>(static_cast<long long>(y) * heights[c] / height);
+                texel[c] = pixels[c].get()[(static_cast<size_t>(sy) * widths[c] + sx) * strides[c] + offsets[c]];
+            }
+        }
+    }
+    image = wrapDecodedPixels(packed, width, height, 3, resolved[first]);
+    image.packedChannels = packedChannels;
+    
+    if (!useCache)
+        return image;
+    image = finishImport(std::move(image), TextureUsage::Packed, settings, pool, cachePath,
+                         sourceKey + std::to_string(packedChannels));
+    image.packedChannels = packedChannels;
+    return image;
+}
+
+// 찾아볼 경로 목록: 원본 경로, 그다음 Pbr 디렉토리의 기본 텍스처
+std::vector<std::string> TextureLoader::candidatePaths(const std::string& file, const std::string& directory)
+{
+    // 먼저 원본 경로로 시도
+    std::string fullPath = file;
+    if (!directory.empty() && directory != ".")
+    {
+        fullPath = directory + '/' + file;
+    }
+    
+    std::vector<std::string> paths = {fullPath};
+    
+    // 원본 경로에서 찾지 못하면 Pbr 디렉토리에서 시도
+    // 파일명만 추출
+    size_t lastSlash = file.find_last_of("/\\");
+    std::string textureName = (lastSlash != std::string::npos) ? file.substr(lastSlash + 1) : file;
+    
+    // 파일 확장자 제거
+    size_t dotPos = textureName.find_last_of(".");
+    std::string baseName = (dotPos != std::string::npos) ? textureName.substr(0, dotPos) : textureName;
+    
+    // 기본 텍스처 경로 가져오기
+    std::vector<std::string> fallbackPaths = getDefaultTexturePaths(baseName, textureName);
+    paths.insert(paths.end(), fallbackPaths.begin(), fallbackPaths.end());
+    
+    return paths;
+}
+
+// 기본 텍스처 경로 생성
+std::vector<std::string> TextureLoader::getDefaultTexturePaths(const std::string& baseName, const std::string& textureName)
+{
+    std::vector<std::string> paths;
+    
+    // BaseColor, Diffuse 관련
+    if (baseName.find("diffuse") != std::string::npos || 
+        baseName.find("albedo") != std::string::npos ||
+        baseName.find("base") != std::string::npos ||
+        baseName.find("color") != std::string::npos)
+    {
+        paths = {"Pbr/mjolnir3_lp_GreyMetal_BaseColor.png", "../Pbr/mjolnir3_lp_GreyMetal_BaseColor.png"};
+    }
+    // Normal 관련
+    else if (baseName.find("normal") != std::string::npos)
+    {
+        paths = {"Pbr/mjolnir3_lp_GreyMetal_Normal.png", "../Pbr/mjolnir3_lp_GreyMetal_Normal.png"};
+    }
+    // Metallic 관련
+    else if (baseName.find("metallic") != std::string::npos)
+    {
+        paths = {"Pbr/mjolnir3_lp_GreyMetal_Metallic.png", "../Pbr/mjolnir3_lp_GreyMetal_Metallic.png"};
+    }
+    // Roughness 관련
+    else if (baseName.find("roughness") != std::string::npos || baseName.find("rough") != std::string::npos)
+    {
+        paths = {"Pbr/mjolnir3_lp_GreyMetal_Roughness.png", "../Pbr/mjolnir3_lp_GreyMetal_Roughness.png"};
+    }
+    // AO, Height 관련
+    else if (baseName.find("ao") != std::string::npos || 
+             baseName.find("height") != std::string::npos ||
+             baseName.find("occlusion") != std::string::npos)
+    {
+        paths = {"Pbr/mjolnir3_lp_GreyMetal_Height.png", "../Pbr/mjolnir3_lp_GreyMetal_Height.png"};
+    }
+    // 기본 경로들
+    else
+    {
+        paths = {
+            "Pbr/" + textureName,
+            "../Pbr/" + textureName,
+            "Pbr/mjolnir3_lp_GreyMetal_BaseColor.png",
+            "../Pbr/mjolnir3_lp_GreyMetal_BaseColor.png"
+        };
+    }
+    
+    return paths;
+}
@@ -0,0 +1,398 @@
+#include "../include/texture_uploader.h"
+#include "../include/gl_state.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// 행 단위 업로드 구간의 한 단위 (비압축: 1행, 압축: 4행 블록 한 줄)
+int rowsPerUnit(const DecodedImage& image)
+{
+    return image.compressed ? 4 : 1;
+}
+
+size_t unitBytes(const DecodedImage& image, const DecodedImage::Level& level)
+{
+    int units = (level.height + rowsPerUnit(image) - 1) / rowsPerUnit(image);
+    return level.size / units;
+}
+
+} // namespace
+
+TextureUploader::TextureUploader(ThreadPool& pool) : pool(pool)
+{
+}
+
+TextureUploader::~TextureUploader()
+{
+    // GL 자원은 releaseGL()에서 해제. 여기서는 매핑된 메모리에 쓰는 워커만 기다림
+    for (StagingBuffer& staging : buffers)
+    {
+        if (staging.copy.valid())
+            staging.copy.wait();
+    }
+}
+
+TextureUploadSettings& TextureUploader::settings()
+{
+    static TextureUploadSettings uploadSettings;
+    return uploadSettings;
+}
+
+// 렌더 스레드 전용
+unsigned int TextureUploader::createTexture(const DecodedImage& image)
+{
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    
+    // PBO가 바인딩되어 있으면 데이터 포인터가 버퍼 오프셋으로 해석되므로 해제
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    // 1/2/3채널 행은 4바이트 정렬이 아닐 수 있음
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    // 텍스처 유닛 바인딩은 GLState가 추적하므로 유닛 0에 묶어 기록을 맞춤
+    GLState::instance().bindTexture(0, textureID);
+    
+    // 작은 레벨부터 꼬리 예산 안에 드는 만큼은 바로 올림
+    int levelCount = static_cast<int>(image.levels.size());
+    int firstImmediate = levelCount;
+    size_t tailBytes = 0;
+    while (firstImmediate > 0 && tailBytes + image.levels[firstImmediate - 1].size <= settings().immediateTailBytes)
+    {
+        firstImmediate--;
+        tailBytes += image.levels[firstImmediate].size;
+    }
+    
+    size_t deferredBytes = 0;
+    for (int level = 0; level < levelCount; level++)
+    {
+        const DecodedImage::Level& mip = image.levels[level];
+        // 나중에 올릴 레벨은 저장 공간만 할당
+        const void* data = level >= firstImmediate ? mip.data : nullptr;
+        if (!data)
+            deferredBytes += mip.size;
+        if (image.compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, image.internalFormat, mip.width, mip.height, 0,
+                                   static_cast<GLsizei>(mip.size), data);
+        else
+            glTexImage2D(GL_TEXTURE_2D, level, image.internalFormat, mip.width, mip.height, 0,
+                         image.format, GL_UNSIGNED_BYTE, data);
+    }
+    
+    // 밉 체인이 함께 온 텍스처는 그대로 쓰고, 한 장짜리 비압축 텍스처만 드라이버 밉 생성
+    bool generateMips = levelCount == 1 && !image.compressed;
+    bool hasMips = generateMips || levelCount > 1;
+    if (!generateMips)
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    if (firstImmediate < levelCount)
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, firstImmediate);
+    if (generateMips && firstImmediate == 0)
+        glGenerateMipmap(GL_TEXTURE_2D);
+    
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, hasMips ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    
+    // 단일 채널 텍스처는 RGB 모두 R을 읽게 해서 셰이더가 어느 채널을 읽든 같은 값이 나오게 함
+    if (image.internalFormat == GL_R8 || image.internalFormat == GL_COMPRESSED_RED_RGTC1)
+    {
+        GLint swizzle[] = {GL_RED, GL_RED, GL_RED, GL_ONE};
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+    
+    if (firstImmediate > 0)
+    {
+        Job job;
+        job.texture = textureID;
+        job.image = image;
+        job.level = firstImmediate - 1;
+        job.generateMips = generateMips;
+        jobs.push_back(std::move(job));
+        queuedBytes += deferredBytes;
+    }
+    
+    return textureID;
+}
+
+// 렌더 스레드에서 프레임마다 한 번 호출
+void TextureUploader::update()
+{
+    if (idle())
+        return;
+    
+    if (buffers.empty())
+    {
+        buffers.resize(std::max(1u, settings().stagingBufferCount));
+        for (StagingBuffer& staging : buffers)
+            staging.buffer = GLBuffer::create();
+    }
+    
+    retireBuffers();
+    submitStaged();
+    stageJobs();
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+// GPU가 다 읽어 간 PBO를 다시 쓸 수 있게 함 (기다리지 않고 확인만)
+void TextureUploader::retireBuffers()
+{
+    for (StagingBuffer& staging : buffers)
+    {
+        if (staging.state != BufferState::InFlight)
+            continue;
+        GLenum status = glClientWaitSync(staging.fence, 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+        {
+            glDeleteSync(staging.fence);
+            staging.fence = nullptr;
+            staging.state = BufferState::Free;
+        }
+    }
+}
+
+// 워커 복사가 끝난 PBO를 매핑한 순서대로 텍스처에 전송
+// (늦게 끝난 복사가 한 프레임에 몰려도 전송량은 프레임 예산을 넘지 않음)
+void TextureUploader::submitStaged()
+{
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    size_t budget = settings().frameBudgetBytes;
+    bool submitted = false;
+    while (!stagingOrder.empty())
+    {
+        StagingBuffer& staging = buffers[stagingOrder.front()];
+        if (submitted && staging.stagedBytes > budget)
+            break;
+        if (staging.copy.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            break;
+        budget -= std::min(budget, staging.stagedBytes);
+        submitted = true;
+        staging.copy.get();
+        stagingOrder.pop_front();
+        
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.buffer.get());
+        // 매핑 중 버퍼 내용이 손상되면(화면 모드 전환 등) 원본 메모리에서 직접 올림
+        bool intact = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+        staging.mapped = nullptr;
+        if (!intact)
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        
+        for (const Region& region : staging.regions)
+        {
+            if (region.texture == 0)
+                continue;
+            const void* data = intact ? reinterpret_cast<const void*>(region.offset) : region.source;
+            uploadRegion(region, data);
+        }
+        staging.regions.clear();
+        staging.stagedBytes = 0;
+        
+        staging.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        staging.state = BufferState::InFlight;
+    }
+}
+
+// 이번 프레임 예산만큼 빈 PBO를 매핑하고, 픽셀 복사는 워커에게 맡김
+void TextureUploader::stageJobs()
+{
+    size_t budget = settings().frameBudgetBytes;
+    size_t capacity = settings().stagingBufferBytes;
+    bool progressed = false;
+    
+    for (size_t i = 0; i < buffers.size() && !jobs.empty(); i++)
+    {
+        StagingBuffer& staging = buffers[i];
+        if (staging.state != BufferState::Free)
+            continue;
+        if (budget == 0)
+            break;
+        
+        // 예산이 한 행보다 작아도 프레임마다 최소 한 구간은 진행
+        if (!fillBuffer(staging, capacity, budget, !progressed))
+            break;
+        progressed = true;
+        
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.buffer.get());
+        if (staging.capacity != capacity)
+        {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+            staging.capacity = capacity;
+        }
+        // Free 상태면 펜스로 GPU 읽기가 끝난 것이 확인되었으므로 이전 내용은 버려도 됨
+        staging.mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(capacity),
+                                          GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (!staging.mapped)
+        {
+            std::cout << "  Texture upload: cannot map staging buffer, uploading directly" << std::endl;
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            for (const Region& region : staging.regions)
+                uploadRegion(region, region.source);
+            staging.regions.clear();
+            continue;
+        }
+        
+        for (const Region& region : staging.regions)
+            staging.stagedBytes += region.bytes;
+        
+        struct Copy {
+            unsigned char* destination;
+            const unsigned char* source;
+            size_t bytes;
+        };
+        std::vector<Copy> copies;
+        copies.reserve(staging.regions.size());
+        for (const Region& region : staging.regions)
+            copies.push_back({static_cast<unsigned char*>(staging.mapped) + region.offset, region.source, region.bytes});
+        staging.copy = pool.submit([copies = std::move(copies)]() {
+            for (const Copy& copy : copies)
+                std::memcpy(copy.destination, copy.source, copy.bytes);
+        });
+        staging.state = BufferState::Staging;
+        stagingOrder.push_back(i);
+    }
+}
+
+// 큐 앞쪽 작업에서 행 구간을 잘라 PBO 하나에 배치. 배치한 구간이 있으면 true
+bool TextureUploader::fillBuffer(StagingBuffer& staging, size_t capacity, size_t& budget, bool mustProgress)
+{
+    size_t used = 0;
+    while (!jobs.empty())
+    {
+        Job& job = jobs.front();
+        const DecodedImage::Level& mip = job.image.levels[job.level];
+        int unitRows = rowsPerUnit(job.image);
+        size_t bytesPerUnit = unitBytes(job.image, mip);
+        
+        size_t offset = alignUp(used, 16);
+        size_t space = offset < capacity ? capacity - offset : 0;
+        size_t allowance = (mustProgress && staging.regions.empty()) ? space : std::min(space, budget);
+        int remainingUnits = (mip.height - job.nextRow + unitRows - 1) / unitRows;
+        int units = static_cast<int>(std::min<size_t>(remainingUnits, allowance / bytesPerUnit));
+        if (units == 0)
+        {
+            // 한 행이 PBO보다 큰 경우: PBO 없이 이 레벨을 바로 올림
+            if (!staging.regions.empty() || bytesPerUnit <= capacity)
+                break;
+            units = remainingUnits;
+        }
+        
+        Region region;
+        region.texture = job.texture;
+        region.level = job.level;
+        region.y = job.nextRow;
+        region.width = mip.width;
+        region.height = std::min(mip.height - job.nextRow, units * unitRows);
+        region.offset = offset;
+        region.bytes = bytesPerUnit * units;
+        region.source = mip.data + bytesPerUnit * (job.nextRow / unitRows);
+        region.storage = job.image.storage;
+        region.internalFormat = job.image.internalFormat;
+        region.format = job.image.format;
+        region.compressed = job.image.compressed;
+        
+        job.nextRow += region.height;
+        budget -= std::min(budget, region.bytes);
+        queuedBytes -= std::min(queuedBytes, region.bytes);
+        if (job.nextRow >= mip.height)
+        {
+            region.finishesLevel = true;
+            region.generateMips = job.generateMips && job.level == 0;
+            job.level--;
+            job.nextRow = 0;
+            if (job.level < 0)
+                jobs.pop_front();
+        }
+        
+        if (region.bytes > capacity)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            uploadRegion(region, region.source);
+            return false;
+        }
+        
+        used = offset + region.bytes;
+        staging.regions.push_back(std::move(region));
+    }
+    return !staging.regions.empty();
+}
+
+void TextureUploader::uploadRegion(const Region& region, const void* data)
+{
+    GLState::instance().bindTexture(0, region.texture);
+    if (region.compressed)
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, region.level, 0, region.y, region.width, region.height,
+                                  region.internalFormat, static_cast<GLsizei>(region.bytes), data);
+    else
+        glTexSubImage2D(GL_TEXTURE_2D, region.level, 0, region.y, region.width, region.height,
+                        region.format, GL_UNSIGNED_BYTE, data);
+    // 작은 레벨부터 채워 오므로 방금 끝난 레벨이 새 기준 레벨
+    if (region.finishesLevel)
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, region.level);
+    if (region.generateMips)
+        glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+void TextureUploader::cancel(unsigned int texture)
+{
+    for (auto it = jobs.begin(); it != jobs.end();)
+    {
+        if (it->texture != texture)
+        {
+            ++it;
+            continue;
+        }
+        size_t remaining = 0;
+        for (int level = 0; level <= it->level; level++)
+            remaining += it->image.levels[level].size;
+        remaining -= unitBytes(it->image, it->image.levels[it->level]) * (it->nextRow / rowsPerUnit(it->image));
+        queuedBytes -= std::min(queuedBytes, remaining);
+        it = jobs.erase(it);
+    }
+    for (StagingBuffer& staging : buffers)
+    {
+        for (Region& region : staging.regions)
+        {
+            if (region.texture == texture)
+                region.texture = 0;
+        }
+    }
+}
+
+void TextureUploader::releaseGL()
+{
+    for (StagingBuffer& staging : buffers)
+    {
+        if (staging.copy.valid())
+            staging.copy.wait();
+        if (staging.mapped)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.buffer.get());
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
+        if (staging.fence)
+            glDeleteSync(staging.fence);
+        staging.buffer.reset();
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    buffers.clear();
+    stagingOrder.clear();
+    jobs.clear();
+    queuedBytes = 0;
+}
+
+bool TextureUploader::idle() const
+{
+    if (!jobs.empty())
+        return false;
+    for (const StagingBuffer& staging : buffers)
+    {
+        if (staging.state != BufferState::Free)
+            return false;
+    }
+    return true;
+}
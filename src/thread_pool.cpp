@@ -0,0 +1,108 @@
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+    threadCount = std::max(1u, threadCount);
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body)
+{
+    grain = std::max<size_t>(1, grain);
+    size_t chunkCount = (count + grain - 1) / grain;
+    if (chunkCount <= 1)
+    {
+        if (count > 0)
+            body(0, count);
+        return;
+    }
+    
+    // 늦게 시작한 도우미 작업이 호출이 끝난 뒤에 실행될 수 있으므로 상태는 공유 포인터로 유지
+    struct State {
+        std::atomic<size_t> nextChunk{0};
+        size_t chunkCount = 0;
+        size_t count = 0;
+        size_t grain = 0;
+        const std::function<void(size_t, size_t)>* body = nullptr;
+        std::mutex mutex;
+        std::condition_variable idle;
+        size_t active = 0;
+    };
+    auto state = std::make_shared<State>();
+    state->chunkCount = chunkCount;
+    state->count = count;
+    state->grain = grain;
+    state->body = &body;
+    
+    // 남은 구간을 가져가 처리. 구간을 못 가져가면 body에 손대지 않고 돌아감
+    auto drain = [](State& s) {
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.active++;
+        }
+        for (;;)
+        {
+            size_t chunk = s.nextChunk.fetch_add(1);
+            if (chunk >= s.chunkCount)
+                break;
+            size_t begin = chunk * s.grain;
+            (*s.body)(begin, std::min(s.count, begin + s.grain));
+        }
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (--s.active == 0)
+            s.idle.notify_all();
+    };
+    
+    size_t helpers = std::min<size_t>(size(), chunkCount - 1);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (size_t i = 0; i < helpers; i++)
+            tasks.emplace([state, drain]() { drain(*state); });
+    }
+    wakeCondition.notify_all();
+    
+    drain(*state);
+    
+    // 구간을 처리 중인 도우미만 기다림 (아직 시작하지 않은 도우미는 할 일 없이 끝남)
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->idle.wait(lock, [&]() { return state->active == 0; });
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            wakeCondition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            // 종료 시에도 남은 작업은 모두 처리해 대기 중인 future가 끊기지 않게 함
+            if (tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,60 @@
+#include "../include/uniform_blocks.h"
+#include <algorithm>
+
+int UniformBlocks::bindingFor(const std::string& blockName)
+{
+    if (blockName == "FrameData")
+        return static_cast<int>(FRAME_BINDING);
+    if (blockName == "DrawData")
+        return static_cast<int>(DRAW_BINDING);
+    return -1;
+}
+
+UniformBlockBuffers::UniformBlockBuffers(size_t drawCapacity) : drawCapacity(std::max<size_t>(drawCapacity, 1))
+{
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    size_t align = static_cast<size_t>(std::max(alignment, 1));
+    drawStride = (sizeof(UniformBlocks::DrawData) + align - 1) / align * align;
+    
+    frameBuffer = GLBuffer::create();
+    glBindBuffer(GL_UNIFORM_BUFFER, frameBuffer.get());
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(UniformBlocks::FrameData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, UniformBlocks::FRAME_BINDING, frameBuffer.get());
+    
+    drawBuffer = GLBuffer::create();
+    glBindBuffer(GL_UNIFORM_BUFFER, drawBuffer.get());
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(drawStride * this->drawCapacity), nullptr, GL_STREAM_DRAW);
+    glBindBufferRange(GL_UNIFORM_BUFFER, UniformBlocks::DRAW_BINDING, drawBuffer.get(), 0, sizeof(UniformBlocks::DrawData));
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBlockBuffers::updateFrame(const UniformBlocks::FrameData& data)
+{
+    glBindBuffer(GL_UNIFORM_BUFFER, frameBuffer.get());
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(data), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBlockBuffers::pushDraw(const glm::mat4& model)
+{
+    UniformBlocks::DrawData data;
+    data.model = model;
+    // 정점마다 transpose(inverse(mat3(model)))를 계산하지 않도록 CPU에서 한 번 계산
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+    for (int c = 0; c < 3; c++)
+        data.normalMatrix[c] = glm::vec4(normalMatrix[c], 0.0f);
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, drawBuffer.get());
+    if (drawCursor == drawCapacity)
+    {
+        // 링을 다 썼으면 드라이버에 새 저장 공간을 받아 이전 드로가 읽는 내용과 겹치지 않게 함
+        glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(drawStride * drawCapacity), nullptr, GL_STREAM_DRAW);
+        drawCursor = 0;
+    }
+    GLintptr offset = static_cast<GLintptr>(drawCursor * drawStride);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, sizeof(data), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferRange(GL_UNIFORM_BUFFER, UniformBlocks::DRAW_BINDING, drawBuffer.get(), offset, sizeof(data));
+    drawCursor++;
+}
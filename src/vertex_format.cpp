@@ -0,0 +1,191 @@
+#include "../include/vertex_format.h"
+#include "../include/instancing.h"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr size_t MAX_SHORT_INDEX_VERTICES = 65536;
+
+float signNotZero(float value)
+{
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+void packDirection(glm::vec3 direction, int16_t out[2])
+{
+    glm::vec2 encoded = VertexFormat::encodeOctahedral(direction);
+    out[0] = static_cast<int16_t>(glm::packSnorm1x16(encoded.x));
+    out[1] = static_cast<int16_t>(glm::packSnorm1x16(encoded.y));
+}
+
+// 탄젠트 공간이 왼손/오른손 중 어느 쪽인지 (셰이더는 B = cross(N, T) * 부호로 복원)
+float bitangentSign(const Vertex& vertex)
+{
+    return glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f ? -1.0f : 1.0f;
+}
+
+template <typename Packed>
+void packAttributes(const Vertex& vertex, Packed& packed)
+{
+    packDirection(vertex.Normal, packed.normal);
+    packDirection(vertex.Tangent, packed.tangent);
+    packed.texCoords[0] = glm::packHalf1x16(vertex.TexCoords.x);
+    packed.texCoords[1] = glm::packHalf1x16(vertex.TexCoords.y);
+}
+
+template <typename Packed>
+void setupPackedAttributes(GLenum positionType, GLboolean positionNormalized)
+{
+    // position (xyz) + bitangent sign (w)
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, positionType, positionNormalized, sizeof(Packed), (void*)offsetof(Packed, position));
+    // octahedral normal
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(Packed), (void*)offsetof(Packed, normal));
+    // half-float texture coords
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(Packed), (void*)offsetof(Packed, texCoords));
+    // octahedral tangent
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 2, GL_SHORT, GL_TRUE, sizeof(Packed), (void*)offsetof(Packed, tangent));
+}
+
+} // namespace
+
+namespace VertexFormat {
+
+VertexFormatSettings& settings()
+{
+    static VertexFormatSettings instance;
+    return instance;
+}
+
+glm::vec2 encodeOctahedral(glm::vec3 direction)
+{
+    float sum = std::fabs(direction.x) + std::fabs(direction.y) + std::fabs(direction.z);
+    // 탄젠트 공간이 없는 메시의 0 벡터
+    if (sum < 1e-20f)
+        return glm::vec2(0.0f);
+    
+    glm::vec2 encoded(direction.x / sum, direction.y / sum);
+    if (direction.z < 0.0f)
+    {
+        // 아래 반구는 대각선 기준으로 접어서 정사각형 모서리에 배치
+        encoded = glm::vec2((1.0f - std::fabs(encoded.y)) * signNotZero(encoded.x),
+                            (1.0f - std::fabs(encoded.x)) * signNotZero(encoded.y));
+    }
+    return encoded;
+}
+
+glm::vec3 decodeOctahedral(glm::vec2 encoded)
+{
+    glm::vec3 direction(encoded.x, encoded.y, 1.0f - std::fabs(encoded.x) - std::fabs(encoded.y));
+    float fold = std::max(-direction.z, 0.0f);
+    direction.x += direction.x >= 0.0f ? -fold : fold;
+    direction.y += direction.y >= 0.0f ? -fold : fold;
+    return glm::normalize(direction);
+}
+
+PackedMesh pack(const Vertex* vertexData, size_t vertexCount, const unsigned int* indexData, size_t indexCount,
+                const VertexFormatSettings& settings)
+{
+    PackedMesh mesh;
+    
+    glm::vec3 minimum(0.0f), maximum(0.0f);
+    if (vertexCount > 0)
+    {
+        minimum = maximum = vertexData[0].Position;
+        for (size_t i = 1; i < vertexCount; i++)
+        {
+            minimum = glm::min(minimum, vertexData[i].Position);
+            maximum = glm::max(maximum, vertexData[i].Position);
+        }
+    }
+    
+    // AABB 중심을 원점으로 두고 반지름으로 나눠 [-1, 1]에 맞춤 (snorm16 한 단계 = 반지름 / 32767)
+    glm::vec3 offset = (minimum + maximum) * 0.5f;
+    glm::vec3 scale = (maximum - minimum) * 0.5f;
+    mesh.boundsCenter = offset;
+    mesh.boundsRadius = glm::length(scale);
+    mesh.boundsExtent = scale;
+    for (int axis = 0; axis < 3; axis++)
+        scale[axis] = std::max(scale[axis], 1e-20f);
+    float maxError = std::max(scale.x, std::max(scale.y, scale.z)) / 32767.0f * 0.5f;
+    
+    mesh.quantizedPositions = settings.quantizePositions &&
+                              (settings.maxPositionError <= 0.0f || maxError <= settings.maxPositionError);
+    
+    if (mesh.quantizedPositions)
+    {
+        mesh.positionScale = scale;
+        mesh.positionOffset = offset;
+        mesh.vertexData.resize(vertexCount * sizeof(PackedVertex));
+        PackedVertex* out = reinterpret_cast<PackedVertex*>(mesh.vertexData.data());
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            glm::vec3 normalized = (vertexData[i].Position - offset) / scale;
+            for (int axis = 0; axis < 3; axis++)
+                out[i].position[axis] = static_cast<int16_t>(glm::packSnorm1x16(normalized[axis]));
+            out[i].position[3] = static_cast<int16_t>(glm::packSnorm1x16(bitangentSign(vertexData[i])));
+            packAttributes(vertexData[i], out[i]);
+        }
+    }
+    else
+    {
+        mesh.vertexData.resize(vertexCount * sizeof(PackedVertexFloat));
+        PackedVertexFloat* out = reinterpret_cast<PackedVertexFloat*>(mesh.vertexData.data());
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            out[i].position[0] = vertexData[i].Position.x;
+            out[i].position[1] = vertexData[i].Position.y;
+            out[i].position[2] = vertexData[i].Position.z;
+            out[i].position[3] = bitangentSign(vertexData[i]);
+            packAttributes(vertexData[i], out[i]);
+        }
+    }
+    
+    if (vertexCount <= MAX_SHORT_INDEX_VERTICES)
+    {
+        mesh.indexType = GL_UNSIGNED_SHORT;
+        mesh.indexData.resize(indexCount * sizeof(uint16_t));
+        uint16_t* out = reinterpret_cast<uint16_t*>(mesh.indexData.data());
+        for (size_t i = 0; i < indexCount; i++)
+            out[i] = static_cast<uint16_t>(indexData[i]);
+    }
+    else
+    {
+        mesh.indexType = GL_UNSIGNED_INT;
+        mesh.indexData.resize(indexCount * sizeof(unsigned int));
+        if (indexCount > 0)
+            std::memcpy(mesh.indexData.data(), indexData, indexCount * sizeof(unsigned int));
+    }
+    return mesh;
+}
+
+void setupAttributes(bool quantizedPositions)
+{
+    if (quantizedPositions)
+        setupPackedAttributes<PackedVertex>(GL_SHORT, GL_TRUE);
+    else
+        setupPackedAttributes<PackedVertexFloat>(GL_FLOAT, GL_FALSE);
+}
+
+void setupInstanceAttributes(size_t byteOffset)
+{
+    // mat4 model (4열) + mat3 normalMatrix (vec4 3열) + vec4 material
+    static_assert(offsetof(InstanceData, material) == 7 * sizeof(glm::vec4), "InstanceData columns must be packed");
+    const GLsizei stride = sizeof(InstanceData);
+    for (GLuint i = 0; i < Instancing::LOCATION_COUNT; i++)
+    {
+        GLuint location = Instancing::FIRST_LOCATION + i;
+        GLint size = (i >= 4 && i < 7) ? 3 : 4;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, stride, (void*)(byteOffset + i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+    }
+}
+
+} // namespace VertexFormat